@@ -1,8 +1,9 @@
 #include "aoc.h"
 #include "aoc/core.h"
+#include "aoc/scan.h"
 
 #include <iostream>
-#include <regex>
+#include <stdexcept>
 #include <string>
 
 namespace
@@ -16,10 +17,12 @@ namespace
 
 	Dimensions parse(const std::string& str)
 	{
-		const std::regex regex(R"((\d+)x(\d+)x(\d+))");
-		std::smatch match;
-		std::regex_match(str, match, regex);
-		return { std::stoll(match[1]), std::stoll(match[2]), std::stoll(match[3]) };
+		Dimensions dimensions{};
+		if (!aoc::scan<"{}x{}x{}">(str, dimensions.length, dimensions.width, dimensions.height))
+		{
+			throw std::runtime_error("Invalid dimensions");
+		}
+		return dimensions;
 	}
 
 	std::vector<Dimensions> read_input(std::istream& input)
@@ -74,10 +77,4 @@ namespace
 	}
 }
 
-SOLVE
-{
-	const std::vector<Dimensions> input = read_input(std::cin);
-
-	std::cout << part_one(input) << '\n';
-	std::cout << part_two(input) << '\n';
-}
\ No newline at end of file
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
\ No newline at end of file
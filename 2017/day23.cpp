@@ -1,11 +1,12 @@
 #include "aoc.h"
 #include "aoc/core.h"
+#include "aoc/scan.h"
 
 #include <array>
 #include <iostream>
-#include <regex>
 #include <span>
 #include <string>
+#include <string_view>
 
 #include <cassert>
 
@@ -35,18 +36,17 @@ namespace
 
 	Instruction parse_instruction(const std::string& line)
 	{
-		static const std::regex re{ R"((\w+) (.*) (.*))" };
-		std::smatch match;
-		std::regex_match(line, match, re);
-
 		Instruction instruction;
-		instruction.arg1 = match[2];
-		instruction.arg2 = match[3];
+		std::string_view opcode;
+		if (!aoc::scan<"{} {} {}">(line, opcode, instruction.arg1, instruction.arg2))
+		{
+			throw std::runtime_error("Invalid instruction");
+		}
 
-		if (match[1] == "set") instruction.opcode = Opcode::set;
-		else if (match[1] == "sub") instruction.opcode = Opcode::sub;
-		else if (match[1] == "mul") instruction.opcode = Opcode::mul;
-		else if (match[1] == "jnz") instruction.opcode = Opcode::jnz;
+		if (opcode == "set") instruction.opcode = Opcode::set;
+		else if (opcode == "sub") instruction.opcode = Opcode::sub;
+		else if (opcode == "mul") instruction.opcode = Opcode::mul;
+		else if (opcode == "jnz") instruction.opcode = Opcode::jnz;
 		else throw std::runtime_error("Invalid opcode");
 
 		return instruction;
@@ -176,6 +176,6 @@ SOLVE
 {
 	const std::vector<Instruction> instructions = read_input(std::cin);
 
-	std::cout << part_one(instructions) << '\n';
-	std::cout << part_two() << '\n';
+	aoc::answer(1, part_one(instructions));
+	aoc::answer(2, part_two());
 }
\ No newline at end of file
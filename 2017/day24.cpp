@@ -1,9 +1,10 @@
 #include "aoc.h"
 #include "aoc/core.h"
+#include "aoc/scan.h"
 
 #include <iostream>
-#include <regex>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -13,10 +14,12 @@ namespace
 
 	Pair read_pair(const std::string& line)
 	{
-		static const std::regex regex(R"((\d+)/(\d+))");
-		std::smatch match;
-		std::regex_match(line, match, regex);
-		return { std::stoll(match[1]), std::stoll(match[2]) };
+		Pair pair;
+		if (!aoc::scan<"{}/{}">(line, pair.first, pair.second))
+		{
+			throw std::runtime_error("Invalid component");
+		}
+		return pair;
 	}
 
 	std::vector<Pair> read_input(std::istream& in)
@@ -83,10 +86,4 @@ namespace
 	}
 }
 
-SOLVE
-{
-	const std::vector<Pair> pairs = read_input(std::cin);
-
-	std::cout << part_one(pairs) << '\n';
-	std::cout << part_two(pairs) << '\n';
-}
\ No newline at end of file
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
\ No newline at end of file
@@ -86,5 +86,5 @@ SOLVE
 {
 	const Blueprint blueprint = read_blueprint(std::cin);
 
-	std::cout << part_one(blueprint) << '\n';
+	aoc::answer(1, part_one(blueprint));
 }
\ No newline at end of file
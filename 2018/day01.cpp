@@ -56,6 +56,6 @@ SOLVE
 	using I = std::istream_iterator<int>;
 	const std::vector<int> changes(I{std::cin}, I{});
 	
-	std::cout << part_one(changes) << std::endl;
-	std::cout << part_two(changes) << std::endl;
+	aoc::answer(1, part_one(changes));
+	aoc::answer(2, part_two(changes));
 }
@@ -96,6 +96,6 @@ SOLVE
 {
 	const std::vector<std::string> box_ids = read_input(std::cin);
 
-	std::cout << part_one(box_ids) << std::endl;
-	std::cout << part_two(box_ids) << std::endl;
+	aoc::answer(1, part_one(box_ids));
+	aoc::answer(2, part_two(box_ids));
 }
@@ -1,9 +1,9 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 
 #include <algorithm>
 #include <iostream>
 #include <iterator>
-#include <regex>
 #include <string>
 #include <vector>
 
@@ -20,15 +20,9 @@ namespace
 
 	Claim parse_claim(const std::string& line)
 	{
-		static const std::regex re("#(\\d+) @ (\\d+),(\\d+): (\\d+)x(\\d+)");
-		if (std::smatch match; std::regex_match(line, match, re))
+		if (Claim claim; aoc::scan<"#{} @ {},{}: {}x{}">(line, claim.id, claim.x, claim.y, claim.w, claim.h))
 		{
-			const int id = std::stoi(match[1].str());
-			const int x = std::stoi(match[2].str());
-			const int y = std::stoi(match[3].str());
-			const int w = std::stoi(match[4].str());
-			const int h = std::stoi(match[5].str());
-			return { id, x, y, w, h };
+			return claim;
 		}
 		return {};
 	}
@@ -115,6 +109,6 @@ SOLVE
 	const std::pair<int, int> dimensions = get_max_dimensions(claims);
 	const std::vector<int> fabric = make_fabric(claims, dimensions.first, dimensions.second);
 
-	std::cout << part_one(fabric) << std::endl;
-	std::cout << part_two(fabric, dimensions, claims) << std::endl;
+	aoc::answer(1, part_one(fabric));
+	aoc::answer(2, part_two(fabric, dimensions, claims));
 }
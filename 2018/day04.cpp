@@ -1,10 +1,11 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 
 #include <array>
 #include <iostream>
 #include <numeric>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <cassert>
@@ -39,34 +40,18 @@ namespace
 		Kind kind;
 	};
 
-	Timestamp parse_timestamp(const std::smatch& match)
-	{
-		Timestamp timestamp;
-		timestamp.year = std::stoi(match[1].str());
-		timestamp.month = std::stoi(match[2].str());
-		timestamp.day = std::stoi(match[3].str());
-		timestamp.hour = std::stoi(match[4].str());
-		timestamp.minute = std::stoi(match[5].str());
-		return timestamp;
-	}
-
 	Action parse_action(const std::string& str)
 	{
-		const std::regex re("\\[(\\d\\d\\d\\d)-(\\d\\d)-(\\d\\d) (\\d\\d):(\\d\\d)\\] (.*)");
-		std::smatch match;
 		Action action{};
-		if (std::regex_match(str, match, re))
+		Timestamp& timestamp = action.timestamp;
+		std::string_view command_str;
+		if (aoc::scan<"[{}-{}-{} {}:{}] {}">(str, timestamp.year, timestamp.month, timestamp.day, timestamp.hour,
+			timestamp.minute, command_str) && !command_str.empty())
 		{
-			action.timestamp = parse_timestamp(match);
-			std::string command_str = match[6].str();
 			if (command_str[0] == 'G')
 			{
 				action.kind = Kind::begins_shift;
-				const std::regex guard_re("Guard #(\\d+) begins shift");
-				if (std::regex_match(command_str, match, guard_re))
-				{
-					action.guard = std::stoi(match[1].str());
-				}
+				aoc::scan<"Guard #{} begins shift">(command_str, action.guard);
 			}
 			else if (command_str[0] == 'f')
 			{
@@ -190,6 +175,6 @@ SOLVE
 	const std::unordered_map<int, Sleep_map> guard_sleep_maps = get_sleep_map(actions);
 	const std::vector<Sleep_result> sleep_results = get_sleep_results(guard_sleep_maps);
 
-	std::cout << part_one(sleep_results) << std::endl;
-	std::cout << part_two(sleep_results) << std::endl;
+	aoc::answer(1, part_one(sleep_results));
+	aoc::answer(2, part_two(sleep_results));
 }
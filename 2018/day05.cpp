@@ -69,6 +69,6 @@ SOLVE
 {
 	const std::string input = read_input(std::cin);
 
-	std::cout << part_one(input) << std::endl;
-	std::cout << part_two(input) << std::endl;
+	aoc::answer(1, part_one(input));
+	aoc::answer(2, part_two(input));
 }
@@ -1,11 +1,12 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
 #include <iostream>
 #include <limits>
-#include <regex>
+#include <string>
 #include <vector>
 
 #include <cmath>
@@ -110,12 +111,11 @@ namespace
 	std::vector<Point> read_input(std::istream& is)
 	{
 		std::vector<Point> points;
-		const std::regex re("(\\d+), (\\d+)");
 		for (std::string line; std::getline(is, line);)
 		{
-			if (std::smatch match; std::regex_match(line, match, re))
+			if (int x = 0, y = 0; aoc::scan<"{}, {}">(line, x, y))
 			{
-				points.emplace_back(std::stoi(match[1].str()), std::stoi(match[2].str()));
+				points.emplace_back(x, y);
 			}
 		}
 		return points;
@@ -167,7 +167,7 @@ TEST_CASE("get bounds", "")
 SOLVE
 {
 	const std::vector<Point> points = read_input(std::cin);
-	std::cout << part_one(points) << std::endl;
+	aoc::answer(1, part_one(points));
 	/** @todo allow passing this an option to the command line and default if none specified */
-	std::cout << part_two(points, points.size() > 32 ? 10000 : 32) << std::endl;
+	aoc::answer(2, part_two(points, points.size() > 32 ? 10000 : 32));
 }
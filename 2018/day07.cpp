@@ -188,6 +188,6 @@ SOLVE
 	/** @todo: Allow passing the number of nodes as a parameter, the examples use fewer nodes */
 	std::array<Node, 26> nodes = read_input(std::cin);
 
-	std::cout << part_one(nodes) << std::endl;
-	std::cout << part_two(nodes) << std::endl;
+	aoc::answer(1, part_one(nodes));
+	aoc::answer(2, part_two(nodes));
 }
@@ -85,6 +85,6 @@ SOLVE
 	const std::vector<S64> input = read_input(std::cin);
 	const Node root = make_tree(input);
 
-	std::cout << part_one(root) << '\n';
-	std::cout << part_two(root) << '\n';
+	aoc::answer(1, part_one(root));
+	aoc::answer(2, part_two(root));
 }
\ No newline at end of file
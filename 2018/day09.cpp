@@ -1,9 +1,10 @@
 #include "aoc.h"
 #include "aoc/core.h"
+#include "aoc/scan.h"
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
-#include <regex>
 #include <vector>
 
 namespace
@@ -16,14 +17,13 @@ namespace
 
 	Game read_input(std::istream& in)
 	{
-		const std::regex re(R"((\d+) players; last marble is worth (\d+) points)");
-		Game game;
+		Game game{};
 		std::string line;
 		std::getline(in, line);
-		std::smatch match;
-		std::regex_match(line, match, re);
-		game.players = std::stoll(match[1]);
-		game.last_marble = std::stoll(match[2]);
+		if (!aoc::scan<"{} players; last marble is worth {} points">(line, game.players, game.last_marble))
+		{
+			throw std::runtime_error("Invalid game");
+		}
 		return game;
 	}
 
@@ -112,10 +112,4 @@ namespace
 	}
 }
 
-SOLVE
-{
-	const Game game = read_input(std::cin);
-
-	std::cout << part_one(game) << '\n';
-	std::cout << part_two(game) << '\n';
-}
\ No newline at end of file
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 #include "aoc/vector.h"
 
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
-#include <regex>
 
 using aoc::Vector2;
 
@@ -18,10 +19,14 @@ namespace
 
 	Light parse_light(const std::string& line)
 	{
-		static const std::regex re(R"(position=<\s*(-?\d+),\s*(-?\d+)> velocity=<\s*(-?\d+),\s*(-?\d+)>)");
-		std::smatch match;
-		std::regex_match(line, match, re);
-		return Light{ { std::stoll(match[1]), std::stoll(match[2]) }, { std::stoll(match[3]), std::stoll(match[4]) } };
+		// Numbers skip the spaces that line them up
+		Light light;
+		if (!aoc::scan<"position=<{},{}> velocity=<{},{}>">(line, light.position.x, light.position.y, light.velocity.x,
+			light.velocity.y))
+		{
+			throw std::runtime_error("Invalid light");
+		}
+		return light;
 	}
 
 	std::vector<Light> read_input(std::istream& in)
@@ -3,7 +3,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <format>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using aoc::Vector2;
 
@@ -22,26 +25,29 @@ namespace
 
 	using Cube = std::vector<std::vector<std::vector<S64>>>;
 
-	Cube get_power_levels(const S64 grid_serial_number)
+	// The puzzle's grid is 300 by 300, a different size can be passed after the driver's options
+	constexpr S64 default_grid_size = 300;
+
+	Cube get_power_levels(const S64 grid_serial_number, const S64 grid_size)
 	{
 		Cube power_levels;
-		for (S64 y = 0; y < 300; ++y)
+		for (S64 y = 0; y < grid_size; ++y)
 		{
-			std::vector<std::vector<S64>>& row = power_levels.emplace_back(300);
-			for (S64 x = 0; x < 300; ++x)
+			std::vector<std::vector<S64>>& row = power_levels.emplace_back(grid_size);
+			for (S64 x = 0; x < grid_size; ++x)
 			{
 				row[x].push_back(get_power_level(x + 1, y + 1, grid_serial_number));
 			}
 		}
 
-		for (S64 y = 0; y < 300; ++y)
+		for (S64 y = 0; y < grid_size; ++y)
 		{
 			std::vector<std::vector<S64>>& row = power_levels[y];
-			for (S64 x = 0; x < 300; ++x)
+			for (S64 x = 0; x < grid_size; ++x)
 			{
-				for (S64 size = 2; size <= 300; ++size)
+				for (S64 size = 2; size <= grid_size; ++size)
 				{
-					if (x + size > 300 || y + size > 300) break;
+					if (x + size > grid_size || y + size > grid_size) break;
 					S64 value = row[x][size - 2];
 					const S64 last_column = x + size - 1;
 					const S64 last_row = y + size - 1;
@@ -65,9 +71,10 @@ namespace
 	{
 		Vector2 point{};
 		S64 max = 0;
-		for (S64 y = 0; y < 298; ++y)
+		const S64 grid_size = std::ssize(power_levels);
+		for (S64 y = 0; y < grid_size - 2; ++y)
 		{
-			for (S64 x = 0; x < 298; ++x)
+			for (S64 x = 0; x < grid_size - 2; ++x)
 			{
 				const S64 value = power_levels[y][x][2];
 				if (value > max)
@@ -85,9 +92,10 @@ namespace
 		Vector2 point;
 		S64 size = 0;
 		S64 max = 0;
-		for (S64 y = 0; y < 300; ++y)
+		const S64 grid_size = std::ssize(power_levels);
+		for (S64 y = 0; y < grid_size; ++y)
 		{
-			for (S64 x = 0; x < 300; ++x)
+			for (S64 x = 0; x < grid_size; ++x)
 			{
 				const auto& data = power_levels[y][x];
 				for (S64 i = 0; i < std::ssize(data); ++i)
@@ -115,13 +123,19 @@ TEST_CASE("2018 day 11 part 1", "[2018][day11][part1]")
 
 SOLVE
 {
+	S64 grid_size = default_grid_size;
+	if (argc > 1)
+	{
+		grid_size = std::stoll(argv[1]);
+	}
+
 	S64 grid_serial_number;
 	std::cin >> grid_serial_number;
-	const auto power_levels = get_power_levels(grid_serial_number);
+	const auto power_levels = get_power_levels(grid_serial_number, grid_size);
 
 	const auto point = part_one(power_levels);
-	std::cout << point.x << ',' << point.y << '\n';
+	aoc::answer(1, std::format("{},{}", point.x, point.y));
 
 	const auto pair = part_two(power_levels);
-	std::cout << pair.first.x << ',' << pair.first.y << ',' << pair.second << '\n';
+	aoc::answer(2, std::format("{},{},{}", pair.first.x, pair.first.y, pair.second));
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
 #include "aoc.h"
 #include "aoc/core.h"
 #include "aoc/orbit_structure.h"
+#include "aoc/scan.h"
 
 #include <bitset>
 #include <iostream>
 #include <numeric>
-#include <regex>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace
 {
@@ -39,18 +41,21 @@ namespace
 
 	std::pair<S64, S64> parse_rule(const std::string& line)
 	{
-		static const std::regex re(R"(([.#]{5}) => ([.#]))");
-		std::smatch match;
-		std::regex_match(line, match, re);
+		std::string_view pots;
+		char result = 0;
+		if (!aoc::scan<"{} => {}">(line, pots, result) || pots.size() != 5)
+		{
+			throw std::runtime_error("Invalid rule");
+		}
 		S64 key = 0;
 		for (int i = 0; i < 5; ++i)
 		{
-			if (line[i] == '#')
+			if (pots[i] == '#')
 			{
 				key |= 1ll << i;
 			}
 		}
-		return { key, match[2].str()[0] == '#' ? 1 : 0 };
+		return { key, result == '#' ? 1 : 0 };
 	}
 
 	std::bitset<32> read_rules(std::istream& input)
@@ -134,6 +139,6 @@ SOLVE
 	const State initial_state = read_initial_state(std::cin);
 	const std::bitset<32> rules = read_rules(std::cin);
 
-	std::cout << part_one(initial_state, rules) << '\n';
-	std::cout << part_two(initial_state, rules) << '\n';
+	aoc::answer(1, part_one(initial_state, rules));
+	aoc::answer(2, part_two(initial_state, rules));
 }
\ No newline at end of file
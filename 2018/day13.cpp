@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <format>
 #include <iostream>
 #include <set>
 #include <string>
@@ -273,8 +274,8 @@ SOLVE
 	replace_carts_with_track(grid, carts);
 
 	const Vector2 collision = part_one(grid, carts);
-	std::cout << collision.x << ',' << collision.y << '\n';
+	aoc::answer(1, std::format("{},{}", collision.x, collision.y));
 
 	const Vector2 last = part_two(grid, carts);
-	std::cout << last.x << ',' << last.y << '\n';
+	aoc::answer(2, std::format("{},{}", last.x, last.y));
 }
\ No newline at end of file
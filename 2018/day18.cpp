@@ -1,162 +1,80 @@
 #include "aoc.h"
 
+#include "aoc/bit_grid.h"
+#include "aoc/grid.h"
 #include "aoc/orbit_structure.h"
 
 namespace
 {
-using Grid = std::vector<std::string>;
-const char open_ground = '.';
 const char tree = '|';
 const char lumberyard = '#';
 
-Grid read_input(std::istream &is)
+// Open ground is everywhere there is neither
+struct Area
 {
-    Grid grid;
-    for (std::string line; std::getline(is, line);)
-    {
-        grid.push_back(std::move(line));
-    }
-    return grid;
-}
+    aoc::Bit_grid trees;
+    aoc::Bit_grid lumberyards;
 
-std::span<char> get_neighbours(const std::span<char, 8> buffer, const Grid &grid, const S64 x, const S64 y)
-{
-    auto iter = buffer.begin();
-    for (S64 ny = y - 1; ny <= y + 1; ++ny)
-    {
-        if (ny < 0 || ny >= std::ssize(grid))
-        {
-            continue;
-        }
-        const std::string_view line = grid[ny];
-        for (S64 nx = x - 1; nx <= x + 1; ++nx)
-        {
-            if (nx < 0 || nx >= line.size())
-            {
-                continue;
-            }
-            if (nx == x && ny == y)
-            {
-                continue;
-            }
-            *iter++ = line[nx];
-        }
-    }
-    return {buffer.begin(), iter};
-}
+    bool operator==(const Area &) const = default;
+};
 
-char update_item(const Grid &grid, const S64 x, const S64 y)
+Area read_input(std::istream &is)
 {
-    std::array<char, 8> neighbours_buffer;
-    const std::span<char> neighbours = get_neighbours(neighbours_buffer, grid, x, y);
-    const char ch = grid[y][x];
-    switch (ch)
-    {
-    case open_ground: {
-        int tree_count = 0;
-        for (const char nc : neighbours)
-        {
-            if (nc == tree)
-            {
-                ++tree_count;
-                if (tree_count == 3)
-                {
-                    return tree;
-                }
-            }
-        }
-    }
-    break;
-
-    case tree: {
-        int lumberyard_count = 0;
-        for (const char nc : neighbours)
-        {
-            if (nc == lumberyard)
-            {
-                ++lumberyard_count;
-                if (lumberyard_count == 3)
-                {
-                    return lumberyard;
-                }
-            }
-        }
-    }
-    break;
-
-    case lumberyard: {
-        bool has_lumberyard = false;
-        bool has_tree = false;
-        for (const char nc : neighbours)
-        {
-            has_lumberyard |= nc == lumberyard;
-            has_tree |= nc == tree;
-        }
-
-        if (!has_lumberyard || !has_tree)
-        {
-            return open_ground;
-        }
-    }
-    break;
-    }
-
-    return ch;
+    const aoc::Grid<char> grid = aoc::read_grid(is);
+    return {aoc::Bit_grid::from_grid(grid, [](const char ch) { return ch == tree; }),
+            aoc::Bit_grid::from_grid(grid, [](const char ch) { return ch == lumberyard; })};
 }
 
-Grid update(const Grid &grid)
+Area update(const Area &area)
 {
-    Grid new_grid = grid;
-    for (S64 y = 0; y < std::ssize(grid); ++y)
+    const S64 width = area.trees.width();
+    const S64 height = area.trees.height();
+    Area new_area{aoc::Bit_grid(width, height), aoc::Bit_grid(width, height)};
+    const auto words = static_cast<std::size_t>(area.trees.words_per_row());
+    for (S64 y = 0; y < height; ++y)
     {
-        const std::string_view line = grid[y];
-        for (S64 x = 0; x < line.size(); ++x)
+        const std::span<const U64> trees = area.trees.row(y);
+        const std::span<const U64> lumberyards = area.lumberyards.row(y);
+        const std::span<U64> new_trees = new_area.trees.row(y);
+        const std::span<U64> new_lumberyards = new_area.lumberyards.row(y);
+        for (std::size_t i = 0; i < words; ++i)
         {
-            new_grid[y][x] = update_item(grid, x, y);
+            const aoc::Neighbour_count tree_count = aoc::count_neighbours(area.trees, y, i);
+            const aoc::Neighbour_count lumberyard_count = aoc::count_neighbours(area.lumberyards, y, i);
+            const U64 inside = i + 1 == words ? area.trees.last_word_mask() : ~U64{0};
+            const U64 open_ground = ~(trees[i] | lumberyards[i]) & inside;
+            const U64 many_lumberyards = lumberyard_count.at_least(3);
+
+            new_trees[i] = (open_ground & tree_count.at_least(3)) | (trees[i] & ~many_lumberyards);
+            new_lumberyards[i] = (trees[i] & many_lumberyards) |
+                                 (lumberyards[i] & lumberyard_count.at_least(1) & tree_count.at_least(1));
         }
     }
-    return new_grid;
+    return new_area;
 }
 
-S64 calculate_resource_value(const Grid &grid)
+S64 calculate_resource_value(const Area &area)
 {
-    S64 trees = 0;
-    S64 lumberyards = 0;
-    for (const std::string &line : grid)
-    {
-        for (const char ch : line)
-        {
-            switch (ch)
-            {
-            case tree:
-                ++trees;
-                break;
-            case lumberyard:
-                ++lumberyards;
-                break;
-            }
-        }
-    }
-    return trees * lumberyards;
+    return area.trees.count() * area.lumberyards.count();
 }
 
-S64 part_one(const Grid &grid)
+S64 part_one(const Area &area)
 {
     const S64 iterations = 10;
-    return calculate_resource_value(aoc::power(grid, update, iterations));
+    return calculate_resource_value(aoc::power(area, update, iterations));
 }
 
-S64 part_two(const Grid &grid)
+S64 part_two(const Area &area)
 {
     const S64 iterations = 1000000000;
-    return calculate_resource_value(aoc::iterate_nonterminating_orbit(grid, update, iterations));
+    return calculate_resource_value(aoc::iterate_nonterminating_orbit(area, update, iterations));
 }
 } // namespace
 
 SOLVE
 {
-    const Grid grid = read_input(std::cin);
+    const Area area = read_input(std::cin);
 
-    std::cout << part_one(grid) << '\n';
-    std::cout << part_two(grid) << '\n';
+    aoc::answer(1, part_one(area));
+    aoc::answer(2, part_two(area));
 }
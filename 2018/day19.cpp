@@ -221,6 +221,6 @@ TEST_CASE("aoc example")
 SOLVE
 {
     const std::pair<S64, std::vector<Instruction>> input = read_input(std::cin);
-    std::cout << part_one(input.first, input.second) << '\n';
-    std::cout << part_two(input.first, input.second) << '\n';
+    aoc::answer(1, part_one(input.first, input.second));
+    aoc::answer(2, part_two(input.first, input.second));
 }
\ No newline at end of file
@@ -97,6 +97,6 @@ SOLVE
 {
 	const std::vector<std::string> lines = read_lines(std::cin);
 
-	std::cout << part_one(lines) << std::endl;
-	std::cout << part_two(lines) << std::endl;
+	aoc::answer(1, part_one(lines));
+	aoc::answer(2, part_two(lines));
 }
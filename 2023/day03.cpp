@@ -218,6 +218,6 @@ SOLVE
 	const std::vector<std::string> schematic = read_input(std::cin);
 	const std::vector<Position> positions = get_number_positions(schematic);
 
-	std::cout << part_one(schematic, positions) << std::endl;
-	std::cout << part_two(schematic, positions) << std::endl;
+	aoc::answer(1, part_one(schematic, positions));
+	aoc::answer(2, part_two(schematic, positions));
 }
@@ -87,6 +87,6 @@ SOLVE
 {
 	const std::vector<Game> games = read_input(std::cin);
 
-	std::cout << part_one(games) << std::endl;
-	std::cout << part_two(games) << std::endl;
+	aoc::answer(1, part_one(games));
+	aoc::answer(2, part_two(games));
 }
@@ -198,6 +198,6 @@ namespace
 SOLVE
 {
 	const Almanac& almanac = read_almanac(std::cin);
-	std::cout << part_one(almanac) << std::endl;
-	std::cout << part_two(almanac) << std::endl;
+	aoc::answer(1, part_one(almanac));
+	aoc::answer(2, part_two(almanac));
 }
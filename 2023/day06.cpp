@@ -90,6 +90,6 @@ namespace
 SOLVE
 {
 	const Input input = read_input(std::cin);
-	std::cout << part_one(input) << std::endl;
-	std::cout << part_two(input) << std::endl;
+	aoc::answer(1, part_one(input));
+	aoc::answer(2, part_two(input));
 }
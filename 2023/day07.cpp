@@ -204,6 +204,6 @@ namespace
 SOLVE
 {
 	const std::vector<Input> inputs = read_input(std::cin);
-	std::cout << part_one(inputs) << std::endl;
-	std::cout << part_two(inputs) << std::endl;
+	aoc::answer(1, part_one(inputs));
+	aoc::answer(2, part_two(inputs));
 }
@@ -1,8 +1,8 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 
 #include <iostream>
 #include <numeric>
-#include <regex>
 #include <string>
 #include <unordered_map>
 
@@ -20,13 +20,13 @@ namespace
 		std::getline(is, input.directions);
 		std::string line;
 		std::getline(is, line);
-		const std::regex re("([A-Z]{3}) = \\(([A-Z]{3}), ([A-Z]{3})\\)");
 		while (std::getline(is, line))
 		{
-			std::smatch match;
-			if (std::regex_match(line, match, re))
+			std::string node;
+			std::pair<std::string, std::string> options;
+			if (aoc::scan<"{} = ({}, {})">(line, node, options.first, options.second))
 			{
-				input.nodes[match[1].str()] = std::make_pair(match[2].str(), match[3].str());
+				input.nodes[std::move(node)] = std::move(options);
 			}
 		}
 		return input;
@@ -77,10 +77,4 @@ namespace
 	}
 }
 
-SOLVE
-{
-	const Input input = read_input(std::cin);
-
-	std::cout << part_one(input) << std::endl;
-	std::cout << part_two(input) << std::endl;
-}
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
@@ -102,6 +102,6 @@ SOLVE
 {
 	const std::vector<std::vector<int>> histories = read_input(std::cin);
 
-	std::cout << part_one(histories) << std::endl;
-	std::cout << part_two(histories) << std::endl;
+	aoc::answer(1, part_one(histories));
+	aoc::answer(2, part_two(histories));
 }
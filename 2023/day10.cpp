@@ -211,7 +211,7 @@ SOLVE
 	}
 
 	// --- Part One ---
-	std::cout << points.size() / 2 << std::endl;
+	aoc::answer(1, points.size() / 2);
 
 	// Replace the pipes not on the loop with '.' tiles.
 	for (int y = 0; y < (int)grid.size(); ++y)
@@ -238,5 +238,5 @@ SOLVE
 	}
 
 	// --- Part Two ---
-	std::cout << enclosed_tiles << std::endl;
+	aoc::answer(2, enclosed_tiles);
 }
@@ -122,11 +122,11 @@ SOLVE
 
 	if (opt_value)
 	{
-		std::cout << calculate_min_distances(points, empty_rows, empty_columns, *opt_value) << std::endl;
+		aoc::answer(1, calculate_min_distances(points, empty_rows, empty_columns, *opt_value));
 	}
 	else
 	{
-		std::cout << calculate_min_distances(points, empty_rows, empty_columns, 2) << std::endl;
-		std::cout << calculate_min_distances(points, empty_rows, empty_columns, 1'000'000) << std::endl;
+		aoc::answer(1, calculate_min_distances(points, empty_rows, empty_columns, 2));
+		aoc::answer(2, calculate_min_distances(points, empty_rows, empty_columns, 1'000'000));
 	}
 }
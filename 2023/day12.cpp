@@ -1,11 +1,12 @@
 #include "aoc.h"
+#include "aoc/string_helpers.h"
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
 #include <iostream>
 #include <numeric>
-#include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <cassert>
@@ -19,17 +20,21 @@ namespace
 		std::vector<std::uint64_t> groups;
 	};
 
-	std::vector<Row> read_input(std::istream& is)
+	std::vector<Row> read_input(const aoc::Input& input)
 	{
 		std::vector<Row> rows;
-		for (std::string line; std::getline(is, line);)
+		rows.reserve(input.line_count());
+		for (std::size_t i = 0; i < input.line_count(); ++i)
 		{
-			char c;
-			std::istringstream iss(line);
+			const std::string_view line = input.line(i);
+			const std::size_t space = line.find(' ');
+			if (space == std::string_view::npos) continue;
 			auto& row = rows.emplace_back();
-			iss >> row.springs;
-			do iss >> row.groups.emplace_back() >> c;
-			while (iss);
+			row.springs = line.substr(0, space);
+			for (const std::string_view group : aoc::split(line.substr(space + 1), ','))
+			{
+				row.groups.push_back(aoc::convert_unguarded<std::uint64_t>(group));
+			}
 		}
 		return rows;
 	}
@@ -165,10 +170,10 @@ TEST_CASE("count solutions", "[count]")
 	REQUIRE(solve("?###????????", {3,2,1}) == 10);
 }
 
-SOLVE
+SOLVE_INPUT
 {
-	const std::vector<Row> rows = read_input(std::cin);
+	const std::vector<Row> rows = read_input(input);
 
-	std::cout << part_one(rows) << std::endl;
-	std::cout << part_two(rows) << std::endl;
+	aoc::answer(1, part_one(rows));
+	aoc::answer(2, part_two(rows));
 }
@@ -119,6 +119,6 @@ SOLVE
 {
 	const std::vector<Grid> grids = read_input(std::cin);
 
-	std::cout << part_one(grids) << std::endl;
-	std::cout << part_two(grids) << std::endl;
+	aoc::answer(1, part_one(grids));
+	aoc::answer(2, part_two(grids));
 }
@@ -1,136 +1,79 @@
 #include "aoc.h"
+#include <aoc/grid.h>
 #include <aoc/orbit_structure.h>
 
+#include <algorithm>
 #include <iostream>
-#include <iterator>
-#include <string>
-#include <vector>
 
 #include <cstddef>
 
 namespace
 {
-	using Grid = std::vector<std::string>;
+	using Grid = aoc::Grid<char>;
 
 	Grid read_input(std::istream& is)
 	{
-		using I = std::istream_iterator<std::string>;
-		return { I{is}, I{} };
+		return aoc::read_grid(is);
 	}
 
-	void drop_boulder_north(Grid& grid, std::size_t x, std::size_t y)
+	/*
+	 * Roll every boulder as far towards the start of its row of the view as it goes, the other directions are the same
+	 * roll on a transposed or rotated view
+	 */
+	void roll(const aoc::Grid_view<char> view)
 	{
-		while (y > 0 && grid[y - 1][x] == '.')
+		for (S64 y = 0; y < view.height(); ++y)
 		{
-			std::swap(grid[y - 1][x], grid[y][x]);
-			--y;
-		}
-	}
-
-	Grid slide_north(Grid grid)
-	{
-		for (std::size_t x = 0; x < grid[0].size(); ++x)
-		{
-			for (std::size_t y = 0; y < grid.size(); ++y)
+			S64 free = 0;
+			for (S64 x = 0; x < view.width(); ++x)
 			{
-				if (grid[y][x] == 'O') drop_boulder_north(grid, x, y);
+				const char c = view(x, y);
+				if (c == '#')
+				{
+					free = x + 1;
+				}
+				else if (c == 'O')
+				{
+					view(x, y) = '.';
+					view(free, y) = 'O';
+					++free;
+				}
 			}
 		}
-		return grid;
-	}
-
-	void drop_boulder_west(Grid& grid, std::size_t x, std::size_t y)
-	{
-		while (x > 0 && grid[y][x - 1] == '.')
-		{
-			std::swap(grid[y][x - 1], grid[y][x]);
-			--x;
-		}
 	}
 
-	Grid slide_west(Grid grid)
-	{
-		for (std::size_t y = 0; y < grid.size(); ++y)
-		{
-			for (std::size_t x = 0; x < grid.size(); ++x)
-			{
-				if (grid[y][x] == 'O') drop_boulder_west(grid, x, y);
-			}
-		}
-		return grid;
-	}
-
-	void drop_boulder_south(Grid& grid, std::size_t x, std::size_t y)
-	{
-		while (y + 1 < grid.size() && grid[y + 1][x] == '.')
-		{
-			std::swap(grid[y + 1][x], grid[y][x]);
-			++y;
-		}
-	}
-
-	Grid slide_south(Grid grid)
-	{
-		for (std::size_t x = 0; x < grid.front().size(); ++x)
-		{
-			for (std::size_t y = grid.size(); y > 0; --y)
-			{
-				if (grid[y - 1][x] == 'O') drop_boulder_south(grid, x, y - 1);
-			}
-		}
-		return grid;
-	}
-
-	void drop_boulder_east(Grid& grid, std::size_t x, std::size_t y)
-	{
-		while (x + 1 < grid[y].size() && grid[y][x + 1] == '.')
-		{
-			std::swap(grid[y][x], grid[y][x + 1]);
-			++x;
-		}
-	}
-
-	Grid slide_east(Grid grid)
+	Grid slide_north(Grid grid)
 	{
-		for (std::size_t y = 0; y < grid.size(); ++y)
-		{
-			for (std::size_t x = grid[y].size(); x > 0; --x)
-			{
-				if (grid[y][x - 1] == 'O') drop_boulder_east(grid, x - 1, y);
-			}
-		}
+		roll(grid.transposed());
 		return grid;
 	}
 
-	std::size_t get_total_load(const std::vector<std::string>& grid)
+	std::size_t get_total_load(const Grid& grid)
 	{
 		std::size_t total_load = 0;
-		for (std::size_t y = 0; y < grid.size(); ++y)
+		for (S64 y = 0; y < grid.height(); ++y)
 		{
-			std::size_t load = grid.size() - y;
-			for (std::size_t x = 0; x < grid[y].size(); ++x)
-			{
-				if (grid[y][x] == 'O') total_load += load;
-			}
+			const auto load = static_cast<std::size_t>(grid.height() - y);
+			total_load += load * static_cast<std::size_t>(std::ranges::count(grid.row(y), 'O'));
 		}
 		return total_load;
 	}
 
-	std::size_t part_one(const std::vector<std::string>& grid)
+	std::size_t part_one(const Grid& grid)
 	{
 		return get_total_load(slide_north(grid));
 	}
 
-	std::vector<std::string> perform_cycle(std::vector<std::string> grid)
+	Grid perform_cycle(Grid grid)
 	{
-		grid = slide_north(grid);
-		grid = slide_west(grid);
-		grid = slide_south(grid);
-		grid = slide_east(grid);
+		roll(grid.transposed());
+		roll(grid.view());
+		roll(grid.rotated_clockwise());
+		roll(grid.rotated_counter_clockwise().transposed());
 		return grid;
 	}
 
-	std::size_t part_two(const std::vector<std::string>& grid)
+	std::size_t part_two(const Grid& grid)
 	{
 		std::size_t iterations = 1000000000;
 		auto os = aoc::orbit_structure_nonterminating_orbit(grid, perform_cycle);
@@ -142,8 +85,8 @@ namespace
 
 SOLVE
 {
-	const std::vector<std::string> grid = read_input(std::cin);
+	const Grid grid = read_input(std::cin);
 
-	std::cout << part_one(grid) << std::endl;
-	std::cout << part_two(grid) << std::endl;
+	aoc::answer(1, part_one(grid));
+	aoc::answer(2, part_two(grid));
 }
@@ -86,6 +86,6 @@ SOLVE
 	const std::string input = read_input(std::cin);
 	const std::vector<std::string_view> parts = aoc::split(input, ',');
 
-	std::cout << part_one(parts) << std::endl;
-	std::cout << part_two(parts) << std::endl;
+	aoc::answer(1, part_one(parts));
+	aoc::answer(2, part_two(parts));
 }
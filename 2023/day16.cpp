@@ -1,9 +1,9 @@
 #include "aoc.h"
+#include "aoc/grid.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
-#include <iterator>
-#include <string>
-#include <unordered_set>
 #include <vector>
 
 #include <cstddef>
@@ -11,7 +11,13 @@
 
 namespace
 {
-	enum class Direction
+	using Grid = aoc::Grid<char>;
+
+	// The border around the contraption, beams reaching it have left
+	constexpr char outside = 'X';
+
+	// The directions in the order of the neighbour offsets of the grid
+	enum Direction : std::uint8_t
 	{
 		right = 0,
 		down,
@@ -21,239 +27,99 @@ namespace
 
 	struct Beam
 	{
-		std::uint32_t x;
-		std::uint32_t y;
-		Direction d;
-
-		operator std::uint32_t() const
-		{
-			return (x << 15) | (y << 2) | (std::uint32_t)d;
-		}
+		S64 index;
+		std::uint8_t d;
 	};
 
-	using Grid = std::vector<std::string>;
-
 	Grid read_input(std::istream& is)
 	{
-		using I = std::istream_iterator<std::string>;
-		return { I{is}, I{} };
-	}
-
-	bool can_move(const Grid& grid, const Beam& beam)
-	{
-		switch (beam.d)
-		{
-		case Direction::right: return beam.x + 1 < grid[beam.y].size();
-		case Direction::down: return beam.y + 1 < grid.size();
-		case Direction::left: return beam.x > 0;
-		case Direction::up: return beam.y > 0;
-		}
-		return false;
+		return aoc::read_grid(is, outside);
 	}
 
-	class Beam_adder
+	/*
+	 * Follows the beams through the grid, the buffers are kept between starting points
+	 */
+	class Beam_tracer
 	{
 	private:
+		const Grid& m_grid;
+		std::array<S64, 4> m_offsets;
+		// A bit for each direction a beam has gone through the cell in
+		std::vector<std::uint8_t> m_energised;
 		std::vector<Beam> m_beams;
-		std::unordered_set<std::uint32_t> m_visited;
 
 	public:
-		void add(const Beam& beam)
+		explicit Beam_tracer(const Grid& grid)
+			: m_grid(grid)
+			, m_offsets(grid.neighbour_offsets_4())
+			, m_energised(static_cast<std::size_t>(grid.size()))
 		{
-			const auto u32 = (std::uint32_t)beam;
-			if (m_visited.contains(u32)) return;
-			m_visited.insert(u32);
-			m_beams.push_back(beam);
 		}
 
-		Beam pop()
+		std::size_t count_energy(const Beam& start)
 		{
-			Beam beam = m_beams.back();
-			m_beams.pop_back();
-			return beam;
-		}
-
-		bool empty() const
-		{
-			return m_beams.empty();
-		}
-
-		std::size_t seen() const
-		{
-			const std::uint32_t p_mask = (2 << 15) - 1;
-			std::unordered_set<std::uint32_t> points;
-			for (const std::uint32_t beam : m_visited)
-			{
-				std::uint32_t y = (beam >> 2) & p_mask;
-				std::uint32_t x = (beam >> 17) & p_mask;
-				points.emplace(x << 16u | y);
-			}
-			return points.size();
+			std::ranges::fill(m_energised, 0);
+			m_beams.push_back(start);
+			while (!m_beams.empty())
+			{
+				auto [index, d] = m_beams.back();
+				m_beams.pop_back();
+				while (m_grid[index] != outside)
+				{
+					std::uint8_t& energised = m_energised[index];
+					if (energised & (1u << d)) break;
+					energised |= 1u << d;
+
+					switch (m_grid[index])
+					{
+					case '/': d ^= 3; break;
+					case '\\': d ^= 1; break;
+					case '|':
+						if (d == right || d == left)
+						{
+							m_beams.push_back({ index + m_offsets[up], up });
+							d = down;
+						}
+						break;
+					case '-':
+						if (d == down || d == up)
+						{
+							m_beams.push_back({ index + m_offsets[left], left });
+							d = right;
+						}
+						break;
+					default: break;
+					}
+					index += m_offsets[d];
+				}
+			}
+			const auto is_energised = [](const std::uint8_t energised) { return energised != 0; };
+			return static_cast<std::size_t>(std::ranges::count_if(m_energised, is_energised));
 		}
 	};
 
-	void move_right(const Grid& grid, const Beam& beam, Beam_adder& beams)
-	{
-		switch (grid[beam.y][beam.x])
-		{
-		case '|':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::down});
-				beams.add(Beam{beam.x, beam.y, Direction::up});
-			}
-			break;
-		case '/':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::up});
-			}
-			break;
-		case '\\':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::down});
-			}
-			break;
-		default:
-			{
-				beams.add(beam);
-			}
-			break;
-		}
-	}
-
-	void move_down(const Grid& grid, const Beam& beam, Beam_adder& beams)
-	{
-		switch (grid[beam.y][beam.x])
-		{
-		case '-':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::right});
-				beams.add(Beam{beam.x, beam.y, Direction::left});
-			}
-			break;
-		case '/':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::left});
-			}
-			break;
-		case '\\':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::right});
-			}
-			break;
-		default:
-			{
-				beams.add(beam);
-			}
-			break;
-		}
-	}
-
-	void move_left(const Grid& grid, const Beam& beam, Beam_adder& beams)
-	{
-		switch (grid[beam.y][beam.x])
-		{
-		case '|':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::down});
-				beams.add(Beam{beam.x, beam.y, Direction::up});
-			}
-			break;
-		case '/':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::down});
-			}
-			break;
-		case '\\':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::up});
-			}
-			break;
-		default:
-			{
-				beams.add(beam);
-			}
-			break;
-		}
-	}
-
-	void move_up(const Grid& grid, const Beam& beam, Beam_adder& beams)
-	{
-		switch (grid[beam.y][beam.x])
-		{
-		case '-':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::right});
-				beams.add(Beam{beam.x, beam.y, Direction::left});
-			}
-			break;
-		case '/':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::right});
-			}
-			break;
-		case '\\':
-			{
-				beams.add(Beam{beam.x, beam.y, Direction::left});
-			}
-			break;
-		default:
-			{
-				beams.add(beam);
-			}
-			break;
-		}
-	}
-
-	void move(const Grid& grid, Beam beam, Beam_adder& beams)
-	{
-		switch (beam.d)
-		{
-		case Direction::right: ++beam.x; move_right(grid, beam, beams); break;
-		case Direction::down: ++beam.y; move_down(grid, beam, beams); break;
-		case Direction::left: --beam.x; move_left(grid, beam, beams); break;
-		case Direction::up: --beam.y; move_up(grid, beam, beams); break;
-		}
-	}
-
-	std::size_t count_energy(const Grid& grid, const Beam& start)
-	{
-		Beam_adder beams;
-		switch (start.d)
-		{
-		case Direction::right: move_right(grid, start, beams); break;
-		case Direction::down: move_down(grid, start, beams); break;
-		case Direction::left: move_left(grid, start, beams); break;
-		case Direction::up: move_up(grid, start, beams); break;
-		}
-		while (!beams.empty())
-		{
-			Beam beam = beams.pop();
-			if (can_move(grid, beam)) move(grid, beam, beams);
-		}
-		return beams.seen();
-	}
-
 	std::size_t part_one(const Grid& grid)
 	{
-		return count_energy(grid, Beam{0, 0, Direction::right});
+		return Beam_tracer(grid).count_energy(Beam{ grid.index(0, 0), right });
 	}
 
 	std::size_t part_two(const Grid& grid)
 	{
+		Beam_tracer tracer(grid);
 		std::size_t max = 0;
 
 		// top and bottom row
-		for (std::uint32_t x = 0; x < grid[0].size(); ++x)
+		for (S64 x = 0; x < grid.width(); ++x)
 		{
-			max = std::max(max, count_energy(grid, Beam{x, 0, Direction::down}));
-			max = std::max(max, count_energy(grid, Beam{x, (std::uint32_t)grid.size() - 1, Direction::up}));
+			max = std::max(max, tracer.count_energy(Beam{ grid.index(x, 0), down }));
+			max = std::max(max, tracer.count_energy(Beam{ grid.index(x, grid.height() - 1), up }));
 		}
 
 		// left and right column
-		for (std::uint32_t y = 0; y < grid.size(); ++y)
+		for (S64 y = 0; y < grid.height(); ++y)
 		{
-			max = std::max(max, count_energy(grid, Beam{0, y, Direction::right}));
-			max = std::max(max, count_energy(grid, Beam{(std::uint32_t)grid[y].size() - 1, y, Direction::left}));
+			max = std::max(max, tracer.count_energy(Beam{ grid.index(0, y), right }));
+			max = std::max(max, tracer.count_energy(Beam{ grid.index(grid.width() - 1, y), left }));
 		}
 		return max;
 	}
@@ -263,6 +129,6 @@ SOLVE
 {
 	const Grid grid = read_input(std::cin);
 
-	std::cout << part_one(grid) << std::endl;
-	std::cout << part_two(grid) << std::endl;
+	aoc::answer(1, part_one(grid));
+	aoc::answer(2, part_two(grid));
 }
@@ -1,207 +1,153 @@
 #include "aoc.h"
+#include "aoc/grid.h"
+#include "aoc/shortest_paths.h"
 
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
+#include <array>
 #include <iostream>
-#include <iterator>
-#include <queue>
-#include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include <cassert>
-#include <cstdint>
-
 namespace
 {
-	enum class Direction
+	using Grid = aoc::Grid<char>;
+
+	/*
+	 * The crucible has to turn after every run of blocks, so all that matters about how it got to a block is whether it
+	 * was going across or along. A state is the index of the block times two plus 0 for arriving across and 1 for
+	 * arriving along a column.
+	 */
+	enum Axis : U32
 	{
-		right,
-		down,
-		left,
-		up
+		across = 0,
+		along = 1,
 	};
 
-	struct Node
+	U32 make_state(const Grid& grid, const S64 x, const S64 y, const Axis axis)
 	{
-		std::uint32_t x;
-		std::uint32_t y;
-		Direction d;
-		std::uint32_t k;
-			
-		operator std::uint32_t() const
+		return static_cast<U32>(grid.index(x, y) * 2 + axis);
+	}
+
+	/*
+	 * The bucket queue with the time spent pushing and popping traced
+	 */
+	class Traced_queue
+	{
+	private:
+		aoc::Bucket_queue m_queue;
+
+	public:
+		explicit Traced_queue(const S64 max_weight)
+			: m_queue(max_weight)
 		{
-			assert(k >= 0 && k < 16);
-			return (k << 28) | ((std::uint32_t)d << 26) | (y << 13) | x;
 		}
 
-		std::strong_ordering operator<=>(const Node&) const = default;
-	};
-}
+		void push(const S64 key, const U32 state)
+		{
+			AOC_TRACE_SCOPE("queue push");
+			m_queue.push(key, state);
+		}
 
-namespace std
-{
-	template <>
-	struct hash<Node>
-	{
-		std::uint64_t operator()(const Node& node) const
+		std::pair<S64, U32> pop()
 		{
-			return std::hash<std::uint32_t>()(static_cast<std::uint32_t>(node));
+			AOC_TRACE_SCOPE("queue pop");
+			return m_queue.pop();
 		}
-	};
-}
 
-namespace
-{
-	using Grid = std::vector<std::string>;
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_queue.empty();
+		}
+
+		void clear()
+		{
+			m_queue.clear();
+		}
+	};
 
 	Grid read_input(std::istream& is)
 	{
-		using I = std::istream_iterator<std::string>;
-		return { I{is}, I{} };
+		return aoc::read_grid(is);
 	}
 
-	std::vector<std::pair<int, Node>> get_neighbours(const Grid& grid, const Node& node, std::uint32_t min, std::uint32_t max)
+	/*
+	 * Calls the visitor with each state a run of between min and max blocks leads to and the heat lost on the way
+	 */
+	template <typename F>
+	void get_neighbours(const Grid& grid, const U32 state, const S64 min, const S64 max, F visit)
 	{
-		std::vector<std::pair<int, Node>> result;
-		// right
-		if (node.d != Direction::left && node.d != Direction::right)
-		{
-			int heat = 0;
-			for (std::uint32_t k = 1; k <= max && node.x + k < grid.front().size(); ++k)
-			{
-				heat += grid[node.y][node.x + k] - '0';
-				if (k >= min)
-				{
-					result.emplace_back(heat, Node{node.x + k, node.y, Direction::right, k});
-				}
-			}
-		}
-		// down
-		if (node.d != Direction::up && node.d != Direction::down)
+		const aoc::Vector2 position = grid.position(state / 2);
+		const auto arrived = static_cast<Axis>(state % 2);
+		const std::array<aoc::Vector2, 2> directions = arrived == across
+			? std::array{ aoc::Vector2::south, aoc::Vector2::north }
+			: std::array{ aoc::Vector2::east, aoc::Vector2::west };
+		const Axis leaving = arrived == across ? along : across;
+		for (const aoc::Vector2& direction : directions)
 		{
-			int heat = 0;
-			for (std::uint32_t k = 1; k <= max && node.y + k < grid.size(); ++k)
+			S64 heat = 0;
+			aoc::Vector2 next = position;
+			for (S64 k = 1; k <= max; ++k)
 			{
-				heat += grid[node.y + k][node.x] - '0';
-				if (k >= min)
+				next += direction;
+				if (!grid.contains(next))
 				{
-					result.emplace_back(heat, Node{node.x, node.y + k, Direction::down, k});
+					break;
 				}
-			}
-		}
-		// left
-		if (node.d != Direction::right && node.d != Direction::left)
-		{
-			int heat = 0;
-			for (std::uint32_t k = 1; k <= max && node.x > k - 1; ++k)
-			{
-				heat += grid[node.y][node.x - k] - '0';
+				heat += grid[next] - '0';
 				if (k >= min)
 				{
-					result.emplace_back(heat, Node{node.x - k, node.y, Direction::left, k});
+					visit(make_state(grid, next.x, next.y, leaving), heat);
 				}
 			}
 		}
-		// up
-		if (node.d != Direction::down && node.d != Direction::up)
-		{
-			int heat = 0;
-			for (std::uint32_t k = 1; k <= max && node.y > k - 1; ++k)
-			{
-				heat += grid[node.y - k][node.x] - '0';
-				if (k >= min)
-				{
-					result.emplace_back(heat, Node{node.x, node.y - k, Direction::up, k});
-				}
-			}
-		}
-		return result;
 	}
 
-	int shortest_path(const Grid& grid, std::uint32_t min, std::uint32_t max)
+	S64 shortest_path(const Grid& grid, const S64 min, const S64 max)
 	{
-		std::unordered_map<Node, int> dist;
-		for (std::size_t y = 0; y < grid.size(); ++y)
-		{
-			for (std::size_t x = 0; x < grid[y].size(); ++x)
-			{
-				for (std::uint32_t d = 0; d < 4; ++d)
-				{
-					for (std::uint32_t k = min; k <= max; ++k)
-					{
-						const Node node{(std::uint32_t)x, (std::uint32_t)y, (Direction)d, k};
-						dist[node] = std::numeric_limits<int>::max();
-					}
-				}
-			}
-		}
-
-		const auto r = [&dist] (const Node& x, const Node& y) -> bool
-		{
-			return dist[x] > dist[y];
+		AOC_TRACE_SCOPE("shortest path");
+		// The heat lost in one run is at most 9 for each block
+		aoc::Shortest_paths<Traced_queue> paths(static_cast<std::size_t>(grid.size()) * 2, Traced_queue(9 * max));
+		const auto neighbours = [&](const U32 state, const auto& visit) {
+			AOC_TRACE_SCOPE("neighbours");
+			get_neighbours(grid, state, min, max, visit);
 		};
-		std::priority_queue<Node, std::vector<Node>, decltype(r)> queue(r);
-
-		for (const Direction d : { Direction::right, Direction::down} )
-		{
-			const Node node{0, 0, d, 0};
-			dist[node] = 0;
-			queue.push(node);
-		}
-
-		while (!queue.empty())
-		{
-			const Node u = queue.top();
-			queue.pop();
-
-			for (const std::pair<int, Node>& pair : get_neighbours(grid, u, min, max))
-			{
-				int alt = dist[u] + pair.first;
-				if (alt < dist[pair.second])
-				{
-					queue.push(pair.second);
-					dist[pair.second] = alt;
-				}
-			}
-		}
 
-		auto min_dist = std::numeric_limits<int>::max();
-		for (std::uint32_t d = 0; d < 4; ++d)
-		{
-			for (std::uint32_t k = min; k <= max; ++k)
-			{
-				const Node node{(std::uint32_t)grid.front().size() - 1, (std::uint32_t)grid.size() - 1, (Direction)d, k};
-				min_dist = std::min(min_dist, dist[node]);
-			}
-		}
-		return min_dist;
+		const S64 end_x = grid.width() - 1;
+		const S64 end_y = grid.height() - 1;
+		const U32 end = make_state(grid, end_x, end_y, across) / 2;
+		const std::array<U32, 2> sources = { make_state(grid, 0, 0, across), make_state(grid, 0, 0, along) };
+		paths.run(sources, neighbours, [&](const U32 state) { return state / 2 == end; });
+		return std::min(paths.distance(make_state(grid, end_x, end_y, across)),
+			paths.distance(make_state(grid, end_x, end_y, along)));
 	}
 }
 
 TEST_CASE("get neighbours", "[neighbours]")
 {
-	std::vector<std::string> grid = { "11111" };
+	const Grid grid = aoc::parse_grid("11111");
 	{
-		const std::vector<std::pair<int, Node>> neighbours = get_neighbours(grid, Node{0, 0, Direction::down, 0}, 1, 3);
+		std::vector<std::pair<U32, S64>> neighbours;
+		get_neighbours(grid, make_state(grid, 0, 0, along), 1, 3,
+			[&](const U32 state, const S64 heat) { neighbours.emplace_back(state, heat); });
 		REQUIRE(neighbours.size() == 3);
 		for (std::size_t i = 0; i < neighbours.size(); ++i)
 		{
-			REQUIRE(neighbours[i].second == Node{(std::uint32_t)i + 1, 0, Direction::right, (std::uint32_t)(i + 1)});
+			REQUIRE(neighbours[i].first == make_state(grid, static_cast<S64>(i) + 1, 0, across));
+			REQUIRE(neighbours[i].second == static_cast<S64>(i) + 1);
 		}
 	}
 }
 
 TEST_CASE("shortest paths", "[path]")
 {
-	std::vector<std::string> grid =
-	{
-		"1111",
-		"1121",
-		"1111",
-		"1111",
-	};
+	const Grid grid = aoc::parse_grid(
+		"1111\n"
+		"1121\n"
+		"1111\n"
+		"1111\n");
 	{
 		REQUIRE(shortest_path(grid, 1, 3) == 6);
 	}
@@ -211,6 +157,6 @@ SOLVE
 {
 	const Grid grid = read_input(std::cin);
 
-	std::cout << shortest_path(grid, 1, 3) << std::endl;
-	std::cout << shortest_path(grid, 4, 10) << std::endl;
+	aoc::answer(1, shortest_path(grid, 1, 3));
+	aoc::answer(2, shortest_path(grid, 4, 10));
 }
@@ -127,6 +127,6 @@ SOLVE
 {
 	const std::vector<Instruction> plan = read_input(std::cin);
 
-	std::cout << part_one(plan) << std::endl;
-	std::cout << part_two(plan) << std::endl;
+	aoc::answer(1, part_one(plan));
+	aoc::answer(2, part_two(plan));
 }
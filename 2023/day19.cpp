@@ -1,5 +1,6 @@
 #include "aoc.h"
 #include <aoc/algorithm.h>
+#include <aoc/scan.h>
 #include <aoc/string_helpers.h>
 
 #include <catch2/catch_test_macros.hpp>
@@ -7,7 +8,6 @@
 #include <array>
 #include <iostream>
 #include <numeric>
-#include <regex>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -64,12 +64,13 @@ namespace
 
 	Rule parse_rule(const std::string_view view)
 	{
-		using I = typename std::string_view::const_iterator;
-		using Match = std::match_results<I>;
-		const std::regex re("[xmas][<>](\\d+):(\\w+)");
-		if (Match match; std::regex_match(view.begin(), view.end(), match, re))
+		char key = 0;
+		Rule rule;
+		const bool matched = aoc::scan<"{}{}{}:{}">(view, key, rule.op, rule.value, rule.destination);
+		if (matched && (rule.op == '<' || rule.op == '>'))
 		{
-			return { key_from_char(view[0]), view[1], std::stoll(match[1].str()), match[2].str() };
+			rule.key = key_from_char(key);
+			return rule;
 		}
 		std::cerr << "Unable to parse rule for '" << view << '\'' << std::endl;
 		assert(!"Shouldn't be here");
@@ -84,12 +85,10 @@ namespace
 
 	Workflow parse_workflow(const std::string_view view)
 	{
-		using Match = std::match_results<typename std::string_view::const_iterator>;
-		const std::regex re("(\\w+)\\{(.*)\\}");
-		if (Match match; std::regex_match(view.begin(), view.end(), match, re))
+		std::string name;
+		std::string_view rules_string;
+		if (aoc::scan<"{}{{{}}}">(view, name, rules_string))
 		{
-			std::string name = match[1].str();
-			const std::string rules_string = match[2].str();
 			const std::vector<std::string_view> views = aoc::split(rules_string, ',');
 			assert(!views.empty());
 			std::vector<Rule> rules;
@@ -324,10 +323,4 @@ TEST_CASE("split ratings", "[splitting]")
 	}
 }
 
-SOLVE
-{
-	const Input input = read_input(std::cin);
-
-	std::cout << part_one(input) << std::endl;
-	std::cout << part_two(input) << std::endl;
-}
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
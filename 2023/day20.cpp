@@ -217,7 +217,7 @@ namespace
 	S64 part_two(std::unordered_map<std::string, std::unique_ptr<Module>>& modules)
 	{
 		S64 counter = 0;
-		while (!push_button(modules)) ++counter;
+		while (!push_button(modules) && !aoc::stop_requested()) ++counter;
 		return counter;
 	}
 }
@@ -226,5 +226,5 @@ SOLVE
 {
 	std::unordered_map<std::string, std::unique_ptr<Module>> modules = read_input(std::cin);
 
-	std::cout << part_two(modules) << std::endl;
+	aoc::answer(2, part_two(modules));
 }
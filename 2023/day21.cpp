@@ -1,80 +1,47 @@
 #include "aoc.h"
+#include "aoc/bit_grid.h"
+#include "aoc/grid.h"
 
 #include <iostream>
-#include <set>
 #include <string>
-#include <vector>
-
-#include <cassert>
-#include <cstdint>
 
 namespace
 {
-	using Grid = std::vector<std::string>;
-
-	struct Point
+	struct Garden
 	{
-		std::uint32_t x;
-		std::uint32_t y;
-
-		std::strong_ordering operator<=>(const Point&) const = default;
+		aoc::Bit_grid plots;
+		aoc::Bit_grid start;
 	};
 
-	Grid read_input(std::istream& is)
-	{
-		using I = std::istream_iterator<std::string>;
-		return { I{is}, I{} };
-	}
-
-	bool is_open(const Grid& grid, std::uint32_t x, std::uint32_t y)
+	Garden read_input(std::istream& is)
 	{
-		return grid[y][x] != '#';
+		const aoc::Grid<char> grid = aoc::read_grid(is);
+		return { aoc::Bit_grid::from_grid(grid, [](const char ch) { return ch != '#'; }),
+			aoc::Bit_grid::from_grid(grid, [](const char ch) { return ch == 'S'; }) };
 	}
 
-	std::set<Point> get_next_points(const Grid& grid, const std::set<Point>& curr)
+	std::size_t part_one(const Garden& garden, std::size_t steps)
 	{
-		std::set<Point> points;
-		for (const Point& point : curr)
-		{
-			if (point.x + 1 < grid[point.y].size() && is_open(grid, point.x + 1, point.y))
-				points.emplace(point.x + 1, point.y);
-			if (point.y + 1 < grid.size() && is_open(grid, point.x, point.y + 1))
-				points.emplace(point.x, point.y + 1);
-			if (point.x > 0 && is_open(grid, point.x - 1, point.y))
-				points.emplace(point.x - 1, point.y);
-			if (point.y > 0 && is_open(grid, point.x, point.y - 1))
-				points.emplace(point.x, point.y - 1);
-		}
-		return points;
-	}
-
-	Point get_starting_point(const Grid& grid)
-	{
-		for (std::uint32_t y = 0; y < grid.size(); ++y)
-		{
-			for (std::uint32_t x = 0; x < grid[y].size(); ++x)
-			{
-				if (grid[y][x] == 'S') return { x, y };
-			}
-		}
-		assert(!"Unable to find starting position!");
-		return { 0, 0 };
-	}
-
-	std::size_t part_one(const Grid& grid, std::size_t steps)
-	{
-		std::set<Point> points = { get_starting_point(grid) };
+		aoc::Bit_grid reached = garden.start;
 		for (std::size_t step = 0; step < steps; ++step)
 		{
-			points = get_next_points(grid, points);
+			reached = aoc::spread_4(reached);
+			reached &= garden.plots;
 		}
-		return points.size();
+		return static_cast<std::size_t>(reached.count());
 	}
 }
 
 SOLVE
 {
-	const Grid grid = read_input(std::cin);
+	// The puzzle takes 64 steps, a different number can be passed after the driver's options
+	std::size_t steps = 64;
+	if (argc > 1)
+	{
+		steps = std::stoull(argv[1]);
+	}
+
+	const Garden garden = read_input(std::cin);
 
-	std::cout << part_one(grid, 64) << std::endl;
+	aoc::answer(1, part_one(garden, steps));
 }
@@ -73,6 +73,6 @@ SOLVE
 {
 	const auto [list0, list1] = read_input(std::cin);
 
-	std::cout << part_one(list0, list1) << '\n';
-	std::cout << part_two(list0, list1) << '\n';
+	aoc::answer(1, part_one(list0, list1));
+	aoc::answer(2, part_two(list0, list1));
 }
@@ -163,6 +163,6 @@ SOLVE
 {
 	const Grid input = read_input(std::cin);
 
-	std::cout << part_one(input) << '\n';
-	std::cout << part_two(input) << '\n';
+	aoc::answer(1, part_one(input));
+	aoc::answer(2, part_two(input));
 }
\ No newline at end of file
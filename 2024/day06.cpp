@@ -1,158 +1,101 @@
 #include "aoc.h"
-#include "aoc/orbit_structure.h"
-#include "aoc/vector.h"
+#include "aoc/grid.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
-#include <string>
-#include <unordered_set>
 #include <vector>
 
-using aoc::Vector2;
-
 namespace
 {
-	using Grid = std::vector<std::string>;
-
-	Grid read_input(std::istream& input)
-	{
-		Grid grid;
-		std::string line;
-		while (std::getline(input, line))
-		{
-			grid.push_back(line);
-		}
-		return grid;
-	}
-
-	Vector2 find_guard(const Grid& grid)
-	{
-		for (S64 y = 0; y < std::ssize(grid); ++y)
-		{
-			for (S64 x = 0; x < std::ssize(grid[y]); ++x)
-			{
-				if (grid[y][x] == '^')
-				{
-					return { .x = x, .y = y };
-				}
-			}
-		}
-		return { .x = -1, .y = -1 };
-	}
+	using Grid = aoc::Grid<char>;
 
-	Vector2 turn(const Vector2& p)
-	{
-		if (p == Vector2::east)
-		{
-			return Vector2::south;
-		}
-
-		if (p == Vector2::south)
-		{
-			return Vector2::west;
-		}
-
-		if (p == Vector2::west)
-		{
-			return Vector2::north;
-		}
-
-		return Vector2::east;
-	}
-
-	bool is_valid(const Grid& grid, const Vector2& p)
-	{
-		return p.y >= 0 && p.y < std::ssize(grid) && p.x >= 0 && p.x < std::ssize(grid[p.y]);
-	}
+	// The border around the map, reaching it means the guard has left
+	constexpr char outside = 'O';
 
 	struct Guard
 	{
-		Vector2 position;
-		Vector2 direction;
+		S64 index;
+		// Into the neighbour offsets of the grid, turning right is the next one
+		std::size_t direction;
 	};
 
-	Guard step(const Grid& grid, const Guard& guard)
-	{
-		const Vector2 next = guard.position + guard.direction;
-		if (!is_valid(grid, next))
-		{
-			return { .position = next, .direction = guard.direction };
-		}
-
-		if (grid[next.y][next.x] == '#')
-		{
-			return { .position = guard.position, .direction = turn(guard.direction) };
-		}
+	// Facing north in the order of the neighbour offsets
+	constexpr std::size_t north = 3;
 
-		return { .position = next, .direction = guard.direction };
+	std::size_t turn(const std::size_t direction)
+	{
+		return (direction + 1) % 4;
 	}
 
-	std::unordered_set<S64> get_visited(const Grid& grid, Guard guard)
+	std::vector<U8> get_visited(const Grid& grid, Guard guard)
 	{
-		std::unordered_set<S64> visited;
-		if (grid.empty())
-		{
-			return visited;
-		}
-
-		const S64 width = std::ssize(grid[0]);
-		while (is_valid(grid, guard.position))
+		const std::array<S64, 4> offsets = grid.neighbour_offsets_4();
+		std::vector<U8> visited(grid.size(), 0);
+		while (grid[guard.index] != outside)
 		{
-			visited.insert(guard.position.y * width + guard.position.x);
-			guard = step(grid, guard);
+			visited[guard.index] = 1;
+			const S64 next = guard.index + offsets[guard.direction];
+			if (grid[next] == '#')
+			{
+				guard.direction = turn(guard.direction);
+			}
+			else
+			{
+				guard.index = next;
+			}
 		}
-
 		return visited;
 	}
 
-	struct State
-	{
-		const Grid* grid;
-		Guard guard;
-	};
-	
-	bool operator==(const State& lhs, const State& rhs)
-	{
-		return lhs.guard.position == rhs.guard.position && lhs.guard.direction == rhs.guard.direction;
-	}
-
-	struct Mover
+	/*
+	 * The guard is stuck in a loop after turning the same way at the same place twice. The turns are stamped with the
+	 * number of the walk so the stamps don't have to be cleared between walks.
+	 */
+	bool is_loop(const Grid& grid, Guard guard, std::vector<U32>& turns, const U32 walk)
 	{
-		State operator()(State state) const
+		const std::array<S64, 4> offsets = grid.neighbour_offsets_4();
+		while (grid[guard.index] != outside)
 		{
-			state.guard = step(*state.grid, state.guard);
-			return state;
-		}
-	};
+			const S64 next = guard.index + offsets[guard.direction];
+			if (grid[next] != '#')
+			{
+				guard.index = next;
+				continue;
+			}
 
-	struct Is_valid
-	{
-		bool operator()(const State& state) const
-		{
-			return is_valid(*state.grid, state.guard.position);
+			U32& stamp = turns[guard.index * 4 + guard.direction];
+			if (stamp == walk)
+			{
+				return true;
+			}
+			stamp = walk;
+			guard.direction = turn(guard.direction);
 		}
-	};
+		return false;
+	}
 
-	U64 part_two(Grid grid, const Guard& guard, const std::unordered_set<S64>& visited)
+	U64 part_two(Grid grid, const Guard& guard, const std::vector<U8>& visited)
 	{
 		U64 result = 0;
-		if (grid.empty())
+		std::vector<U32> turns(grid.size() * 4, 0);
+		U32 walk = 0;
+		for (S64 i = 0; i < grid.size(); ++i)
 		{
-			return result;
-		}
+			if (aoc::stop_requested())
+			{
+				break;
+			}
 
-		const S64 width = std::ssize(grid[0]);
-		for (const S64 p : visited)
-		{
-			const S64 y = p / width;
-			const S64 x = p % width;
-			if (grid[y][x] != '.')
+			// Only an obstruction on the guard's path can change where the guard goes
+			if (!visited[i] || grid[i] != '.')
 			{
 				continue;
 			}
 
-			grid[y][x] = '#';
-			result += !aoc::terminating(State{ .grid = &grid, .guard = guard }, Mover{}, Is_valid{});
-			grid[y][x] = '.';
+			grid[i] = '#';
+			result += is_loop(grid, guard, turns, ++walk);
+			grid[i] = '.';
 		}
 
 		return result;
@@ -161,11 +104,10 @@ namespace
 
 SOLVE
 {
-	const Grid grid = read_input(std::cin);
-	const Vector2 start = find_guard(grid);
-	const Guard guard = { .position = start, .direction = Vector2::north };
-	const std::unordered_set<S64> visited = get_visited(grid, guard);
+	const Grid grid = aoc::read_grid(std::cin, outside);
+	const Guard guard = { .index = grid.find('^').value(), .direction = north };
+	const std::vector<U8> visited = get_visited(grid, guard);
 
-	std::cout << visited.size() << '\n';
-	std::cout << part_two(grid, guard, visited) << '\n';
+	aoc::answer(1, std::ranges::count(visited, 1));
+	aoc::answer(2, part_two(grid, guard, visited));
 }
\ No newline at end of file
@@ -124,6 +124,6 @@ SOLVE
 {
 	const std::vector<Equation> equations = read_input(std::cin);
 
-	std::cout << solve(equations, std::span{ s_operations.begin(), 2 }) << '\n';
-	std::cout << solve(equations, s_operations) << '\n';
+	aoc::answer(1, solve(equations, std::span{ s_operations.begin(), 2 }));
+	aoc::answer(2, solve(equations, s_operations));
 }
\ No newline at end of file
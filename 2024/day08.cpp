@@ -121,6 +121,6 @@ namespace
 SOLVE
 {
 	const Grid grid = read_input(std::cin);
-	std::cout << part_one(grid) << '\n';
-	std::cout << part_two(grid) << '\n';
+	aoc::answer(1, part_one(grid));
+	aoc::answer(2, part_two(grid));
 }
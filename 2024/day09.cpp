@@ -48,5 +48,5 @@ SOLVE
 	std::string line;
 	std::getline(std::cin, line);
 
-	std::cout << part_one(line) << '\n';
+	aoc::answer(1, part_one(line));
 }
@@ -1,115 +1,95 @@
 #include "aoc.h"
-#include "aoc/vector.h"
+#include "aoc/grid.h"
+#include "aoc/grid_search.h"
 
+#include <array>
 #include <iostream>
-#include <string>
-#include <unordered_set>
 #include <vector>
 
-using aoc::Vector2;
-
 namespace
 {
-	using Grid = std::vector<std::string>;
+	using Grid = aoc::Grid<char>;
 
 	Grid read_input(std::istream& is)
 	{
-		Grid grid;
-		std::string line;
-		while (std::getline(is, line))
-		{
-			grid.push_back(line);
-		}
-		return grid;
+		// The border is lower than every height so it can never be climbed onto
+		return aoc::read_grid(is, '.');
 	}
 
-	std::vector<Vector2> get_starting_positions(const Grid& grid)
+	std::vector<S64> get_starting_positions(const Grid& grid)
 	{
-		std::vector<Vector2> positions;
-		for (S64 y = 0; y < std::ssize(grid); ++y)
+		std::vector<S64> positions;
+		for (S64 y = 0; y < grid.height(); ++y)
 		{
-			const std::string& row = grid[y];
-			for (S64 x = 0; x < std::ssize(row); ++x)
+			for (S64 x = 0; x < grid.width(); ++x)
 			{
-				if (row[x] == '0')
+				if (grid(x, y) == '0')
 				{
-					positions.emplace_back(x, y);
+					positions.push_back(grid.index(x, y));
 				}
 			}
 		}
 		return positions;
 	}
 
-	bool in_bounds(const Grid& grid, const Vector2 position)
+	bool can_move_to(const Grid& grid, const S64 position, const S64 target)
 	{
-		return position.x >= 0 && position.y >= 0 && position.x < std::ssize(grid[0]) && position.y < std::ssize(grid);
-	}
-
-	bool can_move_to(const Grid& grid, const Vector2 position, const Vector2 target)
-	{
-		if (!in_bounds(grid, target))
-		{
-			return false;
-		}
-
-		return grid[target.y][target.x] - grid[position.y][position.x] == 1;
+		return grid[target] - grid[position] == 1;
 	}
 
-	S64 count_paths(const Grid& grid, const Vector2 position, std::unordered_set<S64>* visited)
+	S64 count_paths(const Grid& grid, const S64 position)
 	{
-		if (visited)
-		{
-			const S64 p = position.x + position.y * std::ssize(grid[0]);
-			if (visited->contains(p))
-			{
-				return 0;
-			}
-			visited->insert(p);
-		}
-
-		if (grid[position.y][position.x] == '9')
+		if (grid[position] == '9')
 		{
 			return 1;
 		}
 
 		S64 result = 0;
-		const Vector2 directions[] = { Vector2::east, Vector2::south, Vector2::west, Vector2::north };
-		for (const Vector2& direction : directions)
+		for (const S64 offset : grid.neighbour_offsets_4())
 		{
-			if (const Vector2 target = position + direction; can_move_to(grid, position, target))
+			if (const S64 target = position + offset; can_move_to(grid, position, target))
 			{
-				result += count_paths(grid, target, visited);
+				result += count_paths(grid, target);
 			}
 		}
 
 		return result;
 	}
 
-	S64 get_trailhead_score(const Grid& grid, const Vector2 position)
+	S64 get_trailhead_score(aoc::Grid_search& search, const Grid& grid, const S64 position)
 	{
-		std::unordered_set<S64> visited;
-		return count_paths(grid, position, &visited);
+		S64 score = 0;
+		const std::array<S64, 1> sources = { position };
+		search.run(
+			sources, [&](const S64 from, const S64 to) { return can_move_to(grid, from, to); },
+			[&](const S64 index) {
+				score += grid[index] == '9';
+				return false;
+			});
+		return score;
 	}
 
-	S64 part_one(const Grid& grid, const std::vector<Vector2>& starting_positions)
+	S64 part_one(const Grid& grid, const std::vector<S64>& starting_positions)
 	{
+		// One search for every trailhead, reusing its buffers
+		aoc::Grid_search search(grid.size(), grid.neighbour_offsets_4());
 		S64 result = 0;
-		for (const Vector2& position : starting_positions)
+		for (const S64 position : starting_positions)
 		{
-			result += get_trailhead_score(grid, position);
+			result += get_trailhead_score(search, grid, position);
 		}
 		return result;
 	}
 
-	S64 get_trailhead_rating(const Grid& grid, const Vector2 position)
+	S64 get_trailhead_rating(const Grid& grid, const S64 position)
 	{
-		return count_paths(grid, position, nullptr);
+		return count_paths(grid, position);
 	}
 
-	S64 part_two(const Grid& grid, const std::vector<Vector2>& starting_positions)
+	S64 part_two(const Grid& grid, const std::vector<S64>& starting_positions)
 	{
 		S64 result = 0;
-		for (const Vector2& position : starting_positions)
+		for (const S64 position : starting_positions)
 		{
 			result += get_trailhead_rating(grid, position);
 		}
@@ -120,8 +100,8 @@ namespace
 SOLVE
 {
 	const Grid grid = read_input(std::cin);
-	const std::vector<Vector2> starting_positions = get_starting_positions(grid);
+	const std::vector<S64> starting_positions = get_starting_positions(grid);
 
-	std::cout << part_one(grid, starting_positions) << '\n';
-	std::cout << part_two(grid, starting_positions) << '\n';
+	aoc::answer(1, part_one(grid, starting_positions));
+	aoc::answer(2, part_two(grid, starting_positions));
 }
\ No newline at end of file
@@ -2,20 +2,14 @@
 #include "aoc/core.h"
 #include "aoc/string_helpers.h"
 
-#include <iostream>
 #include <map>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace
 {
-	std::vector<S64> read_input(std::istream& input)
-	{
-		using I = std::istream_iterator<S64>;
-		return { I(input), I() };
-	}
-
 	std::vector<S64> transform(const S64 value)
 	{
 		std::vector<S64> result;
@@ -36,10 +30,35 @@ namespace
 		return result;
 	}
 
-	S64 blink(const S64 value, const int steps)
+	// The number of stones a stone becomes after some steps
+	using Blink_cache = std::map<std::pair<S64, int>, S64>;
+
+	struct Stones
 	{
-		static std::map<std::pair<S64, int>, S64> s_cache;
-		S64& result = s_cache[{value, steps}];
+		std::vector<S64> values;
+		// Shared by both parts of a solve so part two starts from what part one worked out
+		mutable Blink_cache cache;
+	};
+
+	Stones read_input(const aoc::Input& input)
+	{
+		Stones stones;
+		for (const std::string_view line : input.lines())
+		{
+			for (const std::string_view word : aoc::split(line, ' '))
+			{
+				if (!word.empty())
+				{
+					stones.values.push_back(aoc::convert_unguarded<S64>(word));
+				}
+			}
+		}
+		return stones;
+	}
+
+	S64 blink(const S64 value, const int steps, Blink_cache& cache)
+	{
+		S64& result = cache[{value, steps}];
 		if (result != 0)
 		{
 			return result;
@@ -54,37 +73,32 @@ namespace
 
 		for (const S64 next : input)
 		{
-			result += blink(next, steps - 1);
+			result += blink(next, steps - 1, cache);
 		}
 
 		return result;
 	}
 
-	S64 count_stones(const std::vector<S64>& input, const int steps)
+	S64 count_stones(const Stones& stones, const int steps)
 	{
 		S64 result = 0;
-		for (const S64 value : input)
+		for (const S64 value : stones.values)
 		{
-			result += blink(value, steps);
+			result += blink(value, steps, stones.cache);
 		}
 		return result;
 	}
 
-	S64 part_one(const std::vector<S64>& input)
+	S64 part_one(const Stones& stones)
 	{
-		return count_stones(input, 25);
+		return count_stones(stones, 25);
 	}
 
-	S64 part_two(const std::vector<S64>& input)
+	S64 part_two(const Stones& stones)
 	{
-		return count_stones(input, 75);
+		return count_stones(stones, 75);
 	}
 }
 
-SOLVE
-{
-	const std::vector<S64> input = read_input(std::cin);
-
-	std::cout << part_one(input) << '\n';
-	std::cout << part_two(input) << '\n';
-}
\ No newline at end of file
+// The parts share the cache, so they run one after the other
+SOLVE_PHASES(read_input, part_one, part_two)
\ No newline at end of file
@@ -212,6 +212,6 @@ SOLVE
 	const std::vector<std::string> input = read_input(std::cin);
 	const std::vector<Region> regions = find_regions(input);
 	const Grid grid = make_grid_unique(input, regions);
-	std::cout << part_one(grid, regions) << '\n';
-	std::cout << part_two(grid, regions) << '\n';
+	aoc::answer(1, part_one(grid, regions));
+	aoc::answer(2, part_two(grid, regions));
 }
\ No newline at end of file
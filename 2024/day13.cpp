@@ -1,11 +1,11 @@
 #include <cassert>
 
 #include "aoc.h"
-#include "aoc/string_helpers.h"
+#include "aoc/scan.h"
 #include "aoc/vector.h"
 
 #include <iostream>
-#include <regex>
+#include <string>
 
 using aoc::Vector2;
 
@@ -18,24 +18,21 @@ namespace
 		Vector2 prize;
 	};
 
-	Vector2 parse_vector2(const std::string& line, const std::regex& regex)
-	{
-		std::smatch match;
-		const bool result = std::regex_match(line, match, regex);
-		assert(result);
-		return { aoc::convert_unguarded<S64>(match[1].str()), aoc::convert_unguarded<S64>(match[2].str()) };
-	}
-
 	Vector2 parse_button(const std::string& line)
 	{
-		static const std::regex regex(R"(Button [AB]: X\+(\d+), Y\+(\d+))");
-		return parse_vector2(line, regex);
+		char button = 0;
+		Vector2 result;
+		const bool matched = aoc::scan<"Button {}: X+{}, Y+{}">(line, button, result.x, result.y);
+		assert(matched && (button == 'A' || button == 'B'));
+		return result;
 	}
 
 	Vector2 parse_prize(const std::string& line)
 	{
-		static const std::regex regex(R"(Prize: X=(\d+), Y=(\d+))");
-		return parse_vector2(line, regex);
+		Vector2 result;
+		const bool matched = aoc::scan<"Prize: X={}, Y={}">(line, result.x, result.y);
+		assert(matched);
+		return result;
 	}
 
 	std::vector<Machine> read_input(std::istream& input)
@@ -112,9 +109,4 @@ namespace
 	}
 }
 
-SOLVE
-{
-	const std::vector<Machine> machines = read_input(std::cin);
-	std::cout << part_one(machines) << '\n';
-	std::cout << part_two(machines) << '\n';
-}
\ No newline at end of file
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include "aoc.h"
+#include "aoc/scan.h"
 #include "aoc/vector.h"
 
+#include <catch2/catch_test_macros.hpp>
+
 #include <iostream>
-#include <regex>
 #include <set>
 #include <string>
 #include <vector>
@@ -23,15 +25,10 @@ namespace
 		std::string line;
 		while (std::getline(input, line))
 		{
-			std::regex regex(R"(p=(-?\d+),(-?\d+) v=(-?\d+),(-?\d+))");
-			std::smatch match;
-			if (std::regex_match(line, match, regex))
+			Robot robot;
+			if (aoc::scan<"p={},{} v={},{}">(line, robot.position.x, robot.position.y, robot.velocity.x,
+				robot.velocity.y))
 			{
-				Robot robot;
-				robot.position.x = std::stoi(match[1]);
-				robot.position.y = std::stoi(match[2]);
-				robot.velocity.x = std::stoi(match[3]);
-				robot.velocity.y = std::stoi(match[4]);
 				robots.push_back(robot);
 			}
 		}
@@ -99,6 +96,12 @@ namespace
 
 	void draw_robots(const std::vector<Robot>& robots, const S64 width, const S64 height)
 	{
+		// Only in the log so the picture doesn't end up among the answers
+		if (!aoc::is_logging())
+		{
+			return;
+		}
+
 		std::vector grid(height, std::string(width, '.'));
 		for (const Robot& robot : robots)
 		{
@@ -107,16 +110,16 @@ namespace
 
 		for (const std::string& line : grid)
 		{
-			std::cout << line << '\n';
+			AOC_LOG(line);
 		}
 	}
 
 	S64 part_two(std::vector<Robot> robots, const S64 width, const S64 height)
 	{
-		S64 seconds = 0;
-		while (true)
+		// The robots are back where they started after width * height seconds, so a generated swarm that never spreads
+		// out can't loop forever
+		for (S64 seconds = 1; seconds <= width * height; ++seconds)
 		{
-			++seconds;
 			std::set<Vector2> positions;
 			for (Robot& robot : robots)
 			{
@@ -130,19 +133,37 @@ namespace
 				return seconds;
 			}
 		}
+		return 0;
 	}
 }
 
+TEST_CASE("2024 14 2", "[2024][14][2]")
+{
+	// The moving robot lands on each of the others in turn and has passed both after three seconds
+	const std::vector<Robot> robots = {
+		{ { 0, 0 }, { 1, 0 } },
+		{ { 1, 0 }, { 0, 0 } },
+		{ { 2, 0 }, { 0, 0 } },
+	};
+	REQUIRE(part_two(robots, 7, 5) == 3);
+}
+
 SOLVE
 {
-	const std::vector<Robot> robots = read_input(std::cin);
+	// The puzzle's room is 101 by 103 and part one waits 100 seconds, the example's is 11 by 7. Other sizes can be passed
+	// after the driver's options.
+	S64 width = 101;
+	S64 height = 103;
+	S64 seconds = 100;
+	if (argc > 3)
+	{
+		width = std::stoll(argv[1]);
+		height = std::stoll(argv[2]);
+		seconds = std::stoll(argv[3]);
+	}
 
-	// Example
-	//std::cout << part_one(robots, 11, 7, 100) << '\n';
+	const std::vector<Robot> robots = read_input(std::cin);
 
-	constexpr S64 width = 101;
-	constexpr S64 height = 103;
-	constexpr S64 seconds = 100;
-	std::cout << part_one(robots, width, height, seconds) << '\n';
-	std::cout << part_two(robots, width, height) << '\n';
+	aoc::answer(1, part_one(robots, width, height, seconds));
+	aoc::answer(2, part_two(robots, width, height));
 }
\ No newline at end of file
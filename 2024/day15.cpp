@@ -250,6 +250,6 @@ SOLVE
 	const Grid grid = read_grid(std::cin);
 	const std::string moves = read_moves(std::cin);
 
-	std::cout << part_one(grid, moves) << '\n';
-	std::cout << part_two(grid, moves) << '\n';
+	aoc::answer(1, part_one(grid, moves));
+	aoc::answer(2, part_two(grid, moves));
 }
\ No newline at end of file
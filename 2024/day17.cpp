@@ -1,12 +1,13 @@
 #include "aoc.h"
 #include "aoc/core.h"
+#include "aoc/scan.h"
 #include "aoc/string_helpers.h"
 
 #include <array>
 #include <iostream>
-#include <regex>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -22,10 +23,13 @@ namespace
 
 	S64 parse_register(const std::string& line)
 	{
-		static const std::regex regex(R"(Register [ABC]: (\d+))");
-		std::smatch match;
-		std::regex_match(line, match, regex);
-		return std::stoll(match[1]);
+		char name = 0;
+		S64 value = 0;
+		if (!aoc::scan<"Register {}: {}">(line, name, value) || name < 'A' || name > 'C')
+		{
+			throw std::runtime_error("Invalid register");
+		}
+		return value;
 	}
 
 	Computer read_computer(std::istream& input)
@@ -233,6 +237,6 @@ SOLVE
 	const std::vector<U8> program = read_program(std::cin);
 	computer.program = program;
 
-	std::cout << part_one(computer) << '\n';
-	std::cout << part_two(computer) << '\n';
+	aoc::answer(1, part_one(computer));
+	aoc::answer(2, part_two(computer));
 }
\ No newline at end of file
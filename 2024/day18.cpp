@@ -1,10 +1,16 @@
 #include "aoc.h"
+#include "aoc/grid.h"
+#include "aoc/grid_search.h"
+#include "aoc/scan.h"
 #include "aoc/vector.h"
 
+#include <algorithm>
+#include <array>
+#include <format>
 #include <iostream>
-#include <queue>
-#include <regex>
+#include <limits>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -12,20 +18,32 @@ using aoc::Vector2;
 
 namespace
 {
-	using Grid = std::vector<U8>;
+	using Grid = aoc::Grid<S64>;
+	constexpr S64 never_corrupted = std::numeric_limits<S64>::max();
+
+	struct Memory_space
+	{
+		S64 width = 71;
+		S64 height = 71;
+		// The number of bytes that have fallen in part one
+		S64 num_points = 1024;
+
+		[[nodiscard]] Vector2 end() const
+		{
+			return { .x = width - 1, .y = height - 1 };
+		}
+	};
 
-	constexpr S64 width = 71;
-	constexpr S64 height = 71;
-	constexpr S64 num_points = 1024;
 	constexpr Vector2 start = { .x = 0, .y = 0 };
-	constexpr Vector2 end = { .x = width - 1, .y = height - 1 };
 
 	Vector2 parse_point(const std::string& line)
 	{
-		static const std::regex regex(R"((\d+),(\d+))");
-		std::smatch match;
-		std::regex_match(line, match, regex);
-		return { std::stoll(match[1]), std::stoll(match[2]) };
+		Vector2 point;
+		if (!aoc::scan<"{},{}">(line, point.x, point.y))
+		{
+			throw std::runtime_error("Invalid point");
+		}
+		return point;
 	}
 
 	std::vector<Vector2> read_input(std::istream& input)
@@ -39,73 +57,43 @@ namespace
 		return points;
 	}
 
-	Grid make_grid(const std::span<const Vector2> points)
+	/*
+	 * Each cell holds the number of bytes that have fallen before it is corrupted, a cell is open while fewer bytes
+	 * than that have fallen
+	 */
+	Grid make_grid(const Memory_space& space, const std::span<const Vector2> points)
 	{
-		Grid grid(width * height, 0);
-		for (const Vector2& point : points)
+		Grid grid = Grid::with_border(space.width, space.height, never_corrupted, -1);
+		for (S64 i = std::ssize(points) - 1; i >= 0; --i)
 		{
-			const S64 index = point.y * width + point.x;
-			grid[index] = 1;
+			grid[points[i]] = i;
 		}
 		return grid;
 	}
 
-	S64 to_index(const Vector2& point)
+	S64 shortest_path(aoc::Grid_search& search, const Memory_space& space, const Grid& grid, const S64 fallen)
 	{
-		return point.y * width + point.x;
+		const std::array<S64, 1> sources = { grid.index(start) };
+		const S64 end = grid.index(space.end());
+		const auto can_move = [&](S64, const S64 to) { return grid[to] >= fallen; };
+		return search.run(sources, can_move, [&](const S64 index) { return index == end; });
 	}
 
-	bool is_valid(const Vector2& point)
+	S64 part_one(aoc::Grid_search& search, const Memory_space& space, const Grid& grid)
 	{
-		return point.x >= 0 && point.x < width && point.y >= 0 && point.y < height;
+		return shortest_path(search, space, grid, space.num_points);
 	}
 
-	S64 shortest_path(const Grid& grid)
-	{
-		std::vector<S64> distances(std::ssize(grid), 0);
-		S64 index = to_index(start);
-		distances[index] = 0;
-		std::queue<Vector2> queue;
-		queue.push(start);
-
-		const Vector2 directions[] = { Vector2::east, Vector2::south, Vector2::west, Vector2::north };
-		while (!queue.empty())
-		{
-			const Vector2 p = queue.front();
-			queue.pop();
-			if (p == end)
-			{
-				break;
-			}
-
-			index = to_index(p);
-			for (const Vector2 direction : directions)
-			{
-				const Vector2 next = p + direction;
-				const S64 next_index = to_index(next);
-				if (is_valid(next) && grid[next_index] != 1 && !distances[next_index])
-				{
-					distances[next_index] = distances[index] + 1;
-					queue.push(next);
-				}
-			}
-		}
-
-		return distances[to_index(end)];
-	}
-
-	S64 part_one(const std::vector<Vector2>& points)
-	{
-		const Grid grid = make_grid(std::span{ points.data(), num_points });
-		return shortest_path(grid);
-	}
-
-	Vector2 part_two(const std::vector<Vector2>& points)
+	Vector2 part_two(aoc::Grid_search& search, const Memory_space& space, const Grid& grid,
+		const std::vector<Vector2>& points)
 	{
+		const S64 start_index = grid.index(start);
+		const S64 end_index = grid.index(space.end());
 		const auto f = std::ranges::partition_point(points, [&](const Vector2& point)
 			{
-				const Grid grid = make_grid(std::span{ points.data(), &point + 1 });
-				return shortest_path(grid) != 0;
+				const S64 fallen = &point - points.data() + 1;
+				return search.bidirectional(start_index, end_index,
+					[&](S64, const S64 to) { return grid[to] >= fallen; }) != aoc::Grid_search::unreachable;
 			});
 		if (f == std::end(points)) return {};
 		return *f;
@@ -114,8 +102,21 @@ namespace
 
 SOLVE
 {
+	// The puzzle's sizes are the defaults, the width, height and number of bytes for part one can be passed after the
+	// driver's options
+	Memory_space space;
+	if (argc > 3)
+	{
+		space.width = std::stoll(argv[1]);
+		space.height = std::stoll(argv[2]);
+		space.num_points = std::stoll(argv[3]);
+	}
+
 	const std::vector<Vector2> points = read_input(std::cin);
-	std::cout << part_one(points) << '\n';
-	const auto [x, y] = part_two(points);
-	std::cout << x << ',' << y << '\n';
+	const Grid grid = make_grid(space, points);
+	// The search is reused by every probe of part two
+	aoc::Grid_search search(grid.size(), grid.neighbour_offsets_4());
+	aoc::answer(1, part_one(search, space, grid));
+	const auto [x, y] = part_two(search, space, grid, points);
+	aoc::answer(2, std::format("{},{}", x, y));
 }
\ No newline at end of file
@@ -3,40 +3,46 @@
 #include "aoc/string_helpers.h"
 
 #include <algorithm>
-#include <iostream>
 #include <span>
-#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace
 {
-	std::vector<std::string> read_towels(std::istream& in)
+	// Views into the designs of one input, so it mustn't outlive them
+	using Combination_cache = std::unordered_map<std::string_view, S64>;
+
+	// Views into the input text
+	struct Onsen
 	{
-		std::string line;
-		std::getline(in, line);
-		const std::vector<std::string_view> parts = aoc::split(line, ", ");
-		std::vector<std::string> towels;
-		towels.reserve(parts.size());
-		std::transform(parts.begin(), parts.end(), std::back_inserter(towels), [](const std::string_view part)
-			{ return std::string(part.begin(), part.end()); });
-		return towels;
-	}
+		std::vector<std::string_view> towels;
+		std::vector<std::string_view> designs;
+		// Shared by both parts of a solve, part two only has to look up the designs part one counted
+		mutable Combination_cache cache;
+	};
 
-	std::vector<std::string> read_designs(std::istream& in)
+	Onsen read_input(const aoc::Input& input)
 	{
-		std::vector<std::string> designs;
-		for (std::string line; std::getline(in, line);)
+		Onsen onsen;
+		if (input.line_count() == 0)
 		{
-			if (line.empty()) continue;
-			designs.push_back(line);
+			return onsen;
 		}
-		return designs;
+		onsen.towels = aoc::split(input.line(0), ", ");
+		for (std::size_t i = 1; i < input.line_count(); ++i)
+		{
+			if (const std::string_view line = input.line(i); !line.empty())
+			{
+				onsen.designs.push_back(line);
+			}
+		}
+		return onsen;
 	}
 
-	S64 count_combinations(const std::string_view design, const std::span<const std::string> towels)
+	S64 count_combinations(const std::string_view design, const std::span<const std::string_view> towels,
+		Combination_cache& cache)
 	{
-		static std::unordered_map<std::string_view, S64> cache;
 		if (cache.contains(design))
 		{
 			return cache[design];
@@ -48,32 +54,32 @@ namespace
 			return value += 1;
 		}
 
-		for (const std::string& towel : towels)
+		for (const std::string_view towel : towels)
 		{
 			if (design.starts_with(towel))
 			{
-				value += count_combinations(design.substr(towel.size()), towels);
+				value += count_combinations(design.substr(towel.size()), towels, cache);
 			}
 		}
 		return value;
 	}
-}
 
-SOLVE
-{
-	const std::vector<std::string> towels = read_towels(std::cin);
-	const std::vector<std::string> designs = read_designs(std::cin);
-
-	S64 part_one = 0;
-	S64 part_two = 0;
+	S64 part_one(const Onsen& onsen)
+	{
+		return std::ranges::count_if(onsen.designs, [&](const std::string_view design)
+			{ return count_combinations(design, onsen.towels, onsen.cache) != 0; });
+	}
 
-	for (const std::string& design : designs)
+	S64 part_two(const Onsen& onsen)
 	{
-		const S64 combinations = count_combinations(design, towels);
-		if (combinations) ++part_one;
-		part_two += combinations;
+		S64 result = 0;
+		for (const std::string_view design : onsen.designs)
+		{
+			result += count_combinations(design, onsen.towels, onsen.cache);
+		}
+		return result;
 	}
+}
 
-	std::cout << part_one << '\n';
-	std::cout << part_two << '\n';
-}
\ No newline at end of file
+// The parts share the cache, so they run one after the other
+SOLVE_PHASES(read_input, part_one, part_two)
\ No newline at end of file
@@ -1,68 +1,39 @@
 #include "aoc.h"
+#include "aoc/grid.h"
+#include "aoc/grid_search.h"
 #include "aoc/vector.h"
 
 #include <array>
 #include <iostream>
-#include <string>
-#include <unordered_map>
 #include <vector>
 
 using aoc::Vector2;
 
 namespace
 {
-	using Grid = std::vector<std::string>;
+	using Grid = aoc::Grid<char>;
 
 	Grid read_input(std::istream& is)
 	{
-		Grid grid;
-		for (std::string line; std::getline(is, line);)
-		{
-			grid.push_back(line);
-		}
-		return grid;
-	}
-
-	Vector2 find_position(const Grid& grid, const char ch)
-	{
-		for (S64 y = 0; y < std::ssize(grid); ++y)
-		{
-			for (S64 x = 0; x < std::ssize(grid); ++x)
-			{
-				if (grid[y][x] == ch)
-				{
-					return { x, y };
-				}
-			}
-		}
-		return { -1, -1 };
+		return aoc::read_grid(is, '#');
 	}
 
-	bool is_empty(const Grid& grid, const Vector2& position)
+	/*
+	 * The racetrack is a single path, so the cells the search reaches before the end are the path in order of their
+	 * distance from the start
+	 */
+	std::vector<Vector2> get_shortest_path(const Grid& grid, const S64 start, const S64 end)
 	{
-		if (position.x < 0 || position.x >= std::ssize(grid[0]) || position.y < 0 || position.y >= std::ssize(grid))
+		aoc::Grid_search search(grid.size(), grid.neighbour_offsets_4());
+		const std::array<S64, 1> sources = { start };
+		const S64 length = search.run(
+			sources, [&](S64, const S64 to) { return grid[to] != '#'; }, [&](const S64 index) { return index == end; });
+		std::vector<Vector2> path(static_cast<std::size_t>(length + 1));
+		for (S64 index = 0; index < grid.size(); ++index)
 		{
-			return false;
-		}
-		return grid[position.y][position.x] != '#';
-	}
-
-	std::vector<Vector2> get_shortest_path(const Grid& grid, const Vector2& start, const Vector2& end)
-	{
-		std::vector path = { start };
-		while (true)
-		{
-			Vector2 current = path.back();
-			if (current == end) break;
-			const std::array directions = { Vector2::east, Vector2::south, Vector2::west, Vector2::north };
-			for (const Vector2 direction : directions)
+			if (const S64 distance = search.distance(index); distance != aoc::Grid_search::unreachable)
 			{
-				const Vector2 target = current + direction;
-				if (is_empty(grid, target) && (path.size() < 2 || target != path[path.size() - 2]))
-				{
-					path.push_back(target);
-					break;
-				}
+				path[distance] = grid.position(index);
 			}
 		}
 		return path;
@@ -99,10 +70,10 @@ namespace
 SOLVE
 {
 	const Grid grid = read_input(std::cin);
-	const Vector2 start = find_position(grid, 'S');
-	const Vector2 end = find_position(grid, 'E');
+	const S64 start = grid.find('S').value();
+	const S64 end = grid.find('E').value();
 	const std::vector<Vector2> path = get_shortest_path(grid, start, end);
 
-	std::cout << part_one(path) << '\n';
-	std::cout << part_two(path) << '\n';
+	aoc::answer(1, part_one(path));
+	aoc::answer(2, part_two(path));
 }
\ No newline at end of file
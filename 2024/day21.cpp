@@ -2,23 +2,19 @@
 #include "aoc/vector.h"
 
 #include <array>
-#include <iostream>
 #include <map>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 
 namespace
 {
-	std::vector<std::string> read_input(std::istream& input)
+	// Views into the input text
+	std::vector<std::string_view> read_input(const aoc::Input& input)
 	{
-		std::vector<std::string> result;
-		for (std::string line; std::getline(input, line);)
-		{
-			result.push_back(std::move(line));
-		}
-		return result;
+		return input.lines();
 	}
 
 	S64 get_numeric_part(const std::string_view code)
@@ -37,11 +33,11 @@ namespace
 		return numeric_code;
 	}
 
-	std::array<std::array<std::vector<std::string>, 11>, 11>& get_possible_paths()
+	using Possible_paths = std::array<std::array<std::vector<std::string>, 11>, 11>;
+
+	Possible_paths make_possible_paths()
 	{
-		static bool initialized = false;
-		static std::array<std::array<std::vector<std::string>, 11>, 11> possible_paths;
-		if (initialized) return possible_paths;
+		Possible_paths possible_paths;
 		possible_paths[0][0] = { "" };
 		possible_paths[0][1] = { "^<" };
 		possible_paths[0][2] = { "^" };
@@ -163,10 +159,16 @@ namespace
 		possible_paths[10][8] = { "^^^<", "<^^^" };
 		possible_paths[10][9] = { "^^^" };
 		possible_paths[10][10] = { "" };
-		initialized = true;
 		return possible_paths;
 	}
 
+	const Possible_paths& get_possible_paths()
+	{
+		// Built once even if several inputs are solved at the same time
+		static const Possible_paths s_possible_paths = make_possible_paths();
+		return s_possible_paths;
+	}
+
 	std::span<const std::string> get_possible_paths(const S64 source, const S64 destination)
 	{
 		return get_possible_paths()[source][destination];
@@ -199,11 +201,11 @@ namespace
 		}
 	}
 
-	const std::array<std::array<std::vector<std::string_view>, 5>, 5>& get_move_map()
+	using Move_map = std::array<std::array<std::vector<std::string_view>, 5>, 5>;
+
+	Move_map make_move_map()
 	{
-		static bool initialized = false;
-		static std::array<std::array<std::vector<std::string_view>, 5>, 5> result;
-		if (initialized) return result;
+		Move_map result;
 		/* A -> A */ result[0][0] = { "A" };
 		/* A -> v */ result[0][1] = { "<vA", "v<A" };
 		/* A -> ^ */ result[0][2] = { "<A" };
@@ -229,21 +231,27 @@ namespace
 		/* > -> ^ */ result[4][2] = { "<^A", "^<A" };
 		/* > -> < */ result[4][3] = { "<<A" };
 		/* > -> > */ result[4][4] = { "A" };
-		initialized = true;
 		return result;
 	}
 
+	const Move_map& get_move_map()
+	{
+		static const Move_map s_move_map = make_move_map();
+		return s_move_map;
+	}
+
 	std::vector<std::string_view> get(const char current, const char expected)
 	{
 		return get_move_map()[from_position(current)][from_position(expected)];
 	}
 
-	std::map<std::tuple<char, char, S64>, S64> s_cache;
+	// The cost of pressing a key on the keypad at some depth, owned by each solve so they can run at the same time
+	using Cost_cache = std::map<std::tuple<char, char, S64>, S64>;
 
-	S64 cost_of_moving(const char current, const char expected, const S64 depth)
+	S64 cost_of_moving(const char current, const char expected, const S64 depth, Cost_cache& cache)
 	{
 		const auto key = std::make_tuple(current, expected, depth);
-		if (const auto it = s_cache.find(key); it != s_cache.end())
+		if (const auto it = cache.find(key); it != cache.end())
 		{
 			return it->second;
 		}
@@ -254,26 +262,26 @@ namespace
 		// @note: Shouldn't assume the first path is the shortest, though it works for my input!
 		for (const char ch : paths.front())
 		{
-			result += cost_of_moving(this_char, ch, depth - 1);
+			result += cost_of_moving(this_char, ch, depth - 1, cache);
 			this_char = ch;
 		}
-		s_cache.emplace(key, result);
+		cache.emplace(key, result);
 		return result;
 	}
 
-	S64 cost_of_moving(const std::string_view moves, const S64 depth)
+	S64 cost_of_moving(const std::string_view moves, const S64 depth, Cost_cache& cache)
 	{
 		S64 result = 0;
 		char current = 'A';
 		for (const char ch : moves)
 		{
-			result += cost_of_moving(current, ch, depth);
+			result += cost_of_moving(current, ch, depth, cache);
 			current = ch;
 		}
 		return result;
 	}
 
-	S64 get_shortest_path(const std::string_view code, const S64 depth)
+	S64 get_shortest_path(const std::string_view code, const S64 depth, Cost_cache& cache)
 	{
 		std::vector<S64> lengths = { 0 };
 		char current = 'A';
@@ -286,7 +294,7 @@ namespace
 				assert(!paths.empty());
 				for (const std::string& path : paths)
 				{
-					new_lengths.emplace_back(length + cost_of_moving(path + "A", depth));
+					new_lengths.emplace_back(length + cost_of_moving(path + "A", depth, cache));
 				}
 			}
 			current = ch;
@@ -296,23 +304,24 @@ namespace
 		return std::ranges::min(lengths);
 	}
 
-	S64 solve(const std::vector<std::string>& codes, const S64 depth)
+	S64 solve(const std::span<const std::string_view> codes, const S64 depth)
 	{
+		Cost_cache cache;
 		S64 sum = 0;
-		for (const std::string& code : codes)
+		for (const std::string_view code : codes)
 		{
-			const S64 length = get_shortest_path(code, depth);
+			const S64 length = get_shortest_path(code, depth, cache);
 			sum += calculate_complexity(code, length);
 		}
 		return sum;
 	}
 
-	S64 part_one(const std::vector<std::string>& codes)
+	S64 part_one(const std::vector<std::string_view>& codes)
 	{
 		return solve(codes, 2);
 	}
 
-	S64 part_two(const std::vector<std::string>& codes)
+	S64 part_two(const std::vector<std::string_view>& codes)
 	{
 		return solve(codes, 25);
 	}
@@ -320,22 +329,17 @@ namespace
 
 TEST_CASE("2024 21 1", "[2024][21][1]")
 {
-	REQUIRE(cost_of_moving('A', '<', 2) == 10);
-	REQUIRE(cost_of_moving('<', 'A', 2) == 8);
+	Cost_cache cache;
+	REQUIRE(cost_of_moving('A', '<', 2, cache) == 10);
+	REQUIRE(cost_of_moving('<', 'A', 2, cache) == 8);
 
-	REQUIRE(get_shortest_path("029A", 2) == 68);
-	REQUIRE(get_shortest_path("980A", 2) == 60);
-	REQUIRE(get_shortest_path("179A", 2) == 68);
-	REQUIRE(get_shortest_path("456A", 2) == 64);
-	REQUIRE(get_shortest_path("379A", 2) == 64);
+	REQUIRE(get_shortest_path("029A", 2, cache) == 68);
+	REQUIRE(get_shortest_path("980A", 2, cache) == 60);
+	REQUIRE(get_shortest_path("179A", 2, cache) == 68);
+	REQUIRE(get_shortest_path("456A", 2, cache) == 64);
+	REQUIRE(get_shortest_path("379A", 2, cache) == 64);
 
 	REQUIRE(part_one({ "029A", "980A", "179A", "456A", "379A" }) == 126384);
 }
 
-SOLVE
-{
-	const std::vector<std::string> codes = read_input(std::cin);
-
-	std::cout << part_one(codes) << '\n';
-	std::cout << part_two(codes) << '\n';
-}
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
@@ -110,6 +110,6 @@ SOLVE
 {
 	const std::vector<U64> initial_secret_numbers = read_input(std::cin);
 
-	std::cout << part_one(initial_secret_numbers) << '\n';
-	std::cout << part_two(initial_secret_numbers) << '\n';
+	aoc::answer(1, part_one(initial_secret_numbers));
+	aoc::answer(2, part_two(initial_secret_numbers));
 }
\ No newline at end of file
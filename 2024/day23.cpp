@@ -127,6 +127,6 @@ SOLVE
 {
 	const std::vector<std::pair<std::string, std::string>> input = read_input(std::cin);
 	const Adjacency_matrix matrix = adjacency_matrix(input);
-	std::cout << part_one(matrix) << '\n';
-	std::cout << part_two(matrix) << '\n';
+	aoc::answer(1, part_one(matrix));
+	aoc::answer(2, part_two(matrix));
 }
\ No newline at end of file
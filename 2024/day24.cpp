@@ -3,13 +3,15 @@
 #include <format>
 #include <iostream>
 #include <ranges>
-#include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include "aoc/core.h"
+#include "aoc/scan.h"
 
 namespace
 {
@@ -19,13 +21,13 @@ namespace
 		for (std::string line; std::getline(input, line);)
 		{
 			if (line.empty()) break;
-			const std::regex re(R"((\w+): ([01]))");
-			std::smatch match;
-			if (!std::regex_match(line, match, re))
+			std::string wire;
+			U64 value = 0;
+			if (!aoc::scan<"{}: {}">(line, wire, value) || value > 1)
 			{
 				throw std::invalid_argument("Invalid input");
 			}
-			result[match[1]] = match[2] == "1" ? 1 : 0;
+			result[std::move(wire)] = value;
 		}
 		return result;
 	}
@@ -49,13 +51,18 @@ namespace
 		std::unordered_map<std::string, Connection> result;
 		for (std::string line; std::getline(input, line);)
 		{
-			const std::regex re(R"((\w+) (AND|OR|XOR) (\w+) -> (\w+))");
-			std::smatch match;
-			if (!std::regex_match(line, match, re))
+			Connection connection;
+			std::string_view gate;
+			std::string output;
+			if (!aoc::scan<"{} {} {} -> {}">(line, connection.lhs, gate, connection.rhs, output))
 			{
 				throw std::invalid_argument("Invalid input");
 			}
-			result[match[4]] = { match[1], match[3], match[2] == "AND" ? Gate::AND : match[2] == "OR" ? Gate::OR : Gate::XOR };
+			if (gate == "AND") connection.gate = Gate::AND;
+			else if (gate == "OR") connection.gate = Gate::OR;
+			else if (gate == "XOR") connection.gate = Gate::XOR;
+			else throw std::invalid_argument("Invalid gate");
+			result[std::move(output)] = std::move(connection);
 		}
 		return result;
 	}
@@ -95,11 +102,10 @@ namespace
 		U64 result = 0;
 		for (const std::string& key : std::ranges::views::keys(connections))
 		{
-			const std::regex re(std::format("{}(\\d+)", letter));
-			std::smatch match;
-			if (std::regex_match(key, match, re))
+			char wire_letter = 0;
+			U64 index = 0;
+			if (aoc::scan<"{}{}">(key, wire_letter, index) && wire_letter == letter)
 			{
-				const U64 index = std::stoull(match[1]);
 				result |= get_value(key, values, connections) << index;
 			}
 		}
@@ -197,6 +203,6 @@ SOLVE
 	const std::unordered_map<std::string, U64> initial_values = read_initial_values(std::cin);
 	const std::unordered_map<std::string, Connection> connections = read_connections(std::cin);
 
-	std::cout << part_one(initial_values, connections) << '\n';
-	std::cout << part_two(initial_values, connections) << '\n';
+	aoc::answer(1, part_one(initial_values, connections));
+	aoc::answer(2, part_two(initial_values, connections));
 }
\ No newline at end of file
@@ -109,5 +109,5 @@ namespace
 SOLVE
 {
 	const auto schematics = read_input(std::cin);
-	std::cout << part_one(schematics) << '\n';
+	aoc::answer(1, part_one(schematics));
 }
\ No newline at end of file
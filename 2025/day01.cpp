@@ -91,6 +91,6 @@ TEST_CASE("2025 Day 01 Part One")
 SOLVE
 {
     const std::vector<Rotation> rotations = read_input(std::cin);
-    std::cout << part_one(rotations) << '\n';
-    std::cout << part_two(rotations) << '\n';
+    aoc::answer(1, part_one(rotations));
+    aoc::answer(2, part_two(rotations));
 }
\ No newline at end of file
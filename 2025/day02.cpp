@@ -122,6 +122,6 @@ TEST_CASE("2025 Day 02 Part One")
 SOLVE
 {
     const Input input = read_input(std::cin);
-    std::cout << part_one(input) << '\n';
-    std::cout << part_two(input) << '\n';
+    aoc::answer(1, part_one(input));
+    aoc::answer(2, part_two(input));
 }
@@ -85,6 +85,6 @@ TEST_CASE("2025 Day 03 Part Two")
 SOLVE
 {
     const std::vector<std::string> banks = read_input(std::cin);
-    std::cout << part_one(banks) << '\n';
-    std::cout << part_two(banks) << '\n';
+    aoc::answer(1, part_one(banks));
+    aoc::answer(2, part_two(banks));
 }
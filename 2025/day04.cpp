@@ -1,82 +1,35 @@
 #include "aoc.h"
-#include "aoc/vector.h"
+#include "aoc/bit_grid.h"
+#include "aoc/grid.h"
 
 namespace
 {
-using Grid = std::vector<std::string>;
+using Grid = aoc::Bit_grid;
 Grid read_input(std::istream &is)
 {
-    Grid grid;
-    for (std::string line; std::getline(is, line);)
-    {
-        grid.push_back(line);
-    }
-    return grid;
-}
-
-std::span<aoc::Vector2> get_neighbours(std::span<aoc::Vector2, 8> buffer, const aoc::Vector2 position, const Grid &grid)
-{
-    auto iter = buffer.begin();
-    for (S64 d_y = -1; d_y <= 1; ++d_y)
-    {
-        for (S64 d_x = -1; d_x <= 1; ++d_x)
-        {
-            const aoc::Vector2 neighbour{position.x + d_x, position.y + d_y};
-            if (neighbour == position)
-            {
-                continue;
-            }
-
-            if (neighbour.y >= 0 && neighbour.y < std::ssize(grid) && neighbour.x >= 0 &&
-                neighbour.x < std::ssize(grid[neighbour.y]))
-            {
-                *iter++ = neighbour;
-            }
-        }
-    }
-    return {buffer.begin(), iter};
+    return aoc::Bit_grid::from_grid(aoc::read_grid(is), [](const char ch) { return ch == '@'; });
 }
 
-bool is_accessible(const aoc::Vector2 position, const Grid &grid)
+// The rolls with fewer than four rolls around them
+Grid get_accessible_rolls(const Grid &rolls)
 {
-    std::array<aoc::Vector2, 8> buffer;
-    S64 rolls_found = 0;
-    for (const aoc::Vector2 neighbour : get_neighbours(buffer, position, grid))
+    Grid accessible(rolls.width(), rolls.height());
+    const auto words = static_cast<std::size_t>(rolls.words_per_row());
+    for (S64 y = 0; y < rolls.height(); ++y)
     {
-        if (grid[neighbour.y][neighbour.x] == '@')
+        const std::span<const U64> row = rolls.row(y);
+        const std::span<U64> accessible_row = accessible.row(y);
+        for (std::size_t i = 0; i < words; ++i)
         {
-            ++rolls_found;
-            if (rolls_found >= 4)
-            {
-                return false;
-            }
+            accessible_row[i] = row[i] & ~aoc::count_neighbours(rolls, y, i).at_least(4);
         }
     }
-
-    return true;
-}
-
-std::vector<aoc::Vector2> get_accessible_positions(const Grid &grid)
-{
-    std::vector<aoc::Vector2> positions;
-    for (S64 y = 0; y < std::ssize(grid); ++y)
-    {
-        for (S64 x = 0; x < std::ssize(grid[y]); ++x)
-        {
-            const aoc::Vector2 position{x, y};
-            if (grid[y][x] == '@' && is_accessible(position, grid))
-            {
-                positions.push_back(position);
-            }
-        }
-    }
-    return positions;
+    return accessible;
 }
 
 S64 part_one(const Grid &grid)
 {
-    const std::vector<aoc::Vector2> positions = get_accessible_positions(grid);
-    return std::ssize(positions);
+    return get_accessible_rolls(grid).count();
 }
 
 S64 part_two(Grid grid)
@@ -84,16 +37,13 @@ S64 part_two(Grid grid)
     S64 count = 0;
     while (true)
     {
-        const std::vector<aoc::Vector2> positions = get_accessible_positions(grid);
-        if (positions.empty())
+        const Grid accessible = get_accessible_rolls(grid);
+        if (!accessible.any())
         {
             break;
         }
-        count += std::ssize(positions);
-        for (const aoc::Vector2 position : positions)
-        {
-            grid[position.y][position.x] = '.';
-        }
+        count += accessible.count();
+        grid.and_not(accessible);
     }
     return count;
 }
@@ -106,6 +56,6 @@ TEST_CASE("2025 Day 4 Part One", "[2025][Day04][PartOne]")
 SOLVE
 {
     const Grid grid = read_input(std::cin);
-    std::cout << part_one(grid) << '\n';
-    std::cout << part_two(grid) << '\n';
+    aoc::answer(1, part_one(grid));
+    aoc::answer(2, part_two(grid));
 }
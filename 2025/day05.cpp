@@ -142,8 +142,8 @@ TEST_CASE("2025 Day 5 Part One", "[2025][Day05][PartOne]")
 SOLVE
 {
     const Database database = read_input(std::cin);
-    std::cout << part_one(database) << '\n';
-    std::cout << part_two(database) << '\n';
+    aoc::answer(1, part_one(database));
+    aoc::answer(2, part_two(database));
     //       359,913,027,576,323 too high
     // 9,223,372,036,854,775,807
 }
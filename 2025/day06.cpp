@@ -1,40 +1,40 @@
 #include "aoc.h"
 #include "aoc/algorithm.h"
+#include "aoc/string_helpers.h"
 #include <numeric>
 
 namespace
 {
 struct Input
 {
-    std::vector<std::vector<std::string>> grid;
+    std::vector<std::vector<std::string_view>> grid;
     std::vector<char> operations;
 };
 
-std::vector<std::string> read_input(std::istream &is)
+std::vector<std::string_view> read_input(const aoc::Input &input)
 {
-    std::vector<std::string> result;
-    for (std::string line; std::getline(is, line);)
-    {
-        result.push_back(line);
-    }
+    return input.lines();
+}
 
-    return result;
+// The columns are lined up with runs of spaces
+std::vector<std::string_view> split_words(const std::string_view line)
+{
+    std::vector<std::string_view> words = aoc::split(line, ' ');
+    std::erase_if(words, [](const std::string_view word) { return word.empty(); });
+    return words;
 }
 
-struct Input convert_input(const std::span<const std::string> lines)
+struct Input convert_input(const std::span<const std::string_view> lines)
 {
     Input input;
-    std::vector<std::vector<std::string>> &grid = input.grid;
+    std::vector<std::vector<std::string_view>> &grid = input.grid;
     for (S64 i = 0; i < std::ssize(lines) - 1; ++i)
     {
-        std::istringstream iss(lines[i]);
-        std::vector<std::string> row(std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>{});
-        grid.push_back(std::move(row));
+        grid.push_back(split_words(lines[i]));
     }
+    for (const std::string_view operation : split_words(lines.back()))
     {
-        std::istringstream iss(lines.back());
-        std::vector<char> operations(std::istream_iterator<char>(iss), std::istream_iterator<char>{});
-        input.operations = std::move(operations);
+        input.operations.push_back(operation.front());
     }
     return input;
 }
@@ -43,12 +43,12 @@ template <typename Op> S64 reduce(const Input &input, S64 column, Op op, S64 ini
 {
     for (S64 row = 0; row < std::ssize(input.grid); ++row)
     {
-        initial = op(initial, std::stoll(input.grid[row][column]));
+        initial = op(initial, aoc::convert_unguarded<S64>(input.grid[row][column]));
     }
     return initial;
 }
 
-S64 part_one(const std::span<const std::string> lines)
+S64 part_one(const std::span<const std::string_view> lines)
 {
     const Input input = convert_input(lines);
     S64 result = 0;
@@ -68,7 +68,7 @@ S64 part_one(const std::span<const std::string> lines)
     return result;
 }
 
-S64 part_two(const std::span<const std::string> lines)
+S64 part_two(const std::span<const std::string_view> lines)
 {
     if (lines.empty())
     {
@@ -77,7 +77,7 @@ S64 part_two(const std::span<const std::string> lines)
 
     S64 result = 0;
     S64 max_columns = std::ssize(lines.front());
-    for (const std::string &line : lines)
+    for (const std::string_view line : lines)
     {
         assert(std::ssize(line) == max_columns);
     }
@@ -120,9 +120,4 @@ TEST_CASE("2025 Day 6 Part One", "[2025][Day06][PartOne]")
 {
 }
 
-SOLVE
-{
-    const std::vector<std::string> input = read_input(std::cin);
-    std::cout << part_one(input) << '\n';
-    std::cout << part_two(input) << '\n';
-}
+SOLVE_INDEPENDENT_PHASES(read_input, part_one, part_two)
@@ -78,11 +78,11 @@ SOLVE
 {
     const Grid grid = read_input(std::cin);
     const Result result = evaluate(grid);
-    std::cout << result.splits << '\n';
+    aoc::answer(1, result.splits);
     S64 timelines = 0;
     for (const auto [_, timeline] : result.timelines)
     {
         timelines += timeline;
     }
-    std::cout << timelines << '\n';
+    aoc::answer(2, timelines);
 }
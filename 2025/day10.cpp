@@ -147,5 +147,5 @@ TEST_CASE("2025 Day 10 Part One")
 SOLVE
 {
     const std::vector<Machine> machines = read_input(std::cin);
-    std::cout << part_one(machines) << '\n';
+    aoc::answer(1, part_one(machines));
 }
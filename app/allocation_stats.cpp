@@ -0,0 +1,272 @@
+#include "allocation_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <new>
+
+#include <cstdlib>
+
+#include <malloc.h>
+
+namespace
+{
+struct Counters
+{
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> bytes;
+    std::atomic<std::uint64_t> live_bytes;
+    std::atomic<std::uint64_t> peak_bytes;
+    std::atomic<std::uint64_t> size_histogram[driver::allocation_buckets];
+};
+
+// Allocations can happen before main, so these have to be ready without running any constructors
+constinit Counters s_counters{};
+
+#if defined(AOC_ALLOCATION_STATS)
+constexpr auto relaxed = std::memory_order_relaxed;
+
+std::size_t get_bucket(const std::size_t size)
+{
+    return std::min<std::size_t>(std::bit_width(size), driver::allocation_buckets - 1);
+}
+
+/*
+ * The live bytes go by the size the allocator actually handed out, that is all we can find out when freeing
+ */
+void record_allocation(const std::size_t requested, const std::size_t usable)
+{
+    s_counters.count.fetch_add(1, relaxed);
+    s_counters.bytes.fetch_add(requested, relaxed);
+    s_counters.size_histogram[get_bucket(requested)].fetch_add(1, relaxed);
+    const std::uint64_t live = s_counters.live_bytes.fetch_add(usable, relaxed) + usable;
+    std::uint64_t peak = s_counters.peak_bytes.load(relaxed);
+    while (live > peak && !s_counters.peak_bytes.compare_exchange_weak(peak, live, relaxed))
+    {
+    }
+}
+
+void record_deallocation(const std::size_t usable)
+{
+    s_counters.live_bytes.fetch_sub(usable, relaxed);
+}
+
+std::size_t get_usable_size(void *const pointer, [[maybe_unused]] const std::size_t alignment)
+{
+#if defined(_WIN32)
+    return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_msize(pointer, alignment, 0) : _msize(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void *try_allocate(const std::size_t size, const std::size_t alignment)
+{
+#if defined(_WIN32)
+    return alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? _aligned_malloc(size, alignment) : std::malloc(size);
+#else
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        void *pointer = nullptr;
+        return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+    }
+    return std::malloc(size);
+#endif
+}
+
+void *allocate(const std::size_t size, const std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+{
+    // Zero sized allocations still have to return a unique pointer
+    const std::size_t allocation_size = std::max<std::size_t>(size, 1);
+    void *pointer = try_allocate(allocation_size, alignment);
+    while (!pointer)
+    {
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+        pointer = try_allocate(allocation_size, alignment);
+    }
+    record_allocation(size, get_usable_size(pointer, alignment));
+    return pointer;
+}
+
+void *allocate_nothrow(const std::size_t size, const std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept
+{
+    try
+    {
+        return allocate(size, alignment);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+void deallocate(void *const pointer, const std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+    record_deallocation(get_usable_size(pointer, alignment));
+#if defined(_WIN32)
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        _aligned_free(pointer);
+        return;
+    }
+#endif
+    std::free(pointer);
+}
+#endif
+} // namespace
+
+#if defined(AOC_ALLOCATION_STATS)
+void *operator new(const std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size);
+}
+
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size);
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate_nothrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *const pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *const pointer) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *const pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *const pointer, std::size_t) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *const pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete[](void *const pointer, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer);
+}
+
+void operator delete(void *const pointer, const std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *const pointer, const std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *const pointer, std::size_t, const std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *const pointer, std::size_t, const std::align_val_t alignment) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *const pointer, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *const pointer, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    deallocate(pointer, static_cast<std::size_t>(alignment));
+}
+#endif
+
+namespace driver
+{
+bool are_allocations_tracked()
+{
+#if defined(AOC_ALLOCATION_STATS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+Allocation_snapshot take_allocation_snapshot()
+{
+    Allocation_snapshot snapshot;
+    snapshot.count = s_counters.count.load(std::memory_order_relaxed);
+    snapshot.bytes = s_counters.bytes.load(std::memory_order_relaxed);
+    snapshot.live_bytes = s_counters.live_bytes.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < allocation_buckets; ++i)
+    {
+        snapshot.size_histogram[i] = s_counters.size_histogram[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void reset_allocation_peak()
+{
+    s_counters.peak_bytes.store(s_counters.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+Allocation_stats get_allocations_since(const Allocation_snapshot &start)
+{
+    const Allocation_snapshot now = take_allocation_snapshot();
+    const std::uint64_t peak = s_counters.peak_bytes.load(std::memory_order_relaxed);
+    Allocation_stats stats;
+    stats.count = now.count - start.count;
+    stats.bytes = now.bytes - start.bytes;
+    stats.peak_bytes = peak > start.live_bytes ? peak - start.live_bytes : 0;
+    for (std::size_t i = 0; i < allocation_buckets; ++i)
+    {
+        stats.size_histogram[i] = now.size_histogram[i] - start.size_histogram[i];
+    }
+    return stats;
+}
+} // namespace driver
@@ -0,0 +1,67 @@
+#ifndef AOC_ALLOCATION_STATS_H
+#define AOC_ALLOCATION_STATS_H
+
+/*
+ * Counts the allocations made through operator new when the driver is built with AOC_ALLOCATION_STATS. The replacement
+ * operators are defined in the driver, so they also see the allocations made by the solution modules and by the
+ * standard library on their behalf. On Windows every module has its own operators, so only the static build is counted.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace driver
+{
+inline constexpr std::size_t allocation_buckets = 32;
+
+struct Allocation_stats
+{
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+    // Most memory live at once, above what was already live at the start, as seen by the allocator
+    std::uint64_t peak_bytes = 0;
+    // Bucket i counts the allocations of 2^(i-1) to 2^i - 1 bytes, the last bucket also counts everything larger
+    std::array<std::uint64_t, allocation_buckets> size_histogram{};
+};
+
+/*
+ * The allocations of a single run of the solution, the phases are only filled in for solutions exporting them
+ */
+struct Allocation_profile
+{
+    Allocation_stats total;
+    Allocation_stats parse;
+    Allocation_stats part_one;
+    Allocation_stats part_two;
+    // The parts ran at the same time, so both are counted under part one
+    bool parts_combined = false;
+};
+
+struct Allocation_snapshot
+{
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t live_bytes = 0;
+    std::array<std::uint64_t, allocation_buckets> size_histogram{};
+};
+
+/*
+ * Whether the driver was built with the counting operator new
+ */
+bool are_allocations_tracked();
+
+Allocation_snapshot take_allocation_snapshot();
+
+/*
+ * Start measuring the peak again from what is live now
+ */
+void reset_allocation_peak();
+
+/*
+ * The allocations made since the snapshot was taken, the peak is measured from the last reset
+ */
+Allocation_stats get_allocations_since(const Allocation_snapshot &start);
+} // namespace driver
+
+#endif
@@ -3,25 +3,389 @@
 
 // Common includes for Advent of Code solutions
 #include "aoc/core.h"
+#include "aoc/input.h"
+#include "aoc_abi.h"
 
 #include <algorithm>
 #include <array>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <ostream>
 #include <span>
+#include <sstream>
+#include <streambuf>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include <cstdint>
+
 #include <catch2/catch_test_macros.hpp>
 
-#define SOLVE extern "C" void solve([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+#define AOC_CONCATENATE_IMPL(lhs, rhs) lhs##_##rhs
+#define AOC_CONCATENATE(lhs, rhs) AOC_CONCATENATE_IMPL(lhs, rhs)
+
+#if defined(AOC_STATIC_BUILD)
+// Every solution is linked into the same executable, so the entry points are prefixed with the year and day
+#define AOC_ENTRY_POINT(name) AOC_CONCATENATE(AOC_SOLUTION_ID, name)
+#else
+#define AOC_ENTRY_POINT(name) name
+#endif
+
+#define SOLVE                                                                                                          \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(set_stop_token)(const Aoc_stop_token *const token)                      \
+    {                                                                                                                  \
+        aoc::detail::stop_token = token ? *token : Aoc_stop_token{};                                                   \
+    }                                                                                                                  \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(set_tracer)(const Aoc_tracer *const tracer)                            \
+    {                                                                                                                  \
+        aoc::detail::tracer = tracer ? *tracer : Aoc_tracer{};                                                         \
+    }                                                                                                                  \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(set_logger)(const Aoc_logger *const logger)                            \
+    {                                                                                                                  \
+        aoc::detail::logger = logger ? *logger : Aoc_logger{};                                                         \
+    }                                                                                                                  \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(set_answer_sink)(const Aoc_answer_sink *const sink)                     \
+    {                                                                                                                  \
+        aoc::detail::answer_sink = sink ? *sink : Aoc_answer_sink{};                                                   \
+    }                                                                                                                  \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(solve)([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
+
+namespace aoc
+{
+namespace detail
+{
+// Shared by every solution in the static build, there's only one driver setting them
+inline Aoc_stop_token stop_token{};
+inline Aoc_tracer tracer{};
+inline Aoc_logger logger{};
+inline Aoc_answer_sink answer_sink{};
+
+// Longer log lines are cut short
+inline constexpr std::size_t max_log_length = 240;
+
+/*
+ * Collects a log line in place so logging doesn't allocate, once it is full the rest of the line is thrown away
+ */
+class Log_buffer : public std::streambuf
+{
+private:
+    char m_text[max_log_length];
+
+public:
+    Log_buffer()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        setp(m_text, m_text + max_log_length);
+    }
+
+    [[nodiscard]] const char *data() const
+    {
+        return pbase();
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return static_cast<std::size_t>(pptr() - pbase());
+    }
+};
+
+/*
+ * The log line being written on this thread, formatting it is the only part of logging done by the solution, the
+ * driver writes it out on its own thread
+ */
+class Log_line
+{
+private:
+    Log_buffer m_buffer;
+    std::ostream m_stream{&m_buffer};
+
+public:
+    std::ostream &begin()
+    {
+        m_buffer.reset();
+        m_stream.clear();
+        return m_stream;
+    }
+
+    void send() const
+    {
+        logger.log(logger.context, m_buffer.data(), m_buffer.size());
+    }
+};
+
+inline Log_line &get_log_line()
+{
+    thread_local Log_line line;
+    return line;
+}
+
+template <typename T> void report_answer(const Aoc_answer_sink *const sink, const int part, const T &answer)
+{
+    std::ostringstream stream;
+    stream << answer;
+    const std::string text = std::move(stream).str();
+    sink->report(sink->context, part, text.data(), text.size());
+}
+} // namespace detail
+
+/*
+ * Whether the driver wants the solution to stop, e.g. because it ran out of time. Long searches should check this every
+ * so often and return early, the answers of a stopped solution are ignored.
+ */
+inline bool stop_requested()
+{
+    return detail::stop_token.stop_requested && detail::stop_token.stop_requested(detail::stop_token.context) != 0;
+}
+
+/*
+ * Whether the driver is running with --verbose, AOC_LOG skips formatting the message when it isn't
+ */
+inline bool is_logging()
+{
+    return detail::logger.log != nullptr;
+}
+
+/*
+ * Whether the driver is collecting trace events, everything else about tracing is skipped when it isn't
+ */
+inline bool is_tracing()
+{
+    return detail::tracer.begin_scope != nullptr;
+}
+
+/*
+ * Records how long it is alive as a trace event, see AOC_TRACE_SCOPE
+ */
+class Trace_scope
+{
+private:
+    bool m_active;
+
+public:
+    explicit Trace_scope(const char *const name) : m_active(is_tracing())
+    {
+        if (m_active)
+        {
+            detail::tracer.begin_scope(detail::tracer.context, name);
+        }
+    }
+
+    Trace_scope(const Trace_scope &) = delete;
+    Trace_scope &operator=(const Trace_scope &) = delete;
+
+    ~Trace_scope()
+    {
+        if (m_active)
+        {
+            detail::tracer.end_scope(detail::tracer.context);
+        }
+    }
+};
 
-#ifdef NDEBUG
-#define AOC_LOG(msg)                                                                                                       \
+inline void trace_counter(const char *const name, const std::int64_t value)
+{
+    if (is_tracing())
+    {
+        detail::tracer.counter(detail::tracer.context, name, value);
+    }
+}
+
+/*
+ * Give the answer to one of the parts, anything that can be written to a stream. The driver holds on to the answers
+ * and prints them once the solution has finished, so reporting one doesn't wait for the output. Older drivers get them
+ * printed on the standard output as before, without flushing it.
+ */
+template <typename T> void answer(const int part, const T &value)
+{
+    if (detail::answer_sink.report)
+    {
+        detail::report_answer(&detail::answer_sink, part, value);
+    }
+    else
+    {
+        std::cout << value << '\n';
+    }
+}
+} // namespace aoc
+
+namespace aoc::detail
+{
+inline aoc::Input to_input(const Aoc_input &input)
+{
+    return {{input.data, input.size}, {input.line_offsets, input.line_count}};
+}
+
+/*
+ * The whole of a stream read into memory, used when the driver doesn't pass the input to the solution itself
+ */
+struct Stream_input
+{
+    std::string text;
+    std::vector<std::size_t> line_offsets;
+
+    explicit Stream_input(std::istream &stream)
+        : text(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()),
+          line_offsets(aoc::index_lines(text))
+    {
+    }
+
+    [[nodiscard]] aoc::Input view() const
+    {
+        return {text, line_offsets};
+    }
+};
+
+/*
+ * Adapts a parse function and two part functions taking the parsed input to the phases interface, the parts can return
+ * anything that can be written to a stream. The parse function takes either a std::istream& or a const aoc::Input&, in
+ * the second case the result may refer to the input text.
+ */
+template <auto Parse, auto Part_one, auto Part_two, unsigned Flags> struct Phases_adapter
+{
+    static constexpr bool takes_input = std::is_invocable_v<decltype(Parse), const aoc::Input &>;
+
+    using Input = std::remove_cvref_t<
+        decltype(Parse(std::declval<std::conditional_t<takes_input, const aoc::Input &, std::istream &>>()))>;
+
+    struct Parsed
+    {
+        // Keeps the text alive when the input had to be read from the standard input
+        std::unique_ptr<Stream_input> source;
+        Input value;
+    };
+
+    static void *parse(int, char **)
+    {
+        if constexpr (takes_input)
+        {
+            auto source = std::make_unique<Stream_input>(std::cin);
+            const aoc::Input input = source->view();
+            return new Parsed{std::move(source), Parse(input)};
+        }
+        else
+        {
+            return new Parsed{nullptr, Parse(std::cin)};
+        }
+    }
+
+    static void *parse_input([[maybe_unused]] const Aoc_input *const input, int, char **)
+    {
+        if constexpr (takes_input)
+        {
+            return new Parsed{nullptr, Parse(to_input(*input))};
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    static void part_one(const void *const input, const Aoc_answer_sink *const sink)
+    {
+        report_answer(sink, 1, Part_one(static_cast<const Parsed *>(input)->value));
+    }
+
+    static void part_two(const void *const input, const Aoc_answer_sink *const sink)
+    {
+        report_answer(sink, 2, Part_two(static_cast<const Parsed *>(input)->value));
+    }
+
+    static void destroy(void *const input)
+    {
+        delete static_cast<Parsed *>(input);
+    }
+
+    static constexpr Aoc_phases phases{Flags, &parse, takes_input ? &parse_input : nullptr, &part_one, &part_two,
+                                       &destroy};
+};
+
+/*
+ * Run the phases one after the other, used for the plain solve entry point. The answers go to the driver's sink when
+ * it has set one and are printed otherwise.
+ */
+inline void run_phases(const Aoc_phases &phases, const int argc, char **const argv)
+{
+    const Aoc_answer_sink printer{nullptr, [](void *, int, const char *const answer, const std::size_t size) {
+                                      std::cout.write(answer, static_cast<std::streamsize>(size)) << '\n';
+                                  }};
+    const Aoc_answer_sink sink = answer_sink.report ? answer_sink : printer;
+    const std::unique_ptr<void, void (*)(void *)> input(phases.parse(argc, argv), phases.destroy);
+    phases.part_one(input.get(), &sink);
+    phases.part_two(input.get(), &sink);
+}
+} // namespace aoc::detail
+
+/*
+ * Define the solution in terms of a parse function and the two parts so the driver can time each of them, the parse
+ * function takes a std::istream& or a const aoc::Input& and the parts take the result of parsing
+ */
+#define SOLVE_PHASES_WITH_FLAGS(parse, part_one, part_two, flags)                                                      \
+    extern "C" AOC_EXPORT const Aoc_phases *AOC_ENTRY_POINT(phases)()                                                  \
+    {                                                                                                                  \
+        return &aoc::detail::Phases_adapter<parse, part_one, part_two, flags>::phases;                                 \
+    }                                                                                                                  \
+    SOLVE                                                                                                              \
+    {                                                                                                                  \
+        aoc::detail::run_phases(*AOC_ENTRY_POINT(phases)(), argc, argv);                                               \
+    }
+
+#define SOLVE_PHASES(parse, part_one, part_two) SOLVE_PHASES_WITH_FLAGS(parse, part_one, part_two, 0u)
+
+// The parts don't share any state besides reading the parsed input, so they can be run at the same time
+#define SOLVE_INDEPENDENT_PHASES(parse, part_one, part_two)                                                            \
+    SOLVE_PHASES_WITH_FLAGS(parse, part_one, part_two, AOC_PARTS_INDEPENDENT)
+
+/*
+ * Like SOLVE but the body gets the whole input as a const aoc::Input& named input instead of reading the standard
+ * input. The driver maps the input file so nothing is copied, older drivers go through solve which reads the standard
+ * input into memory first.
+ */
+#define SOLVE_INPUT                                                                                                    \
+    static void solve_input_body(const aoc::Input &input, int argc, char **argv);                                      \
+    extern "C" AOC_EXPORT void AOC_ENTRY_POINT(solve_input)(const Aoc_input *const input, int argc, char **argv)       \
+    {                                                                                                                  \
+        solve_input_body(aoc::detail::to_input(*input), argc, argv);                                                   \
+    }                                                                                                                  \
+    SOLVE                                                                                                              \
+    {                                                                                                                  \
+        const aoc::detail::Stream_input source(std::cin);                                                              \
+        solve_input_body(source.view(), argc, argv);                                                                   \
+    }                                                                                                                  \
+    static void solve_input_body([[maybe_unused]] const aoc::Input &input, [[maybe_unused]] int argc,                  \
+                                 [[maybe_unused]] char **argv)
+
+/*
+ * Trace the rest of the enclosing block when the driver runs with --trace, the name has to be a string literal. When
+ * tracing is off this only costs a branch.
+ */
+#define AOC_TRACE_SCOPE(name) const aoc::Trace_scope AOC_CONCATENATE(aoc_trace_scope, __LINE__)(name)
+
+/*
+ * Record the value of a counter in the trace, shown as a graph over time
+ */
+#define AOC_COUNTER(name, value) aoc::trace_counter(name, static_cast<std::int64_t>(value))
+
+/*
+ * Log a line when the driver runs with --verbose, e.g. AOC_LOG("Invalid ID: " << id). The line is handed to a
+ * background thread in the driver, so logging never waits for the output. When the driver falls behind lines are
+ * dropped and counted instead. When logging is off this only costs a branch, the message isn't even formatted.
+ */
+#define AOC_LOG(msg)                                                                                                   \
     do                                                                                                                 \
     {                                                                                                                  \
+        if (aoc::is_logging())                                                                                         \
+        {                                                                                                              \
+            aoc::detail::Log_line &aoc_log_line = aoc::detail::get_log_line();                                         \
+            aoc_log_line.begin() << msg;                                                                               \
+            aoc_log_line.send();                                                                                       \
+        }                                                                                                              \
     } while (0)
-#else
-#define AOC_LOG(msg) std::clog << msg << std::endl
-#endif
 
 #endif
@@ -0,0 +1,121 @@
+#ifndef AOC_AOC_ABI_H
+#define AOC_AOC_ABI_H
+
+/*
+ * The binary interface between the driver and the solution modules. Everything in here must stay usable from C so the
+ * driver can resolve the entry points by name.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+// Exported explicitly rather than listed at link time since some of the entry points are optional
+#define AOC_EXPORT __declspec(dllexport)
+#else
+// Symbols are hidden by default, so the entry points need to be made visible explicitly
+#define AOC_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C"
+{
+    using Aoc_solve_function = void (*)(int argc, char **argv);
+    using Aoc_test_function = int (*)(int argc, char **argv);
+
+    /*
+     * The whole input in memory along with the offset of the start of every line, the driver owns the memory and keeps
+     * it alive until the solution has finished
+     */
+    struct Aoc_input
+    {
+        const char *data;
+        std::size_t size;
+        const std::size_t *line_offsets;
+        std::size_t line_count;
+    };
+
+    /*
+     * Lets the driver ask a solution to give up early, e.g. when it has run out of time. Long searches poll it and
+     * return as soon as it is set, whatever they return is thrown away.
+     */
+    struct Aoc_stop_token
+    {
+        void *context;
+        int (*stop_requested)(void *context);
+    };
+
+    // Exported as "set_stop_token" by every module, the token is copied so it only has to outlive the run
+    using Aoc_set_stop_token_function = void (*)(const Aoc_stop_token *token);
+
+    /*
+     * Records trace events for the driver, the names have to outlive the run since only the pointers are kept, string
+     * literals are fine
+     */
+    struct Aoc_tracer
+    {
+        void *context;
+        void (*begin_scope)(void *context, const char *name);
+        void (*end_scope)(void *context);
+        void (*counter)(void *context, const char *name, std::int64_t value);
+    };
+
+    // Exported as "set_tracer" by every module, tracing is off until it is called and null turns it off again
+    using Aoc_set_tracer_function = void (*)(const Aoc_tracer *tracer);
+
+    /*
+     * Takes the finished log lines of the solution, without the line break. The driver copies the text before
+     * returning.
+     */
+    struct Aoc_logger
+    {
+        void *context;
+        void (*log)(void *context, const char *text, std::size_t size);
+    };
+
+    // Exported as "set_logger" by every module, AOC_LOG does nothing until it is called and null turns it off again
+    using Aoc_set_logger_function = void (*)(const Aoc_logger *logger);
+
+    // Exported as "solve_input" by the modules that would rather have the input handed to them than read it
+    using Aoc_solve_input_function = void (*)(const Aoc_input *input, int argc, char **argv);
+
+    /*
+     * Receives the answers from the parts, the answer is not null terminated
+     */
+    struct Aoc_answer_sink
+    {
+        void *context;
+        void (*report)(void *context, int part, const char *answer, std::size_t size);
+    };
+
+    /*
+     * Exported as "set_answer_sink" by every module, the answers passed to aoc::answer go to the sink instead of the
+     * standard output until it is called with null
+     */
+    using Aoc_set_answer_sink_function = void (*)(const Aoc_answer_sink *sink);
+
+    enum Aoc_phase_flags : unsigned
+    {
+        // The parts only read the parsed input, so the driver may run them at the same time
+        AOC_PARTS_INDEPENDENT = 1u << 0
+    };
+
+    /*
+     * The optional richer interface, a module exports a "phases" function returning this so the driver can time the
+     * parsing and each of the parts on their own. Modules exporting it still export "solve" for older drivers.
+     */
+    struct Aoc_phases
+    {
+        unsigned flags;
+        // Read the input from the standard input, the result is passed to the parts and then destroyed
+        void *(*parse)(int argc, char **argv);
+        // Parse the input the driver already has in memory instead, may be null
+        void *(*parse_input)(const Aoc_input *input, int argc, char **argv);
+        void (*part_one)(const void *input, const Aoc_answer_sink *sink);
+        void (*part_two)(const void *input, const Aoc_answer_sink *sink);
+        void (*destroy)(void *input);
+    };
+
+    using Aoc_phases_function = const Aoc_phases *(*)();
+}
+
+#endif
@@ -0,0 +1,411 @@
+#include "batch.h"
+
+#include "bench_history.h"
+#include "input_store.h"
+#include "layout.h"
+#include "loader.h"
+#include "result_cache.h"
+#include "scheduler.h"
+
+#include <aoc/string_helpers.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+#include <cstdlib>
+
+namespace
+{
+using Day_key = std::pair<int, int>;
+using Timing_history = std::map<Day_key, std::chrono::nanoseconds>;
+
+struct Batch_job
+{
+    int year;
+    int day;
+    std::optional<std::chrono::nanoseconds> previous_time;
+};
+
+enum class Batch_status
+{
+    finished,
+    timed_out,
+    crashed,
+    tests_failed,
+    missing_module,
+    missing_input
+};
+
+struct Batch_result
+{
+    Batch_status status = Batch_status::missing_module;
+    std::chrono::nanoseconds solve_time{};
+    std::vector<std::string> answers;
+    std::string message;
+    // The input no longer matches what was downloaded
+    bool input_modified = false;
+    // Set when caching, unless the module or input couldn't be read
+    std::optional<driver::Cache_key> cache_key;
+    // The answers came from the cache and the solution wasn't run
+    bool cached = false;
+};
+
+const char *to_string(const Batch_status status)
+{
+    switch (status)
+    {
+    case Batch_status::finished:
+        return "ok";
+    case Batch_status::timed_out:
+        return "timed out";
+    case Batch_status::crashed:
+        return "crashed";
+    case Batch_status::tests_failed:
+        return "tests failed";
+    case Batch_status::missing_module:
+        return "no module";
+    case Batch_status::missing_input:
+        return "no input";
+    }
+    return "unknown";
+}
+
+bool is_failure(const Batch_status status)
+{
+    return status == Batch_status::timed_out || status == Batch_status::crashed ||
+           status == Batch_status::tests_failed;
+}
+
+/*
+ * The timings from the previous batch are kept next to the driver, one "year day nanoseconds" line per solution
+ */
+std::filesystem::path get_history_path(const std::filesystem::path &exe_directory)
+{
+    return exe_directory / "batch_timings.txt";
+}
+
+Timing_history read_history(const std::filesystem::path &path)
+{
+    Timing_history history;
+    std::ifstream file(path);
+    int year;
+    int day;
+    std::int64_t nanoseconds;
+    while (file >> year >> day >> nanoseconds)
+    {
+        history[{year, day}] = std::chrono::nanoseconds(nanoseconds);
+    }
+    return history;
+}
+
+// A history cut short would schedule the next batch badly, so it is replaced in one go like the result cache
+bool write_history(const std::filesystem::path &path, const Timing_history &history, std::string &error)
+{
+    std::string contents;
+    for (const auto &[key, duration] : history)
+    {
+        contents += std::format("{} {} {}\n", key.first, key.second, duration.count());
+    }
+    return driver::write_file_atomically(path, contents, error);
+}
+
+/*
+ * Join the answers onto one line of the table
+ */
+std::string join_answers(const std::vector<std::string> &answers)
+{
+    std::string joined;
+    for (const std::string &answer : answers)
+    {
+        if (!joined.empty())
+        {
+            joined += "  ";
+        }
+        joined += answer;
+    }
+    return joined;
+}
+
+/*
+ * A job that still has to run. The modules are all loaded on the main thread before the workers start, loading one
+ * while another worker forks could leave the child with the dynamic loader's locks held.
+ */
+struct Loaded_job
+{
+    driver::Loaded_day day;
+    std::filesystem::path input_path;
+};
+
+/*
+ * Check the input and load the module of the day, answering from the cache if possible. Returns the job if the
+ * solution still has to run, otherwise the result says why it doesn't.
+ */
+std::optional<Loaded_job> load_job(const Batch_job &job, const driver::Batch_options &options,
+                                   const driver::Input_index &index, const driver::Result_cache *cache,
+                                   Batch_result &result)
+{
+    if (!driver::has_day(options.exe_directory, job.year, job.day))
+    {
+        return std::nullopt;
+    }
+
+    const std::filesystem::path input_path = driver::get_input_path(options.data_directory, job.year, job.day);
+    if (!exists(input_path))
+    {
+        result.status = Batch_status::missing_input;
+        return std::nullopt;
+    }
+    result.input_modified = index.check(job.year, job.day, input_path) == driver::Input_check::modified;
+
+    std::string error;
+    std::optional<driver::Loaded_day> loaded_day = driver::load_day(options.exe_directory, job.year, job.day, error);
+    if (!loaded_day)
+    {
+        result.status = Batch_status::crashed;
+        result.message = error;
+        return std::nullopt;
+    }
+
+    if (cache)
+    {
+        // The program name isn't part of the key, it only depends on where the driver is
+        result.cache_key = driver::make_cache_key(job.year, job.day, loaded_day->binary_path, input_path,
+                                                  std::span(options.arguments).subspan(1));
+        const std::vector<std::string> *answers =
+            result.cache_key && !options.bypass_cache ? cache->find(*result.cache_key) : nullptr;
+        if (answers)
+        {
+            result.status = Batch_status::finished;
+            result.answers = *answers;
+            result.cached = true;
+            return std::nullopt;
+        }
+    }
+
+    if (options.run_tests && !driver::load_tests(options.exe_directory, job.year, job.day, *loaded_day, error))
+    {
+        result.status = Batch_status::crashed;
+        result.message = error;
+        return std::nullopt;
+    }
+    return Loaded_job{std::move(*loaded_day), input_path};
+}
+
+void run_job(const Loaded_job &job, const driver::Batch_options &options, Batch_result &result)
+{
+    // Every job gets its own copy of the arguments since the solutions are free to modify them
+    std::vector<std::string> arguments = options.arguments;
+    std::vector<char *> argv;
+    for (std::string &argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    driver::Run_options run_options;
+    run_options.input_path = job.input_path;
+    run_options.capture_output = true;
+    run_options.test_fn = job.day.test;
+    const driver::Run_result run_result = driver::run_solution(
+        job.day.solution, static_cast<int>(arguments.size()), argv.data(), options.limits, run_options);
+    switch (run_result.status)
+    {
+    case driver::Run_status::finished:
+        result.status = Batch_status::finished;
+        break;
+    case driver::Run_status::timed_out:
+        result.status = Batch_status::timed_out;
+        break;
+    case driver::Run_status::crashed:
+        result.status = Batch_status::crashed;
+        break;
+    case driver::Run_status::tests_failed:
+        result.status = Batch_status::tests_failed;
+        break;
+    }
+    result.solve_time = run_result.solve_time;
+    result.answers = driver::split_answers(run_result.output);
+    result.message = run_result.message;
+}
+
+std::string format_duration(const std::chrono::nanoseconds duration)
+{
+    return std::format("{:.3f}ms", std::chrono::duration<double, std::milli>(duration).count());
+}
+} // namespace
+
+namespace driver
+{
+std::optional<std::vector<int>> parse_years(const std::string_view text, std::string &error)
+{
+    std::vector<int> years;
+    for (const std::string_view part : aoc::split(text, ','))
+    {
+        const std::vector<std::string_view> range = aoc::split(part, '-');
+        const std::optional<int> first = range.size() == 1 || range.size() == 2 ? aoc::convert<int>(range.front())
+                                                                                : std::nullopt;
+        const std::optional<int> last = range.size() == 2 ? aoc::convert<int>(range.back()) : first;
+        if (!first || !last || *first > *last || *first < first_year || *last > last_year)
+        {
+            error = std::format("invalid year '{}', expected a year or range of years between {} and {}", part,
+                                first_year, last_year);
+            return std::nullopt;
+        }
+        for (int year = *first; year <= *last; ++year)
+        {
+            years.push_back(year);
+        }
+    }
+
+    std::ranges::sort(years);
+    years.erase(std::ranges::unique(years).begin(), years.end());
+    if (years.empty())
+    {
+        error = "no years were given";
+        return std::nullopt;
+    }
+    return years;
+}
+
+int run_batch(const Batch_options &options)
+{
+    const std::filesystem::path history_path = get_history_path(options.exe_directory);
+    Timing_history history = read_history(history_path);
+    const Input_index input_index = Input_index::load(options.data_directory);
+    std::optional<Result_cache> cache;
+    if (!options.cache_path.empty())
+    {
+        cache = Result_cache::load(options.cache_path, options.cache_capacity);
+    }
+
+    std::vector<Batch_job> jobs;
+    for (const int year : options.years)
+    {
+        for (int day = 1; day <= get_number_of_days(year); ++day)
+        {
+            Batch_job job{year, day, std::nullopt};
+            if (const auto iter = history.find({year, day}); iter != history.end())
+            {
+                job.previous_time = iter->second;
+            }
+            jobs.push_back(job);
+        }
+    }
+
+    // Longest first, we don't know how long the new solutions take so assume the worst
+    std::ranges::stable_sort(jobs, [](const Batch_job &lhs, const Batch_job &rhs) {
+        return lhs.previous_time.value_or(std::chrono::nanoseconds::max()) >
+               rhs.previous_time.value_or(std::chrono::nanoseconds::max());
+    });
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<Batch_result> results(jobs.size());
+    std::vector<std::optional<Loaded_job>> loaded_jobs(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+        loaded_jobs[i] = load_job(jobs[i], options, input_index, cache ? &*cache : nullptr, results[i]);
+    }
+    // Only the jobs that loaded get a thread, in the same order
+    std::vector<std::size_t> runnable;
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+        if (loaded_jobs[i])
+        {
+            runnable.push_back(i);
+        }
+    }
+    const unsigned threads = run_work_stealing(runnable.size(), options.jobs, [&](const std::size_t index) {
+        const std::size_t i = runnable[index];
+        run_job(*loaded_jobs[i], options, results[i]);
+    });
+    const std::chrono::steady_clock::duration wall_time = std::chrono::steady_clock::now() - start;
+
+    std::vector<std::size_t> order(jobs.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::ranges::sort(order, [&jobs](const std::size_t lhs, const std::size_t rhs) {
+        return std::tie(jobs[lhs].year, jobs[lhs].day) < std::tie(jobs[rhs].year, jobs[rhs].day);
+    });
+
+    int failures = 0;
+    int solutions = 0;
+    int cached = 0;
+    std::vector<std::size_t> modified_inputs;
+    std::chrono::nanoseconds total_solve_time{};
+    std::cout << std::format("{:<6}{:<5}{:<14}{:>14}  {}\n", "Year", "Day", "Status", "Solve", "Answers");
+    for (const std::size_t i : order)
+    {
+        const Batch_job &job = jobs[i];
+        const Batch_result &result = results[i];
+        if (result.status == Batch_status::missing_module)
+        {
+            continue;
+        }
+
+        const bool finished = result.status == Batch_status::finished;
+        const std::string solve_time = !finished ? "-" : result.cached ? "cached" : format_duration(result.solve_time);
+        const std::string details = finished ? join_answers(result.answers) : result.message;
+        std::cout << std::format("{:<6}{:<5}{:<14}{:>14}  {}\n", job.year, job.day, to_string(result.status),
+                                 solve_time, details);
+
+        if (result.cached)
+        {
+            cache->touch(*result.cache_key);
+            ++cached;
+        }
+        else if (finished && cache && result.cache_key)
+        {
+            cache->store(*result.cache_key, result.answers);
+        }
+
+        if (finished && !result.cached)
+        {
+            history[{job.year, job.day}] = result.solve_time;
+            total_solve_time += result.solve_time;
+        }
+        else if (result.status == Batch_status::timed_out)
+        {
+            // Make sure it is scheduled first next time
+            history[{job.year, job.day}] = options.limits.timeout;
+        }
+        if (result.input_modified)
+        {
+            modified_inputs.push_back(i);
+        }
+        failures += is_failure(result.status) ? 1 : 0;
+        solutions += result.status != Batch_status::missing_input ? 1 : 0;
+    }
+
+    for (const std::size_t i : modified_inputs)
+    {
+        std::cout << std::format("Warning: the input for {} day {} has changed since it was downloaded\n", jobs[i].year,
+                                 jobs[i].day);
+    }
+
+    std::cout << std::format("Ran {} solutions on {} {} in {}, total solve time {}, {} failed", solutions, threads,
+                             threads == 1 ? "thread" : "threads", format_duration(wall_time),
+                             format_duration(total_solve_time), failures);
+    std::cout << (cached != 0 ? std::format(", {} answered from the cache\n", cached) : "\n");
+    if (std::string error; !write_history(history_path, history, error))
+    {
+        std::cerr << "Failed to save the batch timings: " << error << '\n';
+    }
+    if (std::string error; cache && !cache->save(error))
+    {
+        std::cerr << "Failed to save the result cache: " << error << '\n';
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace driver
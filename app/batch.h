@@ -0,0 +1,44 @@
+#ifndef AOC_BATCH_H
+#define AOC_BATCH_H
+
+#include "platform.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace driver
+{
+struct Batch_options
+{
+    std::filesystem::path exe_directory;
+    std::filesystem::path data_directory;
+    std::vector<int> years;
+    // Number of solutions to run at the same time
+    unsigned jobs;
+    bool run_tests;
+    Run_limits limits;
+    // Passed to every solution, the first argument is the program name
+    std::vector<std::string> arguments;
+    // Reuse the answers of earlier runs of the same module on the same input from this cache, empty for no caching
+    std::filesystem::path cache_path;
+    std::size_t cache_capacity = 0;
+    // Run every solution anyway, their answers still replace the cached ones
+    bool bypass_cache = false;
+};
+
+/*
+ * Parse a comma separated list of years and inclusive ranges of years, e.g. "2018,2023-2025"
+ */
+std::optional<std::vector<int>> parse_years(std::string_view text, std::string &error);
+
+/*
+ * Run every day of the selected years in parallel and print a table of the results. A solution that crashes or times
+ * out is reported and the rest carry on. Returns non-zero if any of the solutions failed.
+ */
+int run_batch(const Batch_options &options);
+} // namespace driver
+
+#endif
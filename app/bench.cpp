@@ -0,0 +1,193 @@
+#include "bench.h"
+
+#include "json.h"
+#include "statistics.h"
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <cstdint>
+
+namespace
+{
+void write_summary(driver::Json_writer &writer, const driver::Timing_summary &summary)
+{
+    writer.key("min").value(summary.min.count());
+    writer.key("median").value(summary.median.count());
+    writer.key("p90").value(summary.p90.count());
+    writer.key("p99").value(summary.p99.count());
+    writer.key("max").value(summary.max.count());
+    writer.key("mean").value(summary.mean.count());
+    writer.key("stddev").value(summary.standard_deviation.count());
+}
+void write_allocations(driver::Json_writer &writer, const driver::Allocation_stats &stats)
+{
+    writer.key("count").value(stats.count);
+    writer.key("bytes").value(stats.bytes);
+    writer.key("peak_bytes").value(stats.peak_bytes);
+    writer.key("size_histogram").begin_array();
+    for (const std::uint64_t count : stats.size_histogram)
+    {
+        writer.value(count);
+    }
+    writer.end_array();
+}
+
+void write_counters(driver::Json_writer &writer, const driver::Counter_values &values)
+{
+    writer.key("hardware").value(values.hardware);
+    if (values.hardware)
+    {
+        writer.key("cycles").value(values.cycles);
+        writer.key("instructions").value(values.instructions);
+        writer.key("cache_misses").value(values.cache_misses);
+        writer.key("branch_misses").value(values.branch_misses);
+        writer.key("ipc").value(values.get_instructions_per_cycle());
+        writer.key("cache_mpki").value(values.get_cache_mpki());
+        writer.key("branch_mpki").value(values.get_branch_mpki());
+    }
+    writer.key("page_faults").value(values.page_faults);
+    writer.key("user_time").value(values.user_time.count());
+    writer.key("system_time").value(values.system_time.count());
+}
+} // namespace
+
+namespace driver
+{
+std::string format_bench_report(const Bench_settings &settings, const Run_result &result)
+{
+    Json_writer writer;
+    writer.begin_object();
+    writer.key("year").value(settings.year);
+    writer.key("day").value(settings.day);
+    writer.key("warmup").value(settings.warmup);
+    writer.key("iterations").value(settings.iterations);
+    writer.key("unit").value("ns");
+
+    writer.key("answers").begin_array();
+    std::istringstream output(result.output);
+    for (std::string line; std::getline(output, line);)
+    {
+        if (!line.empty())
+        {
+            writer.value(line);
+        }
+    }
+    writer.end_array();
+
+    const auto samples = [&result](std::chrono::nanoseconds driver::Iteration_times::*phase) {
+        std::vector<std::chrono::nanoseconds> times;
+        for (const driver::Iteration_times &iteration : result.iterations)
+        {
+            times.push_back(iteration.*phase);
+        }
+        return times;
+    };
+
+    write_summary(writer, summarize(samples(&Iteration_times::total)));
+
+    writer.key("samples").begin_array();
+    for (const Iteration_times &iteration : result.iterations)
+    {
+        writer.value(iteration.total.count());
+    }
+    writer.end_array();
+
+    if (result.has_phases)
+    {
+        writer.key("phases").begin_object();
+        const std::pair<const char *, std::chrono::nanoseconds Iteration_times::*> phases[] = {
+            {"parse", &Iteration_times::parse},
+            {"part_one", &Iteration_times::part_one},
+            {"part_two", &Iteration_times::part_two},
+        };
+        for (const auto &[name, phase] : phases)
+        {
+            writer.key(name).begin_object();
+            write_summary(writer, summarize(samples(phase)));
+            writer.end_object();
+        }
+        writer.end_object();
+    }
+    else if (std::ranges::any_of(result.iterations, [](const Iteration_times &times) {
+                 return times.part_one_answered || times.part_two_answered;
+             }))
+    {
+        // When each answer was reported, for solutions that aren't split into phases. Only the parts that reported
+        // their answers are written.
+        writer.key("answer_times").begin_object();
+        using Answer_time = std::chrono::nanoseconds Iteration_times::*;
+        const std::tuple<const char *, Answer_time, bool Iteration_times::*> answers[] = {
+            {"part_one", &Iteration_times::part_one_answer, &Iteration_times::part_one_answered},
+            {"part_two", &Iteration_times::part_two_answer, &Iteration_times::part_two_answered},
+        };
+        for (const auto &[name, answer, answered] : answers)
+        {
+            if (std::ranges::none_of(result.iterations,
+                                     [answered](const Iteration_times &times) { return times.*answered; }))
+            {
+                continue;
+            }
+            writer.key(name).begin_object();
+            write_summary(writer, summarize(samples(answer)));
+            writer.end_object();
+        }
+        writer.end_object();
+    }
+
+    if (result.allocations)
+    {
+        const Allocation_profile &allocations = *result.allocations;
+        writer.key("allocations").begin_object();
+        write_allocations(writer, allocations.total);
+        if (result.has_phases)
+        {
+            writer.key("parts_combined").value(allocations.parts_combined);
+            writer.key("phases").begin_object();
+            const std::pair<const char *, const Allocation_stats *> phases[] = {
+                {"parse", &allocations.parse},
+                {"part_one", &allocations.part_one},
+                {"part_two", &allocations.part_two},
+            };
+            for (const auto &[name, stats] : phases)
+            {
+                writer.key(name).begin_object();
+                write_allocations(writer, *stats);
+                writer.end_object();
+            }
+            writer.end_object();
+        }
+        writer.end_object();
+    }
+
+    if (result.counters)
+    {
+        const Counter_profile &counters = *result.counters;
+        writer.key("counters").begin_object();
+        write_counters(writer, counters.total);
+        if (result.has_phases)
+        {
+            writer.key("parts_combined").value(counters.parts_combined);
+            writer.key("phases").begin_object();
+            const std::pair<const char *, const Counter_values *> phases[] = {
+                {"parse", &counters.parse},
+                {"part_one", &counters.part_one},
+                {"part_two", &counters.part_two},
+            };
+            for (const auto &[name, values] : phases)
+            {
+                writer.key(name).begin_object();
+                write_counters(writer, *values);
+                writer.end_object();
+            }
+            writer.end_object();
+        }
+        writer.end_object();
+    }
+    writer.end_object();
+    return writer.str();
+}
+} // namespace driver
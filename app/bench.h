@@ -0,0 +1,24 @@
+#ifndef AOC_BENCH_H
+#define AOC_BENCH_H
+
+#include "platform.h"
+
+#include <string>
+
+namespace driver
+{
+struct Bench_settings
+{
+    int year;
+    int day;
+    int warmup;
+    int iterations;
+};
+
+/*
+ * Describe the timings of a benchmarked run as a JSON object, all of the times are in nanoseconds
+ */
+std::string format_bench_report(const Bench_settings &settings, const Run_result &result);
+} // namespace driver
+
+#endif
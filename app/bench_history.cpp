@@ -0,0 +1,233 @@
+#include "bench_history.h"
+
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+constexpr const char *history_header =
+    "# year day module input timestamp iterations min median p90 p99 max mean stddev peak_memory answers...\n";
+} // namespace
+
+namespace driver
+{
+std::string escape_answer(const std::string_view answer)
+{
+    std::string escaped;
+    for (const char c : answer)
+    {
+        switch (c)
+        {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case ' ':
+            escaped += "\\s";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+            break;
+        }
+    }
+    return escaped;
+}
+
+std::optional<std::string> unescape_answer(const std::string_view escaped)
+{
+    std::string answer;
+    for (std::size_t i = 0; i < escaped.size(); ++i)
+    {
+        if (escaped[i] != '\\')
+        {
+            answer += escaped[i];
+            continue;
+        }
+        if (++i == escaped.size())
+        {
+            return std::nullopt;
+        }
+        switch (escaped[i])
+        {
+        case '\\':
+            answer += '\\';
+            break;
+        case 's':
+            answer += ' ';
+            break;
+        case 't':
+            answer += '\t';
+            break;
+        case 'n':
+            answer += '\n';
+            break;
+        default:
+            return std::nullopt;
+        }
+    }
+    return answer;
+}
+
+std::filesystem::path get_default_bench_history_path(const std::filesystem::path &exe_directory)
+{
+    return exe_directory / "bench_history.txt";
+}
+
+std::vector<std::string> split_answers(const std::string_view output)
+{
+    std::vector<std::string> answers;
+    std::istringstream stream{std::string(output)};
+    for (std::string line; std::getline(stream, line);)
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        if (!line.empty())
+        {
+            answers.push_back(std::move(line));
+        }
+    }
+    return answers;
+}
+
+Bench_record make_bench_record(const int year, const int day, const std::uint64_t module_hash,
+                               const std::uint64_t input_hash, const Run_result &result)
+{
+    Bench_record record;
+    record.year = year;
+    record.day = day;
+    record.module_hash = module_hash;
+    record.input_hash = input_hash;
+    record.timestamp =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    record.iterations = static_cast<int>(result.iterations.size());
+
+    std::vector<std::chrono::nanoseconds> samples;
+    for (const Iteration_times &iteration : result.iterations)
+    {
+        samples.push_back(iteration.total);
+    }
+    record.timings = summarize(std::move(samples));
+    record.peak_memory = result.peak_memory;
+    record.answers = split_answers(result.output);
+    return record;
+}
+
+std::string format_bench_record(const Bench_record &record)
+{
+    const Timing_summary &timings = record.timings;
+    std::string line = std::format("{} {} {:016x} {:016x} {} {} {} {} {} {} {} {} {} {}", record.year, record.day,
+                                   record.module_hash, record.input_hash, record.timestamp, record.iterations,
+                                   timings.min.count(), timings.median.count(), timings.p90.count(),
+                                   timings.p99.count(), timings.max.count(), timings.mean.count(),
+                                   timings.standard_deviation.count(), record.peak_memory);
+    for (const std::string &answer : record.answers)
+    {
+        line += ' ';
+        line += escape_answer(answer);
+    }
+    return line;
+}
+
+std::optional<Bench_record> parse_bench_record(const std::string_view line)
+{
+    std::istringstream stream{std::string(line)};
+    Bench_record record;
+    std::int64_t times[7];
+    stream >> record.year >> record.day >> std::hex >> record.module_hash >> record.input_hash >> std::dec >>
+        record.timestamp >> record.iterations;
+    for (std::int64_t &time : times)
+    {
+        stream >> time;
+    }
+    stream >> record.peak_memory;
+    if (!stream)
+    {
+        return std::nullopt;
+    }
+
+    Timing_summary &timings = record.timings;
+    std::chrono::nanoseconds *const fields[] = {&timings.min, &timings.median, &timings.p90,
+                                                &timings.p99, &timings.max,    &timings.mean,
+                                                &timings.standard_deviation};
+    for (std::size_t i = 0; i < std::size(fields); ++i)
+    {
+        *fields[i] = std::chrono::nanoseconds(times[i]);
+    }
+
+    for (std::string escaped; stream >> escaped;)
+    {
+        std::optional<std::string> answer = unescape_answer(escaped);
+        if (!answer)
+        {
+            return std::nullopt;
+        }
+        record.answers.push_back(std::move(*answer));
+    }
+    return record;
+}
+
+std::optional<std::vector<Bench_record>> read_bench_history(const std::filesystem::path &path, std::string &error)
+{
+    std::vector<Bench_record> records;
+    std::ifstream file(path);
+    if (!file)
+    {
+        if (exists(path))
+        {
+            error = std::format("failed to open {}", path.string());
+            return std::nullopt;
+        }
+        return records;
+    }
+
+    int line_number = 0;
+    for (std::string line; std::getline(file, line);)
+    {
+        ++line_number;
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+        std::optional<Bench_record> record = parse_bench_record(line);
+        if (!record)
+        {
+            error = std::format("{}:{}: invalid record", path.string(), line_number);
+            return std::nullopt;
+        }
+        records.push_back(std::move(*record));
+    }
+    return records;
+}
+
+bool append_bench_record(const std::filesystem::path &path, const Bench_record &record, std::string &error)
+{
+    const bool is_new = !exists(path);
+    std::ofstream file(path, std::ios_base::app);
+    if (!file)
+    {
+        error = std::format("failed to open {} for writing", path.string());
+        return false;
+    }
+    if (is_new)
+    {
+        file << history_header;
+    }
+    file << format_bench_record(record) << '\n';
+    file.close();
+    if (!file)
+    {
+        error = std::format("failed to write {}", path.string());
+        return false;
+    }
+    return true;
+}
+} // namespace driver
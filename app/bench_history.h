@@ -0,0 +1,76 @@
+#ifndef AOC_BENCH_HISTORY_H
+#define AOC_BENCH_HISTORY_H
+
+#include "platform.h"
+#include "statistics.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace driver
+{
+/*
+ * One benchmarked run of a solution. The hashes tell apart results from different builds of the solution and from
+ * different inputs, the answers are only comparable between runs on the same input.
+ */
+struct Bench_record
+{
+    int year = 0;
+    int day = 0;
+    std::uint64_t module_hash = 0;
+    std::uint64_t input_hash = 0;
+    // Seconds since the epoch
+    std::int64_t timestamp = 0;
+    int iterations = 0;
+    Timing_summary timings;
+    // In bytes, zero if it wasn't measured
+    std::size_t peak_memory = 0;
+    std::vector<std::string> answers;
+};
+
+/*
+ * The history is kept next to the driver unless another path is given
+ */
+std::filesystem::path get_default_bench_history_path(const std::filesystem::path &exe_directory);
+
+/*
+ * The non-empty lines of the output of a solution, these are the answers for most solutions
+ */
+std::vector<std::string> split_answers(std::string_view output);
+
+/*
+ * Describe a finished benchmark run, timestamped with the current time
+ */
+Bench_record make_bench_record(int year, int day, std::uint64_t module_hash, std::uint64_t input_hash,
+                               const Run_result &result);
+
+/*
+ * Backslash escapes for the characters that separate the fields and records, unescaping returns an empty optional for
+ * an invalid escape
+ */
+std::string escape_answer(std::string_view answer);
+std::optional<std::string> unescape_answer(std::string_view escaped);
+
+/*
+ * Records are stored one per line, the answers are escaped so that they can't contain spaces or line breaks
+ */
+std::string format_bench_record(const Bench_record &record);
+std::optional<Bench_record> parse_bench_record(std::string_view line);
+
+/*
+ * Read every record in the history in the order they were added, a missing history is treated as empty. On failure
+ * returns an empty optional and sets the error message.
+ */
+std::optional<std::vector<Bench_record>> read_bench_history(const std::filesystem::path &path, std::string &error);
+
+/*
+ * Add a record to the end of the history, creating it if necessary
+ */
+bool append_bench_record(const std::filesystem::path &path, const Bench_record &record, std::string &error);
+} // namespace driver
+
+#endif
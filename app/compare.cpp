@@ -0,0 +1,291 @@
+#include "compare.h"
+
+#include "bench_history.h"
+#include "input_store.h"
+#include "layout.h"
+#include "loader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include <cstdlib>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+// Differences smaller than this are noise for the fastest solutions, whatever the threshold
+constexpr std::chrono::nanoseconds min_regression = 20us;
+
+enum class Compare_status
+{
+    unchanged,
+    faster,
+    regressed,
+    wrong_answer,
+    // There are results in the baseline but none for this input
+    new_input,
+    no_baseline,
+    missing_input,
+    failed
+};
+
+struct Comparison
+{
+    int year;
+    int day;
+    Compare_status status = Compare_status::failed;
+    std::optional<driver::Bench_record> result;
+    std::optional<driver::Bench_record> baseline;
+    std::string message;
+};
+
+const char *to_string(const Compare_status status)
+{
+    switch (status)
+    {
+    case Compare_status::unchanged:
+        return "ok";
+    case Compare_status::faster:
+        return "faster";
+    case Compare_status::regressed:
+        return "regressed";
+    case Compare_status::wrong_answer:
+        return "wrong answer";
+    case Compare_status::new_input:
+        return "new input";
+    case Compare_status::no_baseline:
+        return "no baseline";
+    case Compare_status::missing_input:
+        return "no input";
+    case Compare_status::failed:
+        return "failed";
+    }
+    return "unknown";
+}
+
+bool is_failure(const Compare_status status)
+{
+    return status == Compare_status::regressed || status == Compare_status::wrong_answer ||
+           status == Compare_status::failed;
+}
+
+std::string format_duration(const std::chrono::nanoseconds duration)
+{
+    return std::format("{:.3f}ms", std::chrono::duration<double, std::milli>(duration).count());
+}
+
+std::string join_answers(const std::vector<std::string> &answers)
+{
+    std::string joined;
+    for (const std::string &answer : answers)
+    {
+        if (!joined.empty())
+        {
+            joined += "  ";
+        }
+        joined += answer;
+    }
+    return joined;
+}
+
+/*
+ * Benchmark a single day, the result is only set if the solution finished
+ */
+Comparison run_day(const int year, const int day, const driver::Compare_options &options)
+{
+    Comparison comparison{year, day};
+    const std::filesystem::path input_path = driver::get_input_path(options.data_directory, year, day);
+    const std::optional<std::uint64_t> input_hash = driver::hash_file(input_path);
+    if (!input_hash)
+    {
+        comparison.status = Compare_status::missing_input;
+        return comparison;
+    }
+
+    std::optional<driver::Loaded_day> loaded_day =
+        driver::load_day(options.exe_directory, year, day, comparison.message);
+    if (!loaded_day ||
+        (options.run_tests && !driver::load_tests(options.exe_directory, year, day, *loaded_day, comparison.message)))
+    {
+        return comparison;
+    }
+
+    std::vector<std::string> arguments = options.arguments;
+    std::vector<char *> argv;
+    for (std::string &argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    driver::Run_options run_options;
+    run_options.input_path = input_path;
+    run_options.capture_output = true;
+    run_options.test_fn = loaded_day->test;
+    run_options.warmup = options.warmup;
+    run_options.iterations = options.iterations;
+    const driver::Run_result run_result = driver::run_solution(
+        loaded_day->solution, static_cast<int>(arguments.size()), argv.data(), options.limits, run_options);
+    switch (run_result.status)
+    {
+    case driver::Run_status::finished:
+        break;
+    case driver::Run_status::timed_out:
+        comparison.message = "timed out (" + run_result.message + ")";
+        return comparison;
+    case driver::Run_status::crashed:
+        comparison.message = "crashed (" + run_result.message + ")";
+        return comparison;
+    case driver::Run_status::tests_failed:
+        comparison.message = "tests failed";
+        return comparison;
+    }
+
+    const std::uint64_t module_hash = driver::hash_file(loaded_day->binary_path).value_or(0);
+    comparison.result = driver::make_bench_record(year, day, module_hash, *input_hash, run_result);
+    return comparison;
+}
+
+/*
+ * Fill in the status of a finished run from the most recent baseline result for the same input
+ */
+void compare_with_baseline(Comparison &comparison, const std::vector<driver::Bench_record> &baselines,
+                           const double threshold)
+{
+    const driver::Bench_record &result = *comparison.result;
+    for (auto iter = baselines.rbegin(); iter != baselines.rend(); ++iter)
+    {
+        if (iter->input_hash == result.input_hash)
+        {
+            comparison.baseline = *iter;
+            break;
+        }
+    }
+    if (!comparison.baseline)
+    {
+        comparison.status = baselines.empty() ? Compare_status::no_baseline : Compare_status::new_input;
+        return;
+    }
+
+    const driver::Bench_record &baseline = *comparison.baseline;
+    const std::chrono::duration<double, std::nano> relative_change = baseline.timings.median * threshold;
+    const std::chrono::nanoseconds allowed_change =
+        std::max(min_regression, std::chrono::duration_cast<std::chrono::nanoseconds>(relative_change));
+    if (result.answers != baseline.answers)
+    {
+        comparison.status = Compare_status::wrong_answer;
+    }
+    else if (result.timings.median > baseline.timings.median + allowed_change)
+    {
+        comparison.status = Compare_status::regressed;
+    }
+    else if (result.timings.median < baseline.timings.median - allowed_change)
+    {
+        comparison.status = Compare_status::faster;
+    }
+    else
+    {
+        comparison.status = Compare_status::unchanged;
+    }
+}
+} // namespace
+
+namespace driver
+{
+int run_compare(const Compare_options &options)
+{
+    std::string error;
+    // A missing history reads as an empty one, which would pass without comparing anything
+    if (!exists(options.baseline_path))
+    {
+        std::cerr << "Failed to read the baseline: " << options.baseline_path.string() << " doesn't exist\n";
+        return EXIT_FAILURE;
+    }
+    const std::optional<std::vector<Bench_record>> baseline_records = read_bench_history(options.baseline_path, error);
+    if (!baseline_records)
+    {
+        std::cerr << "Failed to read the baseline: " << error << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::map<std::pair<int, int>, std::vector<Bench_record>> baselines;
+    for (const Bench_record &record : *baseline_records)
+    {
+        baselines[{record.year, record.day}].push_back(record);
+    }
+
+    // The days are run one at a time so they don't disturb each other's timings
+    std::vector<Comparison> comparisons;
+    std::cout << std::format("{:<6}{:<5}{:<14}{:>14}{:>14}{:>10}\n", "Year", "Day", "Status", "Median", "Baseline",
+                             "Change");
+    for (const int year : options.years)
+    {
+        for (int day = 1; day <= get_number_of_days(year); ++day)
+        {
+            if (!has_day(options.exe_directory, year, day))
+            {
+                continue;
+            }
+
+            Comparison comparison = run_day(year, day, options);
+            if (comparison.result)
+            {
+                compare_with_baseline(comparison, baselines[{year, day}], options.threshold);
+                if (!append_bench_record(options.history_path, *comparison.result, error))
+                {
+                    std::cerr << "Failed to record the result: " << error << '\n';
+                }
+            }
+
+            std::string median = "-";
+            std::string baseline_median = "-";
+            std::string change;
+            if (comparison.result)
+            {
+                median = format_duration(comparison.result->timings.median);
+            }
+            if (comparison.result && comparison.baseline)
+            {
+                const std::chrono::nanoseconds before = comparison.baseline->timings.median;
+                baseline_median = format_duration(before);
+                if (before.count() > 0)
+                {
+                    change = std::format("{:+.1f}%", 100.0 * (comparison.result->timings.median - before) / before);
+                }
+            }
+            std::cout << std::format("{:<6}{:<5}{:<14}{:>14}{:>14}{:>10}  {}\n", year, day,
+                                     to_string(comparison.status), median, baseline_median, change, comparison.message);
+            comparisons.push_back(std::move(comparison));
+        }
+    }
+
+    int failures = 0;
+    int compared = 0;
+    for (const Comparison &comparison : comparisons)
+    {
+        if (comparison.status == Compare_status::wrong_answer)
+        {
+            std::cout << std::format("{} day {} answered {} but the baseline has {}\n", comparison.year,
+                                     comparison.day, join_answers(comparison.result->answers),
+                                     join_answers(comparison.baseline->answers));
+        }
+        failures += is_failure(comparison.status) ? 1 : 0;
+        compared += comparison.baseline ? 1 : 0;
+    }
+
+    std::cout << std::format("Compared {} of {} solutions with {}, {} failed\n", compared, comparisons.size(),
+                             options.baseline_path.string(), failures);
+    if (compared == 0)
+    {
+        std::cerr << "None of the solutions could be compared with the baseline\n";
+        return EXIT_FAILURE;
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+} // namespace driver
@@ -0,0 +1,39 @@
+#ifndef AOC_COMPARE_H
+#define AOC_COMPARE_H
+
+#include "platform.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+struct Compare_options
+{
+    std::filesystem::path exe_directory;
+    std::filesystem::path data_directory;
+    std::vector<int> years;
+    // The benchmark history the results are checked against
+    std::filesystem::path baseline_path;
+    // Where the new results are recorded, may be the same as the baseline
+    std::filesystem::path history_path;
+    // How much the median can grow, as a fraction of the baseline's median, before it counts as a regression
+    double threshold;
+    int warmup;
+    int iterations;
+    bool run_tests;
+    Run_limits limits;
+    // Passed to every solution, the first argument is the program name
+    std::vector<std::string> arguments;
+};
+
+/*
+ * Benchmark every day of the selected years one after the other, record the results and compare them with the most
+ * recent result in the baseline for the same input. Returns non-zero if any of the solutions failed, gave different
+ * answers or regressed by more than the threshold.
+ */
+int run_compare(const Compare_options &options);
+} // namespace driver
+
+#endif
@@ -0,0 +1,243 @@
+#include "corpus.h"
+
+#include "bench_history.h"
+#include "scheduler.h"
+#include "statistics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <cstdlib>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Corpus_result
+{
+    std::vector<std::string> answers;
+    // Set if the solution threw
+    std::string error;
+    std::chrono::nanoseconds duration{};
+};
+
+std::vector<std::filesystem::path> find_inputs(const std::filesystem::path &directory)
+{
+    std::vector<std::filesystem::path> inputs;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.is_regular_file() && !entry.path().filename().string().starts_with('.'))
+        {
+            inputs.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(inputs);
+    return inputs;
+}
+
+/*
+ * Collects the answers of one solve, each solve has its own so they can run at the same time
+ */
+class Answer_list
+{
+private:
+    std::vector<std::string> &m_answers;
+
+    static void report(void *const context, const int part, const char *const answer, const std::size_t size)
+    {
+        auto &answers = static_cast<Answer_list *>(context)->m_answers;
+        if (part == 1 || part == 2)
+        {
+            answers.resize(std::max<std::size_t>(answers.size(), static_cast<std::size_t>(part)));
+            answers[static_cast<std::size_t>(part - 1)].assign(answer, size);
+        }
+    }
+
+public:
+    explicit Answer_list(std::vector<std::string> &answers) : m_answers(answers)
+    {
+    }
+
+    [[nodiscard]] Aoc_answer_sink sink()
+    {
+        return {this, &report};
+    }
+};
+
+/*
+ * Only for the solutions taking their input in memory and reporting their answers through the phases, nothing is
+ * shared with the other solves
+ */
+void solve_in_memory(const Aoc_phases &phases, const std::filesystem::path &path, const int argc, char **argv,
+                     Corpus_result &result)
+{
+    const driver::Input_buffer buffer = driver::Input_buffer::load(path);
+    const Aoc_input input = buffer.view();
+    Answer_list answers(result.answers);
+    const Aoc_answer_sink sink = answers.sink();
+    const std::unique_ptr<void, void (*)(void *)> parsed(phases.parse_input(&input, argc, argv), phases.destroy);
+    phases.part_one(parsed.get(), &sink);
+    phases.part_two(parsed.get(), &sink);
+}
+
+/*
+ * The solution reads the standard input and writes to the standard output, which are swapped for the input file and a
+ * string while it runs
+ */
+void solve_with_streams(const driver::Solution &solution, const std::filesystem::path &path, const int argc,
+                        char **argv, Corpus_result &result)
+{
+    std::ifstream input(path, std::ios_base::binary);
+    if (!input)
+    {
+        throw std::runtime_error(std::format("failed to open {}", path.string()));
+    }
+    std::ostringstream output;
+
+    struct Stream_restorer
+    {
+        std::streambuf *input = std::cin.rdbuf();
+        std::streambuf *output = std::cout.rdbuf();
+
+        ~Stream_restorer()
+        {
+            std::cin.rdbuf(input);
+            std::cout.rdbuf(output);
+        }
+    } restorer;
+    std::cin.rdbuf(input.rdbuf());
+    std::cin.clear();
+    std::cout.rdbuf(output.rdbuf());
+
+    if (solution.phases)
+    {
+        Answer_list answers(result.answers);
+        const Aoc_answer_sink sink = answers.sink();
+        const std::unique_ptr<void, void (*)(void *)> parsed(solution.phases->parse(argc, argv),
+                                                             solution.phases->destroy);
+        solution.phases->part_one(parsed.get(), &sink);
+        solution.phases->part_two(parsed.get(), &sink);
+        return;
+    }
+    if (solution.solve_input)
+    {
+        const driver::Input_buffer buffer = driver::Input_buffer::load(path);
+        const Aoc_input view = buffer.view();
+        solution.solve_input(&view, argc, argv);
+    }
+    else
+    {
+        solution.solve(argc, argv);
+    }
+    std::cout.flush();
+    result.answers = driver::split_answers(output.str());
+}
+} // namespace
+
+namespace driver
+{
+int run_corpus(const Solution &solution, const Corpus_options &options)
+{
+    std::vector<std::filesystem::path> inputs;
+    try
+    {
+        inputs = find_inputs(options.directory);
+    }
+    catch (const std::filesystem::filesystem_error &ex)
+    {
+        std::cerr << "Failed to list the inputs: " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+    if (inputs.empty())
+    {
+        std::cerr << "There are no inputs in " << options.directory << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> arguments = options.arguments;
+    std::vector<char *> argv;
+    for (std::string &argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+    const auto argc = static_cast<int>(arguments.size());
+
+    const bool concurrent = solution.phases && solution.phases->parse_input;
+    const unsigned jobs = concurrent ? std::max(1u, options.jobs) : 1;
+    if (!concurrent && options.jobs > 1)
+    {
+        std::cerr << "The solution reads the standard input, so the inputs are solved one at a time\n";
+    }
+
+    std::vector<Corpus_result> results(inputs.size());
+    const Clock::time_point start = Clock::now();
+    run_work_stealing(inputs.size(), jobs, [&](const std::size_t index) {
+        Corpus_result &result = results[index];
+        const Clock::time_point solve_start = Clock::now();
+        try
+        {
+            if (concurrent)
+            {
+                solve_in_memory(*solution.phases, inputs[index], argc, argv.data(), result);
+            }
+            else
+            {
+                solve_with_streams(solution, inputs[index], argc, argv.data(), result);
+            }
+        }
+        catch (const std::exception &ex)
+        {
+            result.error = ex.what();
+        }
+        result.duration = Clock::now() - solve_start;
+    });
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::size_t failures = 0;
+    std::vector<std::chrono::nanoseconds> durations;
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+    {
+        const Corpus_result &result = results[i];
+        const std::string name = inputs[i].filename().string();
+        if (!result.error.empty())
+        {
+            std::cerr << name << ": failed, " << result.error << '\n';
+            ++failures;
+            continue;
+        }
+        std::cout << name << ':';
+        for (const std::string &answer : result.answers)
+        {
+            std::cout << ' ' << answer;
+        }
+        std::cout << '\n';
+        durations.push_back(result.duration);
+    }
+
+    std::cout << std::format("Solved {} inputs in {:.3f}s on {} {}, {:.1f} inputs a second", inputs.size(),
+                             elapsed.count(), jobs, jobs == 1 ? "thread" : "threads",
+                             static_cast<double>(inputs.size()) / std::max(elapsed.count(), 1e-9));
+    if (!durations.empty())
+    {
+        const Timing_summary summary = summarize(durations);
+        std::cout << std::format(" (median {:.3f}ms, max {:.3f}ms per input)",
+                                 std::chrono::duration<double, std::milli>(summary.median).count(),
+                                 std::chrono::duration<double, std::milli>(summary.max).count());
+    }
+    std::cout << '\n';
+    if (failures != 0)
+    {
+        std::cerr << failures << " of the inputs failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+} // namespace driver
@@ -0,0 +1,32 @@
+#ifndef AOC_CORPUS_H
+#define AOC_CORPUS_H
+
+#include "platform.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+struct Corpus_options
+{
+    // Every file in the directory is an input
+    std::filesystem::path directory;
+    unsigned jobs;
+    // Passed to every solve, the first argument is the program name
+    std::vector<std::string> arguments;
+};
+
+/*
+ * Solve every input in the directory with the already loaded solution, print the answers for each input and report the
+ * throughput. Solutions that parse an input held in memory and hand their answers back through the phases are solved
+ * on a pool of threads, so they mustn't keep any state between solves. The rest read the standard input and write to
+ * the standard output, so they are solved one at a time. Returns non-zero if any input failed.
+ *
+ * The solves run in the driver's process to avoid starting a process per input, so there are no limits on them.
+ */
+int run_corpus(const Solution &solution, const Corpus_options &options);
+} // namespace driver
+
+#endif
@@ -0,0 +1,180 @@
+#include "counters.h"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(_WIN32)
+std::chrono::nanoseconds to_nanoseconds(const FILETIME &time)
+{
+    // Counted in units of 100 nanoseconds
+    const std::uint64_t ticks = (std::uint64_t{time.dwHighDateTime} << 32) | time.dwLowDateTime;
+    return std::chrono::nanoseconds(ticks * 100);
+}
+
+void read_process_counters(driver::Counter_values &values)
+{
+    FILETIME creation_time;
+    FILETIME exit_time;
+    FILETIME kernel_time;
+    FILETIME user_time;
+    if (GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+    {
+        values.user_time = to_nanoseconds(user_time);
+        values.system_time = to_nanoseconds(kernel_time);
+    }
+    PROCESS_MEMORY_COUNTERS memory{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory)))
+    {
+        values.page_faults = memory.PageFaultCount;
+    }
+}
+#else
+std::chrono::nanoseconds to_nanoseconds(const timeval &time)
+{
+    return std::chrono::seconds(time.tv_sec) + std::chrono::microseconds(time.tv_usec);
+}
+
+void read_process_counters(driver::Counter_values &values)
+{
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        values.user_time = to_nanoseconds(usage.ru_utime);
+        values.system_time = to_nanoseconds(usage.ru_stime);
+        values.page_faults = static_cast<std::uint64_t>(usage.ru_minflt + usage.ru_majflt);
+    }
+}
+
+constexpr std::uint64_t hardware_events[] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                             PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+int open_hardware_counter(const std::uint64_t event)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = event;
+    // Counting the kernel would need more privileges than we have, and it isn't the solution's time anyway
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Follows the threads the solution starts for its parts
+    attributes.inherit = 1;
+    // There may be fewer hardware counters than events, in which case they take turns and the counts are scaled up
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+std::uint64_t read_hardware_counter(const int fd)
+{
+    struct
+    {
+        std::uint64_t value;
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+    } reading{};
+    if (::read(fd, &reading, sizeof(reading)) != sizeof(reading) || reading.time_running == 0)
+    {
+        return 0;
+    }
+    if (reading.time_running == reading.time_enabled)
+    {
+        return reading.value;
+    }
+    return static_cast<std::uint64_t>(static_cast<double>(reading.value) * static_cast<double>(reading.time_enabled) /
+                                      static_cast<double>(reading.time_running));
+}
+#endif
+
+std::uint64_t get_increase(const std::uint64_t start, const std::uint64_t end)
+{
+    // Scaled counts can go down slightly between readings
+    return end > start ? end - start : 0;
+}
+} // namespace
+
+namespace driver
+{
+Counter_set::Counter_set()
+{
+#if !defined(_WIN32)
+    for (int i = 0; i < hardware_counters; ++i)
+    {
+        m_fds[i] = open_hardware_counter(hardware_events[i]);
+    }
+    // Virtual machines and locked down kernels often have none of them, the numbers only make sense together
+    m_hardware = std::ranges::none_of(m_fds, [](const int fd) { return fd == -1; });
+    for (int &fd : m_fds)
+    {
+        if (fd == -1)
+        {
+            continue;
+        }
+        if (!m_hardware)
+        {
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+Counter_set::~Counter_set()
+{
+#if !defined(_WIN32)
+    for (const int fd : m_fds)
+    {
+        if (fd != -1)
+        {
+            close(fd);
+        }
+    }
+#endif
+}
+
+Counter_values Counter_set::read() const
+{
+    Counter_values values;
+#if !defined(_WIN32)
+    if (m_hardware)
+    {
+        values.hardware = true;
+        values.cycles = read_hardware_counter(m_fds[0]);
+        values.instructions = read_hardware_counter(m_fds[1]);
+        values.cache_misses = read_hardware_counter(m_fds[2]);
+        values.branch_misses = read_hardware_counter(m_fds[3]);
+    }
+#endif
+    read_process_counters(values);
+    return values;
+}
+
+Counter_values get_counters_between(const Counter_values &start, const Counter_values &end)
+{
+    Counter_values values;
+    values.hardware = start.hardware && end.hardware;
+    values.cycles = get_increase(start.cycles, end.cycles);
+    values.instructions = get_increase(start.instructions, end.instructions);
+    values.cache_misses = get_increase(start.cache_misses, end.cache_misses);
+    values.branch_misses = get_increase(start.branch_misses, end.branch_misses);
+    values.page_faults = get_increase(start.page_faults, end.page_faults);
+    values.user_time = std::max(end.user_time - start.user_time, std::chrono::nanoseconds::zero());
+    values.system_time = std::max(end.system_time - start.system_time, std::chrono::nanoseconds::zero());
+    return values;
+}
+} // namespace driver
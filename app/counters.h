@@ -0,0 +1,83 @@
+#ifndef AOC_COUNTERS_H
+#define AOC_COUNTERS_H
+
+/*
+ * Reads the performance counters of the solution with --counters. The hardware counters come from perf_event_open on
+ * Linux, when the kernel or the machine doesn't allow them only the CPU time and page faults from getrusage are filled
+ * in. On Windows the CPU time and page faults come from the process times and memory counters instead.
+ */
+
+#include <chrono>
+#include <cstdint>
+
+namespace driver
+{
+struct Counter_values
+{
+    // Whether the hardware counters below were read, the rest is always filled in
+    bool hardware = false;
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t cache_misses = 0;
+    std::uint64_t branch_misses = 0;
+    std::uint64_t page_faults = 0;
+    std::chrono::nanoseconds user_time{};
+    std::chrono::nanoseconds system_time{};
+
+    [[nodiscard]] double get_instructions_per_cycle() const
+    {
+        return cycles == 0 ? 0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    // Misses per thousand instructions
+    [[nodiscard]] double get_cache_mpki() const
+    {
+        return instructions == 0 ? 0 : static_cast<double>(cache_misses) * 1000 / static_cast<double>(instructions);
+    }
+
+    [[nodiscard]] double get_branch_mpki() const
+    {
+        return instructions == 0 ? 0 : static_cast<double>(branch_misses) * 1000 / static_cast<double>(instructions);
+    }
+};
+
+/*
+ * The counters of a single run of the solution, the phases are only filled in for solutions exporting them
+ */
+struct Counter_profile
+{
+    Counter_values total;
+    Counter_values parse;
+    Counter_values part_one;
+    Counter_values part_two;
+    // The parts ran at the same time, so both are counted under part one
+    bool parts_combined = false;
+};
+
+/*
+ * The counters of the process, the hardware counters follow the thread that opened them and every thread it starts
+ * afterwards
+ */
+class Counter_set
+{
+private:
+    static constexpr int hardware_counters = 4;
+    int m_fds[hardware_counters] = {-1, -1, -1, -1};
+    bool m_hardware = false;
+
+public:
+    Counter_set();
+    Counter_set(const Counter_set &) = delete;
+    Counter_set &operator=(const Counter_set &) = delete;
+    ~Counter_set();
+
+    [[nodiscard]] Counter_values read() const;
+};
+
+/*
+ * What the counters went up by between the two readings
+ */
+Counter_values get_counters_between(const Counter_values &start, const Counter_values &end);
+} // namespace driver
+
+#endif
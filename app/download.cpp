@@ -0,0 +1,204 @@
+#include "download.h"
+
+#include "input_store.h"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <deque>
+#include <format>
+#include <memory>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Transfer
+{
+    std::size_t request;
+    int attempt;
+    // When the transfer may start, later than now while backing off
+    Clock::time_point start_time;
+    std::string body;
+    // Filled in by curl when the transfer fails at the transport level
+    char error[CURL_ERROR_SIZE] = {};
+};
+
+std::size_t append_body(const char *const data, const std::size_t, const std::size_t count, void *const user_data)
+{
+    static_cast<Transfer *>(user_data)->body.append(data, count);
+    return count;
+}
+
+/*
+ * Server errors and rate limiting usually clear up given some time, anything else like a missing puzzle or an expired
+ * session won't
+ */
+bool is_transient(const CURLcode code, const long response_code)
+{
+    switch (code)
+    {
+    case CURLE_OK:
+        return response_code == 429 || response_code >= 500;
+    case CURLE_COULDNT_RESOLVE_HOST:
+    case CURLE_COULDNT_CONNECT:
+    case CURLE_OPERATION_TIMEDOUT:
+    case CURLE_SEND_ERROR:
+    case CURLE_RECV_ERROR:
+    case CURLE_GOT_NOTHING:
+    case CURLE_PARTIAL_FILE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+CURL *create_handle(const driver::Download_request &request, const driver::Download_options &options,
+                    Transfer &transfer)
+{
+    CURL *const handle = curl_easy_init();
+    if (!handle)
+    {
+        return nullptr;
+    }
+    const std::string url = std::format("{}/{}/day/{}/input", options.base_url, request.year, request.day);
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(handle, CURLOPT_COOKIE, options.cookie.c_str());
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, append_body);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &transfer);
+    curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, transfer.error);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, &transfer);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    return handle;
+}
+} // namespace
+
+namespace driver
+{
+std::vector<Download_result> download_inputs(const std::span<const Download_request> requests,
+                                             const Download_options &options)
+{
+    std::vector<Download_result> results(requests.size());
+    const std::unique_ptr<CURLM, decltype(&curl_multi_cleanup)> multi(curl_multi_init(), &curl_multi_cleanup);
+    if (!multi)
+    {
+        for (Download_result &result : results)
+        {
+            result.error = "failed to create the curl multi handle";
+        }
+        return results;
+    }
+    curl_multi_setopt(multi.get(), CURLMOPT_MAX_TOTAL_CONNECTIONS, options.max_connections);
+
+    // The transfers are kept in a deque so that curl can hold on to pointers to them
+    std::deque<Transfer> transfers;
+    std::vector<Transfer *> waiting;
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        transfers.push_back({i, 1, Clock::now()});
+        waiting.push_back(&transfers.back());
+    }
+
+    int active = 0;
+    while (!waiting.empty() || active > 0)
+    {
+        // Only hand curl as many transfers as it may run, the rest wait here so their backoff is honoured
+        const Clock::time_point now = Clock::now();
+        for (auto iter = waiting.begin(); iter != waiting.end() && active < options.max_connections;)
+        {
+            Transfer &transfer = **iter;
+            if (transfer.start_time > now)
+            {
+                ++iter;
+                continue;
+            }
+
+            iter = waiting.erase(iter);
+            CURL *const handle = create_handle(requests[transfer.request], options, transfer);
+            if (!handle || curl_multi_add_handle(multi.get(), handle) != CURLM_OK)
+            {
+                curl_easy_cleanup(handle);
+                results[transfer.request].error = "failed to start the transfer";
+                continue;
+            }
+            ++active;
+        }
+
+        int running;
+        if (const CURLMcode code = curl_multi_perform(multi.get(), &running); code != CURLM_OK)
+        {
+            for (Download_result &result : results)
+            {
+                if (!result.success && result.error.empty())
+                {
+                    result.error = curl_multi_strerror(code);
+                }
+            }
+            break;
+        }
+
+        int messages;
+        while (CURLMsg *const message = curl_multi_info_read(multi.get(), &messages))
+        {
+            if (message->msg != CURLMSG_DONE)
+            {
+                continue;
+            }
+
+            CURL *const handle = message->easy_handle;
+            const CURLcode code = message->data.result;
+            Transfer *transfer;
+            curl_easy_getinfo(handle, CURLINFO_PRIVATE, &transfer);
+            long response_code = 0;
+            curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
+            curl_multi_remove_handle(multi.get(), handle);
+            curl_easy_cleanup(handle);
+            --active;
+
+            const Download_request &request = requests[transfer->request];
+            Download_result &result = results[transfer->request];
+            if (code == CURLE_OK && response_code == 200)
+            {
+                result.error.clear();
+                result.hash = hash_contents(transfer->body);
+                result.success = write_file_atomically(request.path, transfer->body, result.error);
+                transfer->body = std::string();
+                continue;
+            }
+
+            result.error = code != CURLE_OK ? std::format("{} ({})", curl_easy_strerror(code), transfer->error)
+                                            : std::format("unexpected HTTP response code {}: {}", response_code,
+                                                          transfer->body);
+            if (is_transient(code, response_code) && transfer->attempt < options.max_attempts)
+            {
+                transfer->start_time = Clock::now() + options.initial_backoff * (1 << (transfer->attempt - 1));
+                ++transfer->attempt;
+                transfer->body.clear();
+                transfer->error[0] = '\0';
+                waiting.push_back(transfer);
+            }
+        }
+
+        if (active == 0 && waiting.empty())
+        {
+            break;
+        }
+
+        // Wake up for whichever comes first, activity on the transfers or the end of a backoff
+        auto timeout = std::chrono::milliseconds(1000);
+        if (active < options.max_connections)
+        {
+            for (const Transfer *const transfer : waiting)
+            {
+                timeout = std::min(timeout, std::chrono::ceil<std::chrono::milliseconds>(transfer->start_time -
+                                                                                          Clock::now()));
+            }
+        }
+        if (timeout.count() > 0)
+        {
+            curl_multi_poll(multi.get(), nullptr, 0, static_cast<int>(timeout.count()), nullptr);
+        }
+    }
+    return results;
+}
+} // namespace driver
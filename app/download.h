@@ -0,0 +1,51 @@
+#ifndef AOC_DOWNLOAD_H
+#define AOC_DOWNLOAD_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+struct Download_request
+{
+    int year;
+    int day;
+    // Where to write the input, the directories must already exist
+    std::filesystem::path path;
+};
+
+struct Download_options
+{
+    // Everything before the "/<year>/day/<day>/input" part of the URL
+    std::string base_url = "https://adventofcode.com";
+    // Sent as the Cookie header, e.g. "session=..."
+    std::string cookie;
+    // Maximum number of transfers in flight at once
+    long max_connections = 4;
+    // Number of tries for each input, only failures that might go away on their own are retried
+    int max_attempts = 4;
+    // The delay before the first retry, doubled for every retry after that
+    std::chrono::milliseconds initial_backoff{1000};
+};
+
+struct Download_result
+{
+    bool success = false;
+    // Hash of the contents that were written, see hash_contents
+    std::uint64_t hash = 0;
+    std::string error;
+};
+
+/*
+ * Download the inputs concurrently, each input is written to a temporary file next to its path and renamed into place
+ * once it is complete. The results are in the same order as the requests.
+ */
+std::vector<Download_result> download_inputs(std::span<const Download_request> requests,
+                                             const Download_options &options);
+} // namespace driver
+
+#endif
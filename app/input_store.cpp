@@ -0,0 +1,297 @@
+#include "input_store.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include <cstring>
+
+namespace
+{
+constexpr const char *index_filename = "input_hashes.txt";
+
+constexpr std::uint64_t prime_1 = 0x9e3779b185ebca87;
+constexpr std::uint64_t prime_2 = 0xc2b2ae3d27d4eb4f;
+constexpr std::uint64_t prime_3 = 0x165667b19e3779f9;
+constexpr std::uint64_t prime_4 = 0x85ebca77c2b2ae63;
+constexpr std::uint64_t prime_5 = 0x27d4eb2f165667c5;
+
+// XXH64 reads the input as little endian words
+static_assert(std::endian::native == std::endian::little);
+
+std::uint64_t read_u64(const unsigned char *const data)
+{
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::uint32_t read_u32(const unsigned char *const data)
+{
+    std::uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+std::uint64_t mix_lane(std::uint64_t lane, const std::uint64_t input)
+{
+    lane += input * prime_2;
+    lane = std::rotl(lane, 31);
+    return lane * prime_1;
+}
+
+std::uint64_t merge_lane(std::uint64_t hash, const std::uint64_t lane)
+{
+    hash ^= mix_lane(0, lane);
+    return hash * prime_1 + prime_4;
+}
+
+void mix_block(std::uint64_t (&lanes)[4], const unsigned char *const block)
+{
+    // The lanes don't depend on each other, so the multiplies overlap
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        lanes[i] = mix_lane(lanes[i], read_u64(block + i * 8));
+    }
+}
+
+std::int64_t get_modified_time(const std::filesystem::path &path, std::error_code &error)
+{
+    return std::filesystem::last_write_time(path, error).time_since_epoch().count();
+}
+} // namespace
+
+namespace driver
+{
+std::uint64_t hash_contents(const std::string_view contents)
+{
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (const char c : contents)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+Stream_hash::Stream_hash() : m_lanes{prime_1 + prime_2, prime_2, 0, 0 - prime_1}, m_pending{}
+{
+}
+
+void Stream_hash::update(const std::string_view data)
+{
+    const auto *bytes = reinterpret_cast<const unsigned char *>(data.data());
+    std::size_t size = data.size();
+    m_total_size += size;
+
+    if (m_pending_size != 0)
+    {
+        const std::size_t taken = std::min(size, sizeof(m_pending) - m_pending_size);
+        std::memcpy(m_pending + m_pending_size, bytes, taken);
+        m_pending_size += taken;
+        bytes += taken;
+        size -= taken;
+        if (m_pending_size < sizeof(m_pending))
+        {
+            return;
+        }
+        mix_block(m_lanes, m_pending);
+        m_pending_size = 0;
+    }
+
+    for (; size >= sizeof(m_pending); bytes += sizeof(m_pending), size -= sizeof(m_pending))
+    {
+        mix_block(m_lanes, bytes);
+    }
+    std::memcpy(m_pending, bytes, size);
+    m_pending_size = size;
+}
+
+std::uint64_t Stream_hash::finish() const
+{
+    std::uint64_t hash;
+    if (m_total_size >= sizeof(m_pending))
+    {
+        hash = std::rotl(m_lanes[0], 1) + std::rotl(m_lanes[1], 7) + std::rotl(m_lanes[2], 12) +
+               std::rotl(m_lanes[3], 18);
+        for (const std::uint64_t lane : m_lanes)
+        {
+            hash = merge_lane(hash, lane);
+        }
+    }
+    else
+    {
+        hash = prime_5;
+    }
+    hash += m_total_size;
+
+    const unsigned char *tail = m_pending;
+    std::size_t size = m_pending_size;
+    for (; size >= 8; tail += 8, size -= 8)
+    {
+        hash ^= mix_lane(0, read_u64(tail));
+        hash = std::rotl(hash, 27) * prime_1 + prime_4;
+    }
+    if (size >= 4)
+    {
+        hash ^= read_u32(tail) * prime_1;
+        hash = std::rotl(hash, 23) * prime_2 + prime_3;
+        tail += 4;
+        size -= 4;
+    }
+    for (; size > 0; ++tail, --size)
+    {
+        hash ^= *tail * prime_5;
+        hash = std::rotl(hash, 11) * prime_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    hash *= prime_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::optional<std::uint64_t> stream_hash_file(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    Stream_hash hash;
+    std::vector<char> buffer(1 << 16);
+    while (file)
+    {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash.update({buffer.data(), static_cast<std::size_t>(file.gcount())});
+    }
+    if (file.bad())
+    {
+        return std::nullopt;
+    }
+    return hash.finish();
+}
+
+std::optional<std::uint64_t> hash_file(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios_base::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (!file)
+    {
+        return std::nullopt;
+    }
+    return hash_contents(contents.view());
+}
+
+bool write_file_atomically(const std::filesystem::path &path, const std::string_view contents, std::string &error)
+{
+    // The temporary file has to be on the same file system for the rename to be atomic, so put it next to the target
+    std::random_device random;
+    std::filesystem::path temporary_path = path;
+    temporary_path += std::format(".{:08x}.tmp", random());
+
+    {
+        std::ofstream file(temporary_path, std::ios_base::binary);
+        if (!file)
+        {
+            error = std::format("failed to open {} for writing", temporary_path.string());
+            return false;
+        }
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        file.close();
+        if (!file)
+        {
+            error = std::format("failed to write {}", temporary_path.string());
+            std::filesystem::remove(temporary_path);
+            return false;
+        }
+    }
+
+    std::error_code rename_error;
+    std::filesystem::rename(temporary_path, path, rename_error);
+    if (rename_error)
+    {
+        error = std::format("failed to rename {} to {}: {}", temporary_path.string(), path.string(),
+                            rename_error.message());
+        std::filesystem::remove(temporary_path, rename_error);
+        return false;
+    }
+    return true;
+}
+
+Input_index Input_index::load(const std::filesystem::path &data_directory)
+{
+    Input_index index;
+    index.m_path = data_directory / index_filename;
+
+    // One "year day size modified hash" line per input
+    std::ifstream file(index.m_path);
+    for (std::string line; std::getline(file, line);)
+    {
+        std::istringstream stream(line);
+        int year;
+        int day;
+        Record record;
+        if (stream >> year >> day >> record.size >> record.modified >> std::hex >> record.hash)
+        {
+            index.m_records[{year, day}] = record;
+        }
+    }
+    return index;
+}
+
+void Input_index::record(const int year, const int day, const std::filesystem::path &input_path,
+                         const std::uint64_t hash)
+{
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(input_path, error);
+    const std::int64_t modified = get_modified_time(input_path, error);
+    if (error)
+    {
+        m_records.erase({year, day});
+        return;
+    }
+    m_records[{year, day}] = {hash, size, modified};
+}
+
+Input_check Input_index::check(const int year, const int day, const std::filesystem::path &input_path) const
+{
+    const auto iter = m_records.find({year, day});
+    if (iter == m_records.end())
+    {
+        return Input_check::unknown;
+    }
+
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(input_path, error);
+    const std::int64_t modified = get_modified_time(input_path, error);
+    if (error || size != iter->second.size || modified != iter->second.modified)
+    {
+        return Input_check::modified;
+    }
+    return Input_check::unchanged;
+}
+
+bool Input_index::save(std::string &error) const
+{
+    std::string contents;
+    for (const auto &[key, record] : m_records)
+    {
+        contents += std::format("{} {} {} {} {:016x}\n", key.first, key.second, record.size, record.modified,
+                                record.hash);
+    }
+    return write_file_atomically(m_path, contents, error);
+}
+} // namespace driver
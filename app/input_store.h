@@ -0,0 +1,99 @@
+#ifndef AOC_INPUT_STORE_H
+#define AOC_INPUT_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace driver
+{
+/*
+ * 64-bit FNV-1a, it only needs to notice accidental changes to the inputs
+ */
+std::uint64_t hash_contents(std::string_view contents);
+
+/*
+ * Hash the contents of a file, returns an empty optional if it can't be read
+ */
+std::optional<std::uint64_t> hash_file(const std::filesystem::path &path);
+
+/*
+ * XXH64 with a seed of zero, fed a piece at a time. It works through 32 bytes at a time in four independent lanes, so
+ * it runs several times faster than FNV-1a on large files. FNV-1a is kept for the hashes already recorded in the
+ * histories and the input index.
+ */
+class Stream_hash
+{
+private:
+    std::uint64_t m_lanes[4];
+    // The start of the next block, until all 32 bytes of it have arrived
+    unsigned char m_pending[32];
+    std::size_t m_pending_size = 0;
+    std::uint64_t m_total_size = 0;
+
+public:
+    Stream_hash();
+
+    void update(std::string_view data);
+
+    [[nodiscard]] std::uint64_t finish() const;
+};
+
+/*
+ * Stream_hash of the contents of a file, read a block at a time. Returns an empty optional if it can't be read.
+ */
+std::optional<std::uint64_t> stream_hash_file(const std::filesystem::path &path);
+
+/*
+ * Write the file so that anyone reading it sees either the old or the new contents but never part of them
+ */
+bool write_file_atomically(const std::filesystem::path &path, std::string_view contents, std::string &error);
+
+enum class Input_check
+{
+    // Nothing was recorded for the input, e.g. it was copied in by hand
+    unknown,
+    unchanged,
+    modified
+};
+
+/*
+ * The hash of every input that was downloaded into the data directory along with the size and modification time of
+ * the file. Checking an input only compares the size and time, so the file doesn't have to be read again.
+ */
+class Input_index
+{
+private:
+    struct Record
+    {
+        std::uint64_t hash;
+        std::uintmax_t size;
+        std::int64_t modified;
+    };
+
+    std::filesystem::path m_path;
+    std::map<std::pair<int, int>, Record> m_records;
+
+public:
+    /*
+     * Read the index from the data directory, a missing index is treated as empty
+     */
+    static Input_index load(const std::filesystem::path &data_directory);
+
+    /*
+     * Remember the input that was just written to the path
+     */
+    void record(int year, int day, const std::filesystem::path &input_path, std::uint64_t hash);
+
+    [[nodiscard]] Input_check check(int year, int day, const std::filesystem::path &input_path) const;
+
+    bool save(std::string &error) const;
+};
+} // namespace driver
+
+#endif
@@ -0,0 +1,140 @@
+#include "json.h"
+
+#include <format>
+
+namespace
+{
+void append_string(std::string &output, const std::string_view text)
+{
+    output += '"';
+    for (const char ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            output += "\\\"";
+            break;
+        case '\\':
+            output += "\\\\";
+            break;
+        case '\n':
+            output += "\\n";
+            break;
+        case '\r':
+            output += "\\r";
+            break;
+        case '\t':
+            output += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                output += std::format("\\u{:04x}", static_cast<unsigned>(ch));
+            }
+            else
+            {
+                output += ch;
+            }
+            break;
+        }
+    }
+    output += '"';
+}
+} // namespace
+
+namespace driver
+{
+void Json_writer::begin_value()
+{
+    if (m_after_key)
+    {
+        m_after_key = false;
+        return;
+    }
+    if (!m_has_element.empty())
+    {
+        if (m_has_element.back())
+        {
+            m_output += ',';
+        }
+        m_has_element.back() = true;
+    }
+}
+
+Json_writer &Json_writer::begin_object()
+{
+    begin_value();
+    m_output += '{';
+    m_has_element.push_back(false);
+    return *this;
+}
+
+Json_writer &Json_writer::end_object()
+{
+    m_output += '}';
+    m_has_element.pop_back();
+    return *this;
+}
+
+Json_writer &Json_writer::begin_array()
+{
+    begin_value();
+    m_output += '[';
+    m_has_element.push_back(false);
+    return *this;
+}
+
+Json_writer &Json_writer::end_array()
+{
+    m_output += ']';
+    m_has_element.pop_back();
+    return *this;
+}
+
+Json_writer &Json_writer::key(const std::string_view name)
+{
+    begin_value();
+    append_string(m_output, name);
+    m_output += ':';
+    m_after_key = true;
+    return *this;
+}
+
+Json_writer &Json_writer::value(const std::string_view text)
+{
+    begin_value();
+    append_string(m_output, text);
+    return *this;
+}
+
+Json_writer &Json_writer::value(const char *const text)
+{
+    return value(std::string_view(text));
+}
+
+Json_writer &Json_writer::value(const std::int64_t number)
+{
+    begin_value();
+    m_output += std::to_string(number);
+    return *this;
+}
+
+Json_writer &Json_writer::value(const double number)
+{
+    begin_value();
+    m_output += std::format("{}", number);
+    return *this;
+}
+
+Json_writer &Json_writer::value(const bool boolean)
+{
+    begin_value();
+    m_output += boolean ? "true" : "false";
+    return *this;
+}
+
+const std::string &Json_writer::str() const
+{
+    return m_output;
+}
+} // namespace driver
@@ -0,0 +1,48 @@
+#ifndef AOC_JSON_H
+#define AOC_JSON_H
+
+#include <concepts>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace driver
+{
+/*
+ * Builds compact JSON text, the caller is responsible for balancing the objects and arrays
+ */
+class Json_writer
+{
+private:
+    std::string m_output;
+    // Whether each of the open containers already has an element, so we know when to add a comma
+    std::vector<bool> m_has_element;
+    bool m_after_key = false;
+
+    void begin_value();
+
+public:
+    Json_writer &begin_object();
+    Json_writer &end_object();
+    Json_writer &begin_array();
+    Json_writer &end_array();
+    Json_writer &key(std::string_view name);
+    Json_writer &value(std::string_view text);
+    Json_writer &value(const char *text);
+    Json_writer &value(std::int64_t number);
+    Json_writer &value(double number);
+    Json_writer &value(bool boolean);
+
+    template <std::integral T>
+        requires(!std::same_as<T, bool>)
+    Json_writer &value(const T number)
+    {
+        return value(static_cast<std::int64_t>(number));
+    }
+
+    [[nodiscard]] const std::string &str() const;
+};
+} // namespace driver
+
+#endif
@@ -0,0 +1,29 @@
+#include "layout.h"
+
+#include "platform.h"
+
+#include <format>
+#include <string>
+
+namespace driver
+{
+int get_number_of_days(const int year)
+{
+    return year >= 2025 ? 12 : 25;
+}
+
+std::filesystem::path get_module_path(const std::filesystem::path &exe_directory, const int year, const int day)
+{
+    return exe_directory / std::to_string(year) / std::format("day{:02}{}", day, module_extension);
+}
+
+std::filesystem::path get_test_module_path(const std::filesystem::path &exe_directory, const int year, const int day)
+{
+    return exe_directory / std::to_string(year) / std::format("day{:02}_test{}", day, module_extension);
+}
+
+std::filesystem::path get_input_path(const std::filesystem::path &data_directory, const int year, const int day)
+{
+    return data_directory / std::to_string(year) / "day" / std::to_string(day) / "input.txt";
+}
+} // namespace driver
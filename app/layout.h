@@ -0,0 +1,33 @@
+#ifndef AOC_LAYOUT_H
+#define AOC_LAYOUT_H
+
+#include <filesystem>
+
+namespace driver
+{
+inline constexpr int first_year = 2015;
+inline constexpr int last_year = 2025;
+
+/*
+ * The number of puzzles released in the year, from 2025 onwards there are only 12 days
+ */
+int get_number_of_days(int year);
+
+/*
+ * The solution modules are placed in a directory for each year next to the driver
+ */
+std::filesystem::path get_module_path(const std::filesystem::path &exe_directory, int year, int day);
+
+/*
+ * The tests of each day are built into a companion module next to the solution's, so runs that skip the tests don't
+ * load Catch2
+ */
+std::filesystem::path get_test_module_path(const std::filesystem::path &exe_directory, int year, int day);
+
+/*
+ * The inputs are stored using the same layout as the Advent of Code website
+ */
+std::filesystem::path get_input_path(const std::filesystem::path &data_directory, int year, int day);
+} // namespace driver
+
+#endif
@@ -0,0 +1,144 @@
+#include "loader.h"
+
+#include "layout.h"
+
+#if defined(AOC_STATIC_BUILD)
+#include "static_registry.h"
+
+#include <algorithm>
+#include <format>
+
+extern "C"
+{
+    void aoc_static_no_solve_input(const Aoc_input *, int, char **)
+    {
+    }
+
+    const Aoc_phases *aoc_static_no_phases()
+    {
+        return nullptr;
+    }
+}
+
+namespace
+{
+const driver::Static_solution *find_static_solution(const int year, const int day)
+{
+    const std::span<const driver::Static_solution> solutions = driver::get_static_solutions();
+    const auto iter = std::ranges::find_if(solutions, [year, day](const driver::Static_solution &solution) {
+        return solution.year == year && solution.day == day;
+    });
+    return iter != solutions.end() ? &*iter : nullptr;
+}
+} // namespace
+
+namespace driver
+{
+bool has_day(const std::filesystem::path &, const int year, const int day)
+{
+    return find_static_solution(year, day) != nullptr;
+}
+
+std::optional<Loaded_day> load_day(const std::filesystem::path &, const int year, const int day, std::string &error)
+{
+    const Static_solution *const solution = find_static_solution(year, day);
+    if (!solution)
+    {
+        error = std::format("{} day {} wasn't linked into the driver", year, day);
+        return std::nullopt;
+    }
+
+    // The tests are compiled out of the static build
+    Loaded_day loaded;
+    loaded.binary_path = get_executable_path();
+    loaded.solution.solve = solution->solve;
+    loaded.solution.set_stop_token = solution->set_stop_token;
+    loaded.solution.set_tracer = solution->set_tracer;
+    loaded.solution.set_logger = solution->set_logger;
+    loaded.solution.set_answer_sink = solution->set_answer_sink;
+    loaded.solution.solve_input = solution->solve_input;
+    loaded.solution.phases = solution->phases ? solution->phases() : nullptr;
+    return loaded;
+}
+
+bool load_tests(const std::filesystem::path &, int, int, Loaded_day &, std::string &)
+{
+    return true;
+}
+} // namespace driver
+#else
+namespace driver
+{
+bool has_day(const std::filesystem::path &exe_directory, const int year, const int day)
+{
+    return exists(get_module_path(exe_directory, year, day));
+}
+
+std::optional<Loaded_day> load_day(const std::filesystem::path &exe_directory, const int year, const int day,
+                                   std::string &error)
+{
+    const std::filesystem::path module_path = get_module_path(exe_directory, year, day);
+    if (!exists(module_path))
+    {
+        error = "failed to find " + module_path.string();
+        return std::nullopt;
+    }
+
+    Loaded_day loaded;
+    loaded.binary_path = module_path;
+    loaded.module = Module::load(module_path, error);
+    if (!loaded.module)
+    {
+        error = "failed to open module: " + error;
+        return std::nullopt;
+    }
+
+    loaded.solution = loaded.module->get_solution();
+    // This should always exist, so something has gone wrong
+    if (!loaded.solution.solve)
+    {
+        error = "failed to load 'solve' function from module";
+        return std::nullopt;
+    }
+    return loaded;
+}
+
+bool load_tests(const std::filesystem::path &exe_directory, const int year, const int day, Loaded_day &loaded,
+                std::string &error)
+{
+    const std::filesystem::path test_module_path = get_test_module_path(exe_directory, year, day);
+    if (!exists(test_module_path))
+    {
+        // Modules built before the tests had their own still export them
+        loaded.test = loaded.module->get<Aoc_test_function>("test");
+        loaded.test_solution = loaded.solution;
+        return true;
+    }
+
+    loaded.test_module = Module::load(test_module_path, error);
+    if (!loaded.test_module)
+    {
+        error = "failed to open the tests' module: " + error;
+        return false;
+    }
+    loaded.test = loaded.test_module->get<Aoc_test_function>("test");
+    if (!loaded.test)
+    {
+        error = "failed to load 'test' function from the tests' module";
+        return false;
+    }
+    loaded.test_solution = loaded.test_module->get_solution();
+    return true;
+}
+} // namespace driver
+#endif
+
+namespace driver
+{
+void unload_tests(Loaded_day &loaded)
+{
+    loaded.test = nullptr;
+    loaded.test_solution = {};
+    loaded.test_module.reset();
+}
+} // namespace driver
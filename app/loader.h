@@ -0,0 +1,54 @@
+#ifndef AOC_LOADER_H
+#define AOC_LOADER_H
+
+#include "platform.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace driver
+{
+/*
+ * Everything needed to run a day, the module stays loaded for as long as this is alive
+ */
+struct Loaded_day
+{
+    // Empty in the static build, the solutions are linked into the driver
+    std::optional<Module> module;
+    // The file the solution was loaded from, the driver itself in the static build
+    std::filesystem::path binary_path;
+    Solution solution;
+    // Only loaded by load_tests, it has its own copy of the solution so it can be unloaded once the tests have run
+    std::optional<Module> test_module;
+    // The logging and tracing of the tests go through the copy of the solution in the tests' module
+    Solution test_solution;
+    // Null until load_tests has found the tests
+    Aoc_test_function test = nullptr;
+};
+
+/*
+ * Whether there is a solution for the day, without loading it
+ */
+bool has_day(const std::filesystem::path &exe_directory, int year, int day);
+
+/*
+ * Find the solution for the day, either by loading its module from next to the driver or in the static build by looking
+ * it up in the solutions that were linked in. On failure returns an empty optional and sets the error message.
+ */
+std::optional<Loaded_day> load_day(const std::filesystem::path &exe_directory, int year, int day, std::string &error);
+
+/*
+ * Load the module with the tests of the day, so runs that skip the tests never load Catch2. Finding no tests isn't an
+ * error, e.g. in the static build they are compiled out, and test is left null. Returns false and sets the error
+ * message if the tests' module exists but can't be loaded.
+ */
+bool load_tests(const std::filesystem::path &exe_directory, int year, int day, Loaded_day &loaded, std::string &error);
+
+/*
+ * Unload the tests' module once the tests have run, the solution stays loaded
+ */
+void unload_tests(Loaded_day &loaded);
+} // namespace driver
+
+#endif
@@ -0,0 +1,171 @@
+#include "logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <cstring>
+
+namespace
+{
+// The solutions cut their lines shorter than this, see aoc::detail::max_log_length
+constexpr std::size_t max_line_length = 256;
+constexpr std::size_t queue_capacity = 4096;
+static_assert(std::has_single_bit(queue_capacity));
+
+/*
+ * A bounded queue for any number of producers and a single consumer. Every slot has a sequence number telling whose
+ * turn it is, a producer claims a slot by moving the tail past it and publishes it by bumping its sequence, and the
+ * consumer gives it back by moving the sequence a lap ahead.
+ */
+class Log_queue
+{
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        std::size_t size;
+        char text[max_line_length];
+    };
+
+    std::unique_ptr<Slot[]> m_slots = std::make_unique<Slot[]>(queue_capacity);
+    // Kept apart so the producers and the consumer don't fight over the cache line
+    alignas(64) std::atomic<std::uint64_t> m_tail = 0;
+    alignas(64) std::uint64_t m_head = 0;
+    std::atomic<std::uint64_t> m_dropped = 0;
+
+public:
+    Log_queue()
+    {
+        for (std::uint64_t i = 0; i < queue_capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    void push(const char *const text, const std::size_t size)
+    {
+        std::uint64_t position = m_tail.load(std::memory_order_relaxed);
+        Slot *slot = nullptr;
+        while (true)
+        {
+            slot = &m_slots[position % queue_capacity];
+            const std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            if (sequence == position)
+            {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (sequence < position)
+            {
+                // The consumer hasn't given the slot back from the previous lap yet, so the queue is full
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->size = std::min(size, max_line_length);
+        std::memcpy(slot->text, text, slot->size);
+        slot->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    /*
+     * Hands the oldest line to the function and frees its slot, returns false if the queue is empty
+     */
+    template <typename F> bool pop(F f)
+    {
+        Slot &slot = m_slots[m_head % queue_capacity];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+        {
+            return false;
+        }
+        f(slot.text, slot.size);
+        slot.sequence.store(m_head + queue_capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+    [[nodiscard]] std::uint64_t dropped() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+};
+
+std::unique_ptr<Log_queue> s_queue;
+std::jthread s_writer;
+Aoc_logger s_logger{};
+
+void queue_line(void *const context, const char *const text, const std::size_t size)
+{
+    static_cast<Log_queue *>(context)->push(text, size);
+}
+
+/*
+ * Writes the lines as they come in, only flushing once it has caught up
+ */
+void write_lines(const std::stop_token &stop, Log_queue &queue)
+{
+    const auto write_line = [](const char *const text, const std::size_t size) {
+        std::clog.write(text, static_cast<std::streamsize>(size));
+        std::clog.put('\n');
+    };
+    while (true)
+    {
+        if (queue.pop(write_line))
+        {
+            continue;
+        }
+        std::clog.flush();
+        // Checked after the queue was found empty so nothing pushed before stopping is left behind
+        if (stop.stop_requested())
+        {
+            while (queue.pop(write_line))
+            {
+            }
+            std::clog.flush();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+} // namespace
+
+namespace driver
+{
+void start_logging()
+{
+    s_queue = std::make_unique<Log_queue>();
+    s_logger = {s_queue.get(), &queue_line};
+    s_writer = std::jthread([queue = s_queue.get()](const std::stop_token &stop) { write_lines(stop, *queue); });
+}
+
+void stop_logging()
+{
+    if (!s_queue)
+    {
+        return;
+    }
+    s_writer.request_stop();
+    s_writer.join();
+    if (const std::uint64_t dropped = s_queue->dropped(); dropped != 0)
+    {
+        std::clog << dropped << " log lines were dropped, the output couldn't keep up" << std::endl;
+    }
+    s_logger = {};
+    s_queue.reset();
+}
+
+const Aoc_logger &get_logger()
+{
+    return s_logger;
+}
+} // namespace driver
@@ -0,0 +1,29 @@
+#ifndef AOC_LOGGING_H
+#define AOC_LOGGING_H
+
+#include "aoc_abi.h"
+
+namespace driver
+{
+/*
+ * The log lines of the solutions go through a bounded queue to a writer thread, which writes them to std::clog. The
+ * solution never waits on the writer, when the queue is full the line is dropped and counted.
+ */
+
+/*
+ * Start the writer thread. Nothing may be logging at the time.
+ */
+void start_logging();
+
+/*
+ * Write out what is left in the queue, then stop the writer thread and report how many lines were dropped
+ */
+void stop_logging();
+
+/*
+ * The logger handed to the solutions, it queues the lines for the writer thread
+ */
+const Aoc_logger &get_logger();
+} // namespace driver
+
+#endif
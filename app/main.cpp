@@ -1,149 +1,150 @@
-// clang-format off
-// Clang format wants to move cxxopts include after curl include, but that breaks compilation at the moment.
 #include <cxxopts.hpp>
-// clang-format on
-#include <curl/curl.h>
 
+#include "batch.h"
+#include "bench.h"
+#include "bench_history.h"
+#include "compare.h"
+#include "corpus.h"
+#include "download.h"
+#include "input_store.h"
+#include "layout.h"
+#include "loader.h"
+#include "platform.h"
+#include "result_cache.h"
+#include "scaling.h"
+#include "solve_loop.h"
+#if !defined(_WIN32)
+#include "server.h"
+#endif
+
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <format>
 #include <fstream>
-#include <future>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
 
-#include <cassert>
-#include <cstdio>
+#include <cstdint>
 #include <cstdlib>
-#include <cstring>
-
-#include <windows.h>
-
-using namespace std::chrono_literals;
 
 namespace
 {
-std::size_t write_data(const void *const ptr, const std::size_t, const std::size_t count, void *stream)
-{
-    std::string &data = *static_cast<std::string *>(stream);
-    const char *const char_ptr = static_cast<const char *>(ptr);
-    data.insert(data.size(), char_ptr, count);
-    return count;
-}
-
-bool download_data(const std::string &year, const std::string &day, const std::filesystem::path &path,
-                   const std::string &cookie)
+/*
+ * Download every missing input of the selected years into the data directory and record their hashes
+ */
+int prefetch_inputs(const std::filesystem::path &data_directory, const std::vector<int> &years,
+                    const driver::Download_options &download_options)
 {
-    CURL *const curl = curl_easy_init();
-    if (!curl)
-    {
-        std::cerr << "Failed to create curl handle\n";
-        return false;
-    }
-    const std::string url = std::format("https://adventofcode.com/{}/day/{}/input", year, day);
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
-    curl_easy_setopt(curl, CURLOPT_COOKIE, cookie.c_str());
-    std::string response_data;
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_data);
-    const CURLcode result = curl_easy_perform(curl);
-    bool success = false;
-    if (result == CURLE_OK)
-    {
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &result);
-        if (result == 200)
+    std::vector<driver::Download_request> requests;
+    for (const int year : years)
+    {
+        for (int day = 1; day <= driver::get_number_of_days(year); ++day)
         {
-            std::ofstream file(path);
-            if (file)
+            const std::filesystem::path path = driver::get_input_path(data_directory, year, day);
+            if (!exists(path))
             {
-                file << response_data;
-                file.flush();
-                success = file.good();
-                file.close();
-            }
-            else
-            {
-                std::cerr << "Failed to open " << path << " for writing\n";
+                create_directories(path.parent_path());
+                requests.push_back({year, day, path});
             }
         }
+    }
+
+    const std::vector<driver::Download_result> results = driver::download_inputs(requests, download_options);
+    driver::Input_index index = driver::Input_index::load(data_directory);
+    int failures = 0;
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const driver::Download_request &request = requests[i];
+        if (results[i].success)
+        {
+            index.record(request.year, request.day, request.path, results[i].hash);
+        }
         else
         {
-            std::cerr << "Unexpected HTTP response code: " << result << '\n';
-            std::cerr << "Response data:\n" << response_data << '\n';
+            std::cerr << std::format("Failed to download {} day {}: {}\n", request.year, request.day,
+                                     results[i].error);
+            ++failures;
         }
     }
-    else
+
+    std::string error;
+    if (!index.save(error))
     {
-        std::cerr << "curl_easy_perform() failed: " << curl_easy_strerror(result) << '\n';
+        std::cerr << "Failed to save the input hashes: " << error << '\n';
+        return EXIT_FAILURE;
     }
-
-    curl_easy_cleanup(curl);
-    return success;
+    std::cout << std::format("Downloaded {} of {} missing inputs\n", requests.size() - failures, requests.size());
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
-template <typename T> T get_proc_address(const HMODULE module, const char *const proc_name)
+std::string format_milliseconds(const std::chrono::nanoseconds duration)
 {
-    return reinterpret_cast<T>(reinterpret_cast<void *>(GetProcAddress(module, proc_name)));
+    return std::format("{:.3f}ms", std::chrono::duration<double, std::milli>(duration).count());
 }
 
-using SolveFunction = void (*)(int, char **);
-using TestFunction = bool (*)(int, char **);
+std::string format_bytes(const std::uint64_t bytes)
+{
+    if (bytes < 1024)
+    {
+        return std::format("{}B", bytes);
+    }
+    if (bytes < 1024 * 1024)
+    {
+        return std::format("{:.1f}KB", static_cast<double>(bytes) / 1024);
+    }
+    return std::format("{:.1f}MB", static_cast<double>(bytes) / (1024 * 1024));
+}
 
-/*
- * Run solution in a separate thread with timeout
- *
- * Returns true if the function completed within the timeout, false if it timed out
- */
-bool run_solution(const SolveFunction solve_fn, const int argc, char **argv, const std::chrono::milliseconds timeout)
+std::string format_allocations(const driver::Allocation_stats &stats)
 {
-    // C++ std::async/std::future does not support timeouts directly, so we need to implement it ourselves
-    std::thread worker(solve_fn, argc, argv);
+    return std::format("{} allocations of {} (peak {})", stats.count, format_bytes(stats.bytes),
+                       format_bytes(stats.peak_bytes));
+}
 
-    const HANDLE thread_handle = worker.native_handle();
-    const DWORD wait_milliseconds = static_cast<DWORD>(timeout.count());
-    const DWORD wait_result = WaitForSingleObject(thread_handle, wait_milliseconds);
-    if (wait_result == WAIT_OBJECT_0)
+std::string format_count(const std::uint64_t count)
+{
+    if (count < 10'000)
     {
-        worker.join();
-        return true;
+        return std::format("{}", count);
     }
-
-    assert(wait_result == WAIT_TIMEOUT);
-    if (wait_result != WAIT_TIMEOUT)
+    if (count < 10'000'000)
     {
-        throw std::logic_error("Unexpected result from WaitForSingleObject");
+        return std::format("{:.1f}K", static_cast<double>(count) / 1e3);
     }
-
-    // Don't terminate the thread if a debugger is attached
-    if (IsDebuggerPresent())
+    if (count < 10'000'000'000)
     {
-        worker.join();
-        return true;
+        return std::format("{:.1f}M", static_cast<double>(count) / 1e6);
     }
+    return std::format("{:.1f}G", static_cast<double>(count) / 1e9);
+}
 
-    // Timed out - terminate the thread. We're not too concerned about resource leaks here since the whole process will
-    // exit soon after If we did, we'd need to either design the solution functions to be cancellable, or run them in a
-    // separate process
-    if (!TerminateThread(thread_handle, 1))
+std::string format_counters(const driver::Counter_values &values)
+{
+    std::string text;
+    if (values.hardware)
     {
-        throw std::logic_error("Failed to terminate thread");
+        text = std::format("{} cycles, {} instructions (IPC {:.2f}), {} cache misses ({:.2f} MPKI), {} branch misses "
+                           "({:.2f} MPKI), ",
+                           format_count(values.cycles), format_count(values.instructions),
+                           values.get_instructions_per_cycle(), format_count(values.cache_misses),
+                           values.get_cache_mpki(), format_count(values.branch_misses), values.get_branch_mpki());
     }
-    worker.join();
-    return false;
+    text += std::format("{} user, {} system, {} page faults", format_milliseconds(values.user_time),
+                        format_milliseconds(values.system_time), format_count(values.page_faults));
+    return text;
 }
 } // namespace
 
 int main(int argc, char **argv)
 {
-    char *exe_path_c_str;
-    if (const errno_t error = _get_pgmptr(&exe_path_c_str))
-    {
-        std::cerr << "failed to get the path of the executable\n";
-        return error;
-    }
-    const std::filesystem::path exe_path{exe_path_c_str};
+    const std::chrono::steady_clock::time_point startup_start = std::chrono::steady_clock::now();
+    // The solutions share the standard streams with the driver, nothing in either goes through the C streams
+    std::ios_base::sync_with_stdio(false);
+    const std::filesystem::path exe_path = driver::get_executable_path();
 
     cxxopts::Options options(exe_path.stem().string(), "Advent of Code solutions");
     // clang-format off
@@ -154,8 +155,64 @@ int main(int argc, char **argv)
 		("skip-tests", "skip tests")
 		("D,data-dir", "directory containing input", cxxopts::value<std::string>())
 		("v,verbose", "enable verbose logging")
+		// 15 seconds as "every problem has a solution that completes in at most 15 seconds on ten-year-old hardware."
+		("timeout", "seconds each run of a solution has before it is asked to stop, a benchmark's runs share this "
+			"times the number of warmup and measured runs, on Linux a solution still running a second later is killed",
+			cxxopts::value<double>()->default_value("15"))
+		// Generous enough for every solution so far, stops a runaway solution from taking the machine down with it
+		("memory-limit", "megabytes of memory each solution may use on Linux, 0 for no limit",
+			cxxopts::value<std::size_t>()->default_value("8192"))
 		("s,session", "session used to download data", cxxopts::value<std::string>())
+		("a,all", "run every day of every year, requires the data directory")
+		("years", "run every day of the given years, e.g. 2018,2023-2025", cxxopts::value<std::string>())
+		("j,jobs", "number of solutions to run at the same time when running several days",
+			cxxopts::value<unsigned>())
+		("bench", "benchmark the solution by running it this many times and report the timings as JSON",
+			cxxopts::value<int>())
+		("warmup", "number of untimed runs before benchmarking", cxxopts::value<int>()->default_value("1"))
+		("bench-output", "write the benchmark report to this file instead of the standard output",
+			cxxopts::value<std::string>())
+		("allocation-budget", "fail the benchmark if the solution has more than this many megabytes allocated at "
+			"once, needs a driver built with AOC_ALLOCATION_STATS", cxxopts::value<double>())
+		("trace", "write the trace events of the run to this file, for chrome://tracing or Perfetto",
+			cxxopts::value<std::string>())
+		("profile", "sample the stacks of the solution and write them to this file as collapsed stacks for flame graphs, "
+			"Linux only", cxxopts::value<std::string>())
+		("profile-rate", "samples a second of CPU time when profiling", cxxopts::value<int>()->default_value("1000"))
+		("profile-top", "number of functions listed after profiling",
+			cxxopts::value<std::size_t>()->default_value("20"))
+		("counters", "read the hardware performance counters around the solution and each of its phases, falls back to "
+			"the CPU time and page faults where they aren't available")
+		("corpus", "solve every input in this directory with the solution of the given day in one process and report the "
+			"throughput, see --jobs", cxxopts::value<std::string>())
+		("scaling", "benchmark the solution on generated inputs of these sizes, e.g. 100,200,400, and report how the time "
+			"grows, see --bench, --warmup and --bench-output", cxxopts::value<std::vector<std::size_t>>())
+		("seed", "seed of the generated inputs for --scaling", cxxopts::value<std::uint64_t>()->default_value("1"))
+		("history", "file the benchmark results are added to, defaults to bench_history.txt next to the driver",
+			cxxopts::value<std::string>())
+		("compare", "benchmark every day of --years, or of every year, and check the answers and timings against this "
+			"benchmark history", cxxopts::value<std::string>())
+		("threshold", "percentage the median time can grow by before --compare reports a regression",
+			cxxopts::value<double>()->default_value("10"))
+		("prefetch", "download every missing input of --years, or of every year, into the data directory")
+		("connections", "maximum number of downloads at the same time when prefetching",
+			cxxopts::value<long>()->default_value("4"))
+		("cache", "reuse the answers of earlier runs of the same module on the same input when running several days")
+		("no-cache", "run every solution even with --cache, their answers replace the cached ones")
+		("cache-file", "file the cached answers are kept in, defaults to result_cache.txt next to the driver",
+			cxxopts::value<std::string>())
+		("cache-size", "number of cached answers kept, the least recently used are dropped first",
+			cxxopts::value<std::size_t>()->default_value("1024"))
 		;
+#if !defined(_WIN32)
+	options.add_options("Daemon")
+		("serve", "keep the solutions loaded and serve requests on a Unix domain socket, rebuilt modules are reloaded")
+		("client", "ask the daemon to run the solution instead of running it here")
+		("socket", "path of the daemon's socket, defaults to aoc.sock next to the driver", cxxopts::value<std::string>())
+		("input", "input file to send to the daemon, defaults to the one in the data directory",
+			cxxopts::value<std::string>())
+		;
+#endif
     // clang-format on
     options.parse_positional({"year", "day"});
     cxxopts::ParseResult result;
@@ -176,94 +233,249 @@ int main(int argc, char **argv)
         return 0;
     }
 
-    if (!result.count("year") || !result.count("day"))
+    const std::chrono::duration<double> timeout_seconds(std::max(0.001, result["timeout"].as<double>()));
+    const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(timeout_seconds);
+    const std::size_t memory_limit = result["memory-limit"].as<std::size_t>() << 20;
+    const driver::Run_limits limits{timeout, memory_limit};
+
+    // The solution gets the program name followed by any arguments the driver didn't recognise
+    std::vector<std::string> forward_arguments{argv[0]};
+    const std::vector<std::string> &unmatched = result.unmatched();
+    forward_arguments.insert(forward_arguments.end(), unmatched.begin(), unmatched.end());
+
+    std::vector<int> selected_years;
+    if (result.count("years"))
     {
-        std::cerr << "expected year and day to be specified\n";
-        return 0;
+        std::string error;
+        std::optional<std::vector<int>> years = driver::parse_years(result["years"].as<std::string>(), error);
+        if (!years)
+        {
+            std::cerr << error << '\n';
+            return EXIT_FAILURE;
+        }
+        selected_years = std::move(*years);
+    }
+    else
+    {
+        for (int year = driver::first_year; year <= driver::last_year; ++year)
+        {
+            selected_years.push_back(year);
+        }
+    }
+
+    driver::Download_options download_options;
+    if (result.count("session"))
+    {
+        download_options.cookie = "session=" + result["session"].as<std::string>();
+    }
+    download_options.max_connections = std::max(1l, result["connections"].as<long>());
+
+#if !defined(_WIN32)
+    const std::filesystem::path socket_path = result.count("socket")
+                                                  ? std::filesystem::path(result["socket"].as<std::string>())
+                                                  : driver::get_default_socket_path(exe_path.parent_path());
+    if (result.count("serve"))
+    {
+        driver::Server_options server_options;
+        server_options.exe_directory = exe_path.parent_path();
+        server_options.socket_path = socket_path;
+        server_options.run_tests = !result.count("skip-tests");
+        server_options.limits = limits;
+        server_options.arguments = std::move(forward_arguments);
+        return driver::run_server(server_options);
+    }
+
+    if (result.count("client"))
+    {
+        if (!result.count("year") || !result.count("day") || (!result.count("input") && !result.count("data-dir")))
+        {
+            std::cerr << "expected year, day and either the input or the data directory to be specified\n";
+            return EXIT_FAILURE;
+        }
+        const int year = result["year"].as<int>();
+        const int day = result["day"].as<int>();
+        const std::filesystem::path input_path =
+            result.count("input") ? std::filesystem::path(result["input"].as<std::string>())
+                                  : driver::get_input_path(result["data-dir"].as<std::string>(), year, day);
+        return driver::run_client({socket_path, year, day, input_path});
+    }
+#endif
+
+    if (result.count("prefetch"))
+    {
+        if (!result.count("data-dir") || !result.count("session"))
+        {
+            std::cerr << "expected the data directory and session to be specified when prefetching\n";
+            return EXIT_FAILURE;
+        }
+        return prefetch_inputs(result["data-dir"].as<std::string>(), selected_years, download_options);
+    }
+
+    const std::filesystem::path history_path = result.count("history")
+                                                   ? std::filesystem::path(result["history"].as<std::string>())
+                                                   : driver::get_default_bench_history_path(exe_path.parent_path());
+    if (result.count("compare"))
+    {
+        if (!result.count("data-dir"))
+        {
+            std::cerr << "expected the data directory to be specified when comparing\n";
+            return EXIT_FAILURE;
+        }
+
+        driver::Compare_options compare_options;
+        compare_options.exe_directory = exe_path.parent_path();
+        compare_options.data_directory = result["data-dir"].as<std::string>();
+        compare_options.years = std::move(selected_years);
+        compare_options.baseline_path = result["compare"].as<std::string>();
+        compare_options.history_path = history_path;
+        compare_options.threshold = std::max(0.0, result["threshold"].as<double>()) / 100;
+        compare_options.warmup = std::max(0, result["warmup"].as<int>());
+        compare_options.iterations = result.count("bench") ? std::max(1, result["bench"].as<int>()) : 10;
+        compare_options.run_tests = !result.count("skip-tests");
+        compare_options.limits = limits;
+        compare_options.arguments = std::move(forward_arguments);
+        return driver::run_compare(compare_options);
+    }
+
+    if (result.count("all") || result.count("years"))
+    {
+        if (!result.count("data-dir"))
+        {
+            std::cerr << "expected the data directory to be specified when running several days\n";
+            return EXIT_FAILURE;
+        }
+
+        driver::Batch_options batch_options;
+        batch_options.years = std::move(selected_years);
+        batch_options.exe_directory = exe_path.parent_path();
+        batch_options.data_directory = result["data-dir"].as<std::string>();
+        batch_options.jobs =
+            result.count("jobs") ? result["jobs"].as<unsigned>() : std::max(1u, std::thread::hardware_concurrency());
+        batch_options.run_tests = !result.count("skip-tests");
+        batch_options.limits = limits;
+        batch_options.arguments = std::move(forward_arguments);
+        if (result.count("cache"))
+        {
+            batch_options.cache_path = result.count("cache-file")
+                                           ? std::filesystem::path(result["cache-file"].as<std::string>())
+                                           : driver::get_default_result_cache_path(batch_options.exe_directory);
+            batch_options.cache_capacity = result["cache-size"].as<std::size_t>();
+            batch_options.bypass_cache = result.count("no-cache") != 0;
+        }
+        return driver::run_batch(batch_options);
     }
 
-    const auto year = std::to_string(result["year"].as<int>());
-    const std::filesystem::path parent = exe_path.parent_path();
-    const std::filesystem::path year_directory = parent / year;
-    const auto filename = std::format("day{:02}.dll", result["day"].as<int>());
-    const std::filesystem::path dll_path = year_directory / filename;
-    if (!exists(dll_path))
+    if (!result.count("year") || !result.count("day"))
     {
-        std::cerr << "Failed to find " << dll_path << '\n';
-        return ERROR_FILE_NOT_FOUND;
+        std::cerr << "expected year and day to be specified\n";
+        return 0;
     }
 
-    const HMODULE library = LoadLibraryW(dll_path.c_str());
-    if (library == nullptr)
+    const std::chrono::steady_clock::time_point load_start = std::chrono::steady_clock::now();
+    std::string load_error;
+    std::optional<driver::Loaded_day> loaded_day =
+        driver::load_day(exe_path.parent_path(), result["year"].as<int>(), result["day"].as<int>(), load_error);
+    if (!loaded_day)
     {
-        const DWORD error = GetLastError();
-        std::cerr << "Failed to open module: " << error << '\n';
+        std::cerr << "Failed to load the solution: " << load_error << '\n';
         return EXIT_FAILURE;
     }
+    const std::chrono::steady_clock::time_point load_end = std::chrono::steady_clock::now();
 
     if (!result.count("verbose"))
     {
         std::clog.setstate(std::ios_base::failbit);
     }
 
-    const std::vector<std::string> &unmatched = result.unmatched();
-    const auto forward_argc = 1 + static_cast<int>(unmatched.size());
-    auto **forward_argv = new char *[forward_argc + 1];
-    forward_argv[0] = exe_path_c_str;
-    for (std::size_t i = 0; i < unmatched.size(); ++i)
+    const auto forward_argc = static_cast<int>(forward_arguments.size());
+    std::vector<char *> forward_argv;
+    for (std::string &argument : forward_arguments)
     {
-        forward_argv[i + 1] = _strdup(unmatched[i].c_str());
+        forward_argv.push_back(argument.data());
     }
-    forward_argv[forward_argc] = nullptr;
+    forward_argv.push_back(nullptr);
 
+    std::chrono::steady_clock::duration test_duration{};
     if (!result.count("skip-tests"))
     {
-        const auto test_fn = get_proc_address<TestFunction>(library, "test");
-        if (!test_fn)
+        // Loading the tests' module is counted in the test time, the load time is only the solution's
+        const std::chrono::steady_clock::time_point test_start = std::chrono::steady_clock::now();
+        if (!driver::load_tests(exe_path.parent_path(), result["year"].as<int>(), result["day"].as<int>(),
+                                *loaded_day, load_error))
         {
-            // This should always exist, so something has gone wrong
-            const DWORD error = GetLastError();
-            std::cerr << "Failed to load 'test' function from module: " << error << '\n';
+            std::cerr << "Failed to load the tests: " << load_error << '\n';
             return EXIT_FAILURE;
         }
-
-        if (const int test_result = test_fn(forward_argc, forward_argv); test_result != 0)
+        if (loaded_day->test)
         {
-            std::cerr << "Tests failed\n";
-            return test_result;
+            const driver::Logging_scope logging(loaded_day->test_solution, result.count("verbose") != 0);
+            if (const int test_result = loaded_day->test(forward_argc, forward_argv.data()); test_result != 0)
+            {
+                std::cerr << "Tests failed\n";
+                return test_result;
+            }
         }
+        driver::unload_tests(*loaded_day);
+        test_duration = std::chrono::steady_clock::now() - test_start;
     }
 
-    const auto solve_fn = get_proc_address<SolveFunction>(library, "solve");
-    if (!solve_fn)
+    if (result.count("corpus"))
     {
-        const DWORD error = GetLastError();
-        std::cerr << "Failed to load 'solve' function from module: " << error << '\n';
-        return EXIT_FAILURE;
+        driver::Corpus_options corpus_options;
+        corpus_options.directory = result["corpus"].as<std::string>();
+        corpus_options.jobs =
+            result.count("jobs") ? result["jobs"].as<unsigned>() : std::max(1u, std::thread::hardware_concurrency());
+        corpus_options.arguments = std::move(forward_arguments);
+        return driver::run_corpus(loaded_day->solution, corpus_options);
     }
 
-    // ReSharper disable once CppTooWideScope (We need to keep the file in scope since we may bind std::cin to it)
-    std::ifstream file;
+    if (result.count("scaling"))
+    {
+        driver::Scaling_options scaling_options;
+        scaling_options.year = result["year"].as<int>();
+        scaling_options.day = result["day"].as<int>();
+        scaling_options.sizes = result["scaling"].as<std::vector<std::size_t>>();
+        scaling_options.seed = result["seed"].as<std::uint64_t>();
+        scaling_options.warmup = std::max(0, result["warmup"].as<int>());
+        scaling_options.iterations = result.count("bench") ? std::max(1, result["bench"].as<int>()) : 5;
+        scaling_options.limits = limits;
+        scaling_options.arguments = std::move(forward_arguments);
+        if (result.count("bench-output"))
+        {
+            scaling_options.output_path = result["bench-output"].as<std::string>();
+        }
+        return driver::run_scaling(loaded_day->solution, scaling_options);
+    }
+
+    const driver::Solution &solution = loaded_day->solution;
+    driver::Run_options run_options;
     if (result.count("data-dir"))
     {
         const std::filesystem::path data_directory(result["data-dir"].as<std::string>());
-        const auto day = std::to_string(result["day"].as<int>());
-        const std::filesystem::path data_file = data_directory / year / "day" / day / "input.txt";
+        const int year = result["year"].as<int>();
+        const int day = result["day"].as<int>();
+        const std::filesystem::path data_file = driver::get_input_path(data_directory, year, day);
         if (!exists(data_file))
         {
             if (result.count("session"))
             {
                 std::cout << "The data file does not exist, trying to download\n";
-                const std::string cookie = "session=" + result["session"].as<std::string>();
                 create_directories(data_file.parent_path());
-                if (download_data(year, day, data_file, cookie))
+                const driver::Download_request request{year, day, data_file};
+                const driver::Download_result download =
+                    driver::download_inputs({&request, 1}, download_options).front();
+                if (!download.success)
                 {
-                    std::clog << "Downloaded data to " << data_file << '\n';
+                    std::cerr << "Failed to download data: " << download.error << '\n';
+                    return EXIT_FAILURE;
                 }
-                else
+                std::clog << "Downloaded data to " << data_file << '\n';
+
+                driver::Input_index index = driver::Input_index::load(data_directory);
+                index.record(year, day, data_file, download.hash);
+                if (std::string error; !index.save(error))
                 {
-                    std::cerr << "Failed to download data" << '\n';
-                    return EXIT_FAILURE;
+                    std::cerr << "Failed to save the input hashes: " << error << '\n';
                 }
             }
             else
@@ -272,23 +484,169 @@ int main(int argc, char **argv)
                 return EXIT_FAILURE;
             }
         }
-        file.open(data_file);
-        std::cin.rdbuf(file.rdbuf());
+        run_options.input_path = data_file;
+    }
+
+    const bool bench = result.count("bench") != 0;
+    if (bench)
+    {
+        run_options.capture_output = true;
+        run_options.warmup = std::max(0, result["warmup"].as<int>());
+        run_options.iterations = std::max(1, result["bench"].as<int>());
+    }
+    run_options.verbose = result.count("verbose") != 0;
+    run_options.counters = result.count("counters") != 0;
+    if (result.count("trace"))
+    {
+        run_options.trace_path = result["trace"].as<std::string>();
+    }
+    if (result.count("profile"))
+    {
+#if defined(_WIN32)
+        std::cerr << "Profiling is only supported on Linux\n";
+        return EXIT_FAILURE;
+#else
+        run_options.profile_path = result["profile"].as<std::string>();
+        run_options.profile_rate = std::max(1, result["profile-rate"].as<int>());
+        run_options.profile_top = result["profile-top"].as<std::size_t>();
+#endif
     }
 
-    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
-    // Exception handling?
-    // TODO: make timeout configurable, used 15 seconds as a reasonable default as "every problem has a solution that
-    // completes in at most 15 seconds on ten-year-old hardware."
-    const std::chrono::milliseconds timeout = 15s;
-    if (!run_solution(solve_fn, forward_argc, forward_argv, timeout))
+    const std::chrono::steady_clock::time_point solve_start = std::chrono::steady_clock::now();
+    const driver::Run_result run_result =
+        driver::run_solution(solution, forward_argc, forward_argv.data(), limits, run_options);
+    const std::chrono::steady_clock::duration wall_duration = std::chrono::steady_clock::now() - solve_start;
+    switch (run_result.status)
     {
-        std::cerr << "Solution timed out after " << timeout.count() << " seconds\n";
+    case driver::Run_status::finished:
+        break;
+    case driver::Run_status::timed_out:
+        std::cerr << "Solution timed out after " << driver::get_time_budget(limits, run_options).count() << "ms ("
+                  << run_result.message << ")\n";
         return EXIT_FAILURE;
+    case driver::Run_status::crashed:
+        std::cerr << "Solution crashed (" << run_result.message << ")\n";
+        return EXIT_FAILURE;
+    case driver::Run_status::tests_failed:
+        std::cerr << "Tests failed\n";
+        return EXIT_FAILURE;
+    }
+
+    if (bench)
+    {
+        const driver::Bench_settings settings{result["year"].as<int>(), result["day"].as<int>(), run_options.warmup,
+                                              run_options.iterations};
+        const std::string report = driver::format_bench_report(settings, run_result);
+
+        // Only runs on an input file can be recorded, the standard input can't be hashed without consuming it
+        if (const std::optional<std::uint64_t> input_hash = driver::hash_file(run_options.input_path); input_hash)
+        {
+            const std::uint64_t module_hash = driver::hash_file(loaded_day->binary_path).value_or(0);
+            const driver::Bench_record record =
+                driver::make_bench_record(settings.year, settings.day, module_hash, *input_hash, run_result);
+            if (std::string error; !driver::append_bench_record(history_path, record, error))
+            {
+                std::cerr << "Failed to record the benchmark: " << error << '\n';
+            }
+        }
+        if (result.count("bench-output"))
+        {
+            std::ofstream bench_output(result["bench-output"].as<std::string>());
+            bench_output << report << '\n';
+            if (!bench_output)
+            {
+                std::cerr << "Failed to write the benchmark report\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cout << report << '\n';
+        }
+
+        if (result.count("allocation-budget"))
+        {
+            const auto budget = static_cast<std::uint64_t>(result["allocation-budget"].as<double>() * 1024 * 1024);
+            if (!run_result.allocations)
+            {
+                std::cerr << "Can't check the allocation budget, the driver wasn't built with AOC_ALLOCATION_STATS\n";
+                return EXIT_FAILURE;
+            }
+            if (run_result.allocations->total.peak_bytes > budget)
+            {
+                std::cerr << "Solution exceeded the allocation budget of " << format_bytes(budget) << ", it had "
+                          << format_bytes(run_result.allocations->total.peak_bytes) << " allocated at once\n";
+                return EXIT_FAILURE;
+            }
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << "Finished in " << format_milliseconds(run_result.solve_time) << '\n';
+    std::cout << "Startup " << format_milliseconds(load_start - startup_start) << ", load "
+              << format_milliseconds(load_end - load_start) << ", tests " << format_milliseconds(test_duration)
+              << ", solve " << format_milliseconds(run_result.solve_time) << " (" << format_milliseconds(wall_duration)
+              << " wall)\n";
+    const driver::Iteration_times &first_times = run_result.iterations.front();
+    if (run_result.has_phases)
+    {
+        std::cout << "Parse " << format_milliseconds(first_times.parse) << ", part one "
+                  << format_milliseconds(first_times.part_one) << ", part two "
+                  << format_milliseconds(first_times.part_two) << '\n';
+    }
+    else if (first_times.part_one_answered && first_times.part_two_answered)
+    {
+        std::cout << "Part one answered after " << format_milliseconds(first_times.part_one_answer) << ", part two after "
+                  << format_milliseconds(first_times.part_two_answer) << '\n';
+    }
+    else if (first_times.part_one_answered)
+    {
+        std::cout << "Part one answered after " << format_milliseconds(first_times.part_one_answer) << '\n';
+    }
+    else if (first_times.part_two_answered)
+    {
+        std::cout << "Part two answered after " << format_milliseconds(first_times.part_two_answer) << '\n';
+    }
+    if (run_result.allocations)
+    {
+        const driver::Allocation_profile &allocations = *run_result.allocations;
+        std::cout << "Allocations " << format_allocations(allocations.total) << '\n';
+        if (run_result.has_phases)
+        {
+            std::cout << "Parse " << format_allocations(allocations.parse);
+            if (allocations.parts_combined)
+            {
+                std::cout << ", parts " << format_allocations(allocations.part_one) << '\n';
+            }
+            else
+            {
+                std::cout << ", part one " << format_allocations(allocations.part_one) << ", part two "
+                          << format_allocations(allocations.part_two) << '\n';
+            }
+        }
+    }
+    if (run_result.counters)
+    {
+        const driver::Counter_profile &counters = *run_result.counters;
+        std::cout << "Counters " << format_counters(counters.total) << '\n';
+        if (!counters.total.hardware)
+        {
+            std::cout << "The hardware counters aren't available, only the CPU time and page faults were read\n";
+        }
+        if (run_result.has_phases)
+        {
+            std::cout << "Parse " << format_counters(counters.parse) << '\n';
+            if (counters.parts_combined)
+            {
+                std::cout << "Parts " << format_counters(counters.part_one) << '\n';
+            }
+            else
+            {
+                std::cout << "Part one " << format_counters(counters.part_one) << '\n';
+                std::cout << "Part two " << format_counters(counters.part_two) << '\n';
+            }
+        }
     }
-    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
-    const std::chrono::steady_clock::duration duration = end - start;
-    std::cout << "Finished in " << std::chrono::duration_cast<std::chrono::milliseconds>(duration) << '\n';
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,237 @@
+#ifndef AOC_PLATFORM_H
+#define AOC_PLATFORM_H
+
+#include "allocation_stats.h"
+#include "aoc_abi.h"
+#include "counters.h"
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace driver
+{
+#if defined(_WIN32)
+inline constexpr const char *module_extension = ".dll";
+#else
+inline constexpr const char *module_extension = ".so";
+#endif
+
+/*
+ * Get the path of the running executable, the solution modules are found relative to it
+ */
+std::filesystem::path get_executable_path();
+
+/*
+ * The entry points of a solution module, every module exports solve and some also export the phases
+ */
+struct Solution
+{
+    Aoc_solve_function solve = nullptr;
+    // Missing from modules built before solutions could be stopped early
+    Aoc_set_stop_token_function set_stop_token = nullptr;
+    // Missing from modules built before solutions could be traced
+    Aoc_set_tracer_function set_tracer = nullptr;
+    // Missing from modules built before logging went through the driver
+    Aoc_set_logger_function set_logger = nullptr;
+    // Missing from modules built before the answers went through the driver
+    Aoc_set_answer_sink_function set_answer_sink = nullptr;
+    // Preferred over solve when available
+    Aoc_solve_input_function solve_input = nullptr;
+    // Preferred over both when available
+    const Aoc_phases *phases = nullptr;
+
+    // Whether the solution wants the input in memory rather than reading the standard input
+    [[nodiscard]] bool takes_input() const
+    {
+        return phases ? phases->parse_input != nullptr : solve_input != nullptr;
+    }
+};
+
+/*
+ * The whole input in memory for the solutions that take an Aoc_input, the lines are indexed once when it is loaded
+ */
+class Input_buffer
+{
+private:
+    const char *m_data = nullptr;
+    std::size_t m_size = 0;
+    // Whether the memory is a view of the input file rather than pages allocated to hold a copy
+    bool m_mapped = false;
+    std::vector<std::size_t> m_line_offsets;
+
+    Input_buffer(const char *data, std::size_t size, bool mapped);
+
+public:
+    Input_buffer(const Input_buffer &) = delete;
+    Input_buffer &operator=(const Input_buffer &) = delete;
+    Input_buffer(Input_buffer &&other) noexcept;
+    Input_buffer &operator=(Input_buffer &&other) noexcept;
+    ~Input_buffer();
+
+    /*
+     * Map the file at the given path into memory, or the standard input if the path is empty. Inputs that can't be
+     * mapped, such as pipes, are read into page aligned memory instead. Throws std::system_error on failure.
+     */
+    static Input_buffer load(const std::filesystem::path &path);
+
+    [[nodiscard]] Aoc_input view() const
+    {
+        return {m_data, m_size, m_line_offsets.data(), m_line_offsets.size()};
+    }
+};
+
+/*
+ * A loaded solution module, the module is unloaded when this is destroyed
+ */
+class Module
+{
+private:
+    void *m_handle = nullptr;
+
+    explicit Module(void *handle);
+
+public:
+    Module(const Module &) = delete;
+    Module &operator=(const Module &) = delete;
+    Module(Module &&other) noexcept;
+    Module &operator=(Module &&other) noexcept;
+    ~Module();
+
+    /*
+     * Load the module at the given path, on failure returns an empty optional and sets the error message
+     */
+    static std::optional<Module> load(const std::filesystem::path &path, std::string &error);
+
+    /*
+     * Find an exported function, returns nullptr if the module doesn't export it
+     */
+    void *find_symbol(const char *name) const;
+
+    template <typename T> T get(const char *const name) const
+    {
+        return reinterpret_cast<T>(find_symbol(name));
+    }
+
+    [[nodiscard]] Solution get_solution() const
+    {
+        Solution solution;
+        solution.solve = get<Aoc_solve_function>("solve");
+        solution.set_stop_token = get<Aoc_set_stop_token_function>("set_stop_token");
+        solution.set_tracer = get<Aoc_set_tracer_function>("set_tracer");
+        solution.set_logger = get<Aoc_set_logger_function>("set_logger");
+        solution.set_answer_sink = get<Aoc_set_answer_sink_function>("set_answer_sink");
+        solution.solve_input = get<Aoc_solve_input_function>("solve_input");
+        if (const auto phases_fn = get<Aoc_phases_function>("phases"))
+        {
+            solution.phases = phases_fn();
+        }
+        return solution;
+    }
+};
+
+struct Run_limits
+{
+    std::chrono::milliseconds timeout;
+    // Maximum amount of memory in bytes the solution can use, zero means no limit
+    std::size_t memory_limit = 0;
+};
+
+/*
+ * Optional behaviour for running a solution, by default the solution uses the driver's standard input and output
+ */
+struct Run_options
+{
+    // Read the input from this file instead of the standard input
+    std::filesystem::path input_path;
+    // Collect everything the solution writes to the standard output instead of passing it through
+    bool capture_output = false;
+    // Run the tests before the solution, the solution isn't run if they fail
+    Aoc_test_function test_fn = nullptr;
+    // Number of untimed runs before the measured ones
+    int warmup = 0;
+    // Number of measured runs, the input is rewound before each one and only the output of the first run is kept
+    int iterations = 1;
+    // Record trace events during the runs and write them to this file
+    std::filesystem::path trace_path;
+    // Pass the log lines of the solution on to std::clog
+    bool verbose = false;
+    // Sample the stacks of the solution and write them to this file, Linux only
+    std::filesystem::path profile_path;
+    // Samples a second of CPU time
+    int profile_rate = 1000;
+    // Number of functions listed in the profile's table
+    std::size_t profile_top = 20;
+    // Read the performance counters around the first measured run
+    bool counters = false;
+};
+
+/*
+ * The time a whole run may take before the solution is asked to stop, every warmup and measured iteration adds the
+ * full timeout
+ */
+inline std::chrono::milliseconds get_time_budget(const Run_limits &limits, const Run_options &options)
+{
+    return limits.timeout * (options.warmup + options.iterations);
+}
+
+/*
+ * How long a single run of the solution took, the phases are only filled in for solutions exporting them
+ */
+struct Iteration_times
+{
+    std::chrono::nanoseconds total{};
+    std::chrono::nanoseconds parse{};
+    std::chrono::nanoseconds part_one{};
+    std::chrono::nanoseconds part_two{};
+    // How long after the start of the run each answer was reported, only set for the parts reported through
+    // aoc::answer, the rest were printed by the solution itself or never came
+    std::chrono::nanoseconds part_one_answer{};
+    std::chrono::nanoseconds part_two_answer{};
+    bool part_one_answered = false;
+    bool part_two_answered = false;
+};
+
+enum class Run_status
+{
+    finished,
+    timed_out,
+    crashed,
+    tests_failed
+};
+
+struct Run_result
+{
+    Run_status status = Run_status::finished;
+    // Time spent inside the solution for the first measured run, only valid if the solution finished
+    std::chrono::nanoseconds solve_time{};
+    // Time spent inside the solution for every measured run
+    std::vector<Iteration_times> iterations;
+    // Whether the phases were timed separately
+    bool has_phases = false;
+    // Description of why the solution didn't finish
+    std::string message;
+    // The standard output of the solution, only set when it was captured
+    std::string output;
+    // Peak resident memory of the solution in bytes, zero where it can't be measured separately from the driver
+    std::size_t peak_memory = 0;
+    // The allocations of the first measured run, only set when the driver counts them
+    std::optional<Allocation_profile> allocations;
+    // The counters of the first measured run, only set when they were asked for
+    std::optional<Counter_profile> counters;
+};
+
+/*
+ * Run the solution while enforcing the limits. On Linux the solution runs in a child process so it can be killed
+ * cleanly, on Windows it runs on a separate thread that is terminated if it doesn't finish in time. The timeout applies
+ * to each run of the solution.
+ */
+Run_result run_solution(const Solution &solution, int argc, char **argv, const Run_limits &limits,
+                        const Run_options &options = {});
+} // namespace driver
+
+#endif
@@ -0,0 +1,692 @@
+#include "platform.h"
+
+#include "solve_loop.h"
+
+#include <aoc/input.h>
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+/*
+ * What the child process sends back to the driver once the solution has finished, followed by the times of each of the
+ * iterations
+ */
+struct Child_report
+{
+    driver::Run_status status;
+    std::int64_t iteration_count;
+    bool has_phases;
+    // Followed by the allocations after the times
+    bool has_allocations;
+    // Followed by the counters after the allocations
+    bool has_counters;
+    // Followed by why the solution failed after everything else, e.g. the exception it threw
+    std::int64_t message_size;
+};
+
+/*
+ * Batches and the daemon run solutions from several threads. Forking, loading and unloading modules take turns, so no
+ * thread forks while another is half way through starting a child or holds the dynamic loader's locks.
+ */
+std::mutex fork_mutex;
+
+static_assert(std::is_trivially_copyable_v<driver::Iteration_times>);
+static_assert(std::is_trivially_copyable_v<driver::Allocation_profile>);
+static_assert(std::is_trivially_copyable_v<driver::Counter_profile>);
+
+[[noreturn]] void throw_system_error(const char *const what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+bool is_debugger_present()
+{
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);)
+    {
+        if (line.starts_with("TracerPid:"))
+        {
+            return std::atoi(line.c_str() + std::strlen("TracerPid:")) != 0;
+        }
+    }
+    return false;
+}
+
+void apply_limits(const driver::Run_limits &limits, const std::chrono::milliseconds budget)
+{
+    // The CPU limit is a backstop in case the driver itself is stopped, round up and give the solution a second of slack
+    const auto seconds = std::chrono::ceil<std::chrono::seconds>(budget + driver::stop_grace_period).count() + 1;
+    const rlimit cpu_limit{static_cast<rlim_t>(seconds), static_cast<rlim_t>(seconds + 1)};
+    setrlimit(RLIMIT_CPU, &cpu_limit);
+
+    if (limits.memory_limit != 0)
+    {
+        const rlimit memory_limit{limits.memory_limit, limits.memory_limit};
+        setrlimit(RLIMIT_AS, &memory_limit);
+    }
+}
+
+[[noreturn]] void exit_child(const int exit_code)
+{
+    // Skip the static destructors, they belong to the driver
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(exit_code);
+}
+
+void redirect(const int fd, const int target)
+{
+    if (dup2(fd, target) == -1)
+    {
+        std::cerr << "Failed to redirect file descriptor: " << std::strerror(errno) << '\n';
+        exit_child(EXIT_FAILURE);
+    }
+    close(fd);
+}
+
+bool write_all(const int fd, const std::string_view bytes)
+{
+    std::size_t written = 0;
+    while (written < bytes.size())
+    {
+        const ssize_t result = write(fd, bytes.data() + written, bytes.size() - written);
+        if (result == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return false;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+/*
+ * Tell the driver why the solution couldn't run in place of its times, the driver reports it as a crash
+ */
+[[noreturn]] void exit_with_failure(const int report_fd, const std::string_view message)
+{
+    const Child_report report{driver::Run_status::crashed, 0, false, false, false,
+                              static_cast<std::int64_t>(message.size())};
+    if (write_all(report_fd, {reinterpret_cast<const char *>(&report), sizeof(report)}))
+    {
+        write_all(report_fd, message);
+    }
+    exit_child(EXIT_FAILURE);
+}
+
+/*
+ * When the output is captured only the answers should end up in it, so the test report only goes to the standard error
+ * if the tests fail
+ */
+bool run_tests(const Aoc_test_function test_fn, const int argc, char **argv, const bool capture_output)
+{
+    if (!capture_output)
+    {
+        return test_fn(argc, argv) == 0;
+    }
+
+    std::ostringstream test_output;
+    std::streambuf *const previous = std::cout.rdbuf(test_output.rdbuf());
+    const int test_result = test_fn(argc, argv);
+    std::cout.rdbuf(previous);
+    if (test_result != 0)
+    {
+        std::cerr << test_output.str();
+    }
+    return test_result == 0;
+}
+
+[[noreturn]] void run_child(const driver::Solution &solution, const int argc, char **argv, const int report_fd,
+                            const int output_fd, const driver::Run_limits &limits, const driver::Run_options &options)
+{
+    if (!options.input_path.empty())
+    {
+        const int input_fd = open(options.input_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (input_fd == -1)
+        {
+            exit_with_failure(report_fd,
+                              "failed to open " + options.input_path.string() + ": " + std::strerror(errno));
+        }
+        redirect(input_fd, STDIN_FILENO);
+    }
+
+    if (output_fd != -1)
+    {
+        redirect(output_fd, STDOUT_FILENO);
+    }
+
+    // Other threads may be running solutions at the same time, drop any of their pipes we inherited otherwise they
+    // won't see the end of file until we exit
+    close_range(3, report_fd - 1, 0);
+    close_range(report_fd + 1, ~0U, 0);
+
+    const std::chrono::milliseconds budget = driver::get_time_budget(limits, options);
+    apply_limits(limits, budget);
+
+    int exit_code = EXIT_SUCCESS;
+    // Only set when the solution failed, the driver prints it
+    std::string failure;
+    try
+    {
+        // Ask the solution to stop once it has used up its time, the driver kills it if it doesn't stop soon after
+        std::stop_source stop_source;
+        const driver::Stop_token_scope stop_scope(solution, stop_source.get_token());
+        std::jthread watchdog([&stop_source, budget](const std::stop_token finished) {
+            std::mutex mutex;
+            std::condition_variable_any condition;
+            std::unique_lock lock(mutex);
+            condition.wait_for(lock, finished, budget, [] { return false; });
+            if (!finished.stop_requested())
+            {
+                stop_source.request_stop();
+            }
+        });
+
+        std::string report_bytes;
+        Child_report report{driver::Run_status::tests_failed, 0, solution.phases != nullptr, false, false, 0};
+        std::vector<driver::Iteration_times> times;
+        driver::Allocation_profile allocations;
+        driver::Counter_profile counters;
+        if (!options.test_fn || run_tests(options.test_fn, argc, argv, options.capture_output))
+        {
+            // No times come back if the solution was asked to stop, and then none of its answers were printed
+            times = driver::time_iterations(solution, argc, argv, options, &allocations, &counters,
+                                            stop_source.get_token());
+            const bool stopped = times.empty();
+            report.has_allocations = !stopped && driver::are_allocations_tracked();
+            report.has_counters = !stopped && options.counters;
+            report.status = stopped ? driver::Run_status::timed_out : driver::Run_status::finished;
+            report.iteration_count = static_cast<std::int64_t>(times.size());
+        }
+
+        watchdog.request_stop();
+        watchdog.join();
+
+        report_bytes.append(reinterpret_cast<const char *>(&report), sizeof(report));
+        report_bytes.append(reinterpret_cast<const char *>(times.data()), times.size() * sizeof(times.front()));
+        if (report.has_allocations)
+        {
+            report_bytes.append(reinterpret_cast<const char *>(&allocations), sizeof(allocations));
+        }
+        if (report.has_counters)
+        {
+            report_bytes.append(reinterpret_cast<const char *>(&counters), sizeof(counters));
+        }
+        if (!write_all(report_fd, report_bytes))
+        {
+            exit_code = EXIT_FAILURE;
+        }
+    }
+    catch (const std::bad_alloc &)
+    {
+        // Nothing is allocated here, the memory may still be short
+        exit_with_failure(report_fd, "ran out of memory");
+    }
+    catch (const std::exception &ex)
+    {
+        failure = std::string("threw an exception: ") + ex.what();
+    }
+
+    if (!failure.empty())
+    {
+        exit_with_failure(report_fd, failure);
+    }
+    exit_child(exit_code);
+}
+
+/*
+ * Read everything the child writes to the pipes until it closes them, returns false if the deadline passed first
+ */
+bool read_child_pipes(const int report_fd, const int output_fd, std::string &report, std::string &output,
+                      const std::chrono::steady_clock::time_point deadline)
+{
+    pollfd poll_fds[2] = {{report_fd, POLLIN, 0}, {output_fd, POLLIN, 0}};
+    std::string *const buffers[2] = {&report, &output};
+    while (poll_fds[0].fd != -1 || poll_fds[1].fd != -1)
+    {
+        const auto remaining =
+            std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            return false;
+        }
+
+        const int result = poll(poll_fds, 2, static_cast<int>(remaining.count()));
+        if (result < 0 && errno != EINTR)
+        {
+            throw_system_error("poll");
+        }
+
+        for (int i = 0; i < 2 && result > 0; ++i)
+        {
+            if (poll_fds[i].fd == -1 || poll_fds[i].revents == 0)
+            {
+                continue;
+            }
+
+            char buffer[4096];
+            const ssize_t bytes_read = read(poll_fds[i].fd, buffer, sizeof(buffer));
+            if (bytes_read > 0)
+            {
+                buffers[i]->append(buffer, static_cast<std::size_t>(bytes_read));
+            }
+            else if (bytes_read == 0 || errno != EINTR)
+            {
+                // Negative file descriptors are ignored by poll
+                poll_fds[i].fd = -1;
+            }
+        }
+    }
+    return true;
+}
+
+pid_t wait_for_child(const pid_t pid, int &status, rusage *const usage = nullptr)
+{
+    pid_t result;
+    do
+    {
+        result = wait4(pid, &status, 0, usage);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+
+/*
+ * Read everything from a pipe or terminal into anonymous pages, doubling them as they fill up
+ */
+std::pair<char *, std::size_t> read_into_pages(const int fd)
+{
+    std::size_t capacity = std::size_t{1} << 20;
+    void *data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+    {
+        throw_system_error("mmap");
+    }
+
+    std::size_t size = 0;
+    while (true)
+    {
+        if (size == capacity)
+        {
+            void *const grown = mremap(data, capacity, capacity * 2, MREMAP_MAYMOVE);
+            if (grown == MAP_FAILED)
+            {
+                munmap(data, capacity);
+                throw_system_error("mremap");
+            }
+            data = grown;
+            capacity *= 2;
+        }
+
+        const ssize_t bytes_read = read(fd, static_cast<char *>(data) + size, capacity - size);
+        if (bytes_read == 0)
+        {
+            break;
+        }
+        if (bytes_read == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            munmap(data, capacity);
+            throw_system_error("read");
+        }
+        size += static_cast<std::size_t>(bytes_read);
+    }
+
+    if (size == 0)
+    {
+        munmap(data, capacity);
+        return {nullptr, 0};
+    }
+
+    // Give back the pages past the end so only the size is needed to unmap it later
+    void *const shrunk = mremap(data, capacity, size, 0);
+    if (shrunk != MAP_FAILED)
+    {
+        data = shrunk;
+    }
+    mprotect(data, size, PROT_READ);
+    return {static_cast<char *>(data), size};
+}
+
+std::string describe_status(const int status)
+{
+    if (WIFSIGNALED(status))
+    {
+        const int signal = WTERMSIG(status);
+        return std::string("killed by signal ") + std::to_string(signal) + " (" + strsignal(signal) + ")";
+    }
+    return "exited with code " + std::to_string(WEXITSTATUS(status));
+}
+} // namespace
+
+namespace driver
+{
+std::filesystem::path get_executable_path()
+{
+    return std::filesystem::read_symlink("/proc/self/exe");
+}
+
+Module::Module(void *const handle) : m_handle(handle)
+{
+}
+
+Module::Module(Module &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+{
+}
+
+Module &Module::operator=(Module &&other) noexcept
+{
+    std::swap(m_handle, other.m_handle);
+    return *this;
+}
+
+Module::~Module()
+{
+    if (m_handle)
+    {
+        const std::lock_guard lock(fork_mutex);
+        dlclose(m_handle);
+    }
+}
+
+std::optional<Module> Module::load(const std::filesystem::path &path, std::string &error)
+{
+    void *handle;
+    {
+        const std::lock_guard lock(fork_mutex);
+        handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    }
+    if (handle == nullptr)
+    {
+        error = dlerror();
+        return std::nullopt;
+    }
+    return Module{handle};
+}
+
+void *Module::find_symbol(const char *const name) const
+{
+    return dlsym(m_handle, name);
+}
+
+Input_buffer::Input_buffer(const char *const data, const std::size_t size, const bool mapped)
+    : m_data(data), m_size(size), m_mapped(mapped), m_line_offsets(aoc::index_lines({data, size}))
+{
+}
+
+Input_buffer::Input_buffer(Input_buffer &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_mapped(other.m_mapped),
+      m_line_offsets(std::move(other.m_line_offsets))
+{
+}
+
+Input_buffer &Input_buffer::operator=(Input_buffer &&other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_mapped, other.m_mapped);
+    std::swap(m_line_offsets, other.m_line_offsets);
+    return *this;
+}
+
+Input_buffer::~Input_buffer()
+{
+    // The copies are in anonymous mappings, so they are released the same way as the files
+    if (m_data)
+    {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+}
+
+Input_buffer Input_buffer::load(const std::filesystem::path &path)
+{
+    const int fd = path.empty() ? STDIN_FILENO : open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw_system_error("open");
+    }
+
+    struct File_closer
+    {
+        int fd;
+
+        ~File_closer()
+        {
+            if (fd != STDIN_FILENO)
+            {
+                close(fd);
+            }
+        }
+    } closer{fd};
+
+    struct stat info;
+    if (fstat(fd, &info) == -1)
+    {
+        throw_system_error("fstat");
+    }
+
+    if (!S_ISREG(info.st_mode))
+    {
+        const auto [data, size] = read_into_pages(fd);
+        return {data, size, false};
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size == 0)
+    {
+        return {nullptr, 0, true};
+    }
+
+    // The whole input is about to be scanned for the line index, so fault it all in up front
+    void *const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        throw_system_error("mmap");
+    }
+    return {static_cast<const char *>(data), size, true};
+}
+
+Run_result run_solution(const Solution &solution, const int argc, char **argv, const Run_limits &limits,
+                        const Run_options &options)
+{
+    // Can't follow the solution into a child process from the debugger, so just run it here
+    if (is_debugger_present() && options.input_path.empty() && !options.capture_output && !options.test_fn)
+    {
+        Run_result result;
+        result.status = Run_status::finished;
+        Allocation_profile allocations;
+        Counter_profile counters;
+        result.iterations = time_iterations(solution, argc, argv, options, &allocations, &counters);
+        if (are_allocations_tracked())
+        {
+            result.allocations = allocations;
+        }
+        if (options.counters)
+        {
+            result.counters = counters;
+        }
+        result.solve_time = result.iterations.front().total;
+        result.has_phases = solution.phases != nullptr;
+        return result;
+    }
+
+    int report_fds[2];
+    if (pipe2(report_fds, O_CLOEXEC) == -1)
+    {
+        throw_system_error("pipe2");
+    }
+
+    int output_fds[2] = {-1, -1};
+    if (options.capture_output && pipe2(output_fds, O_CLOEXEC) == -1)
+    {
+        close(report_fds[0]);
+        close(report_fds[1]);
+        throw_system_error("pipe2");
+    }
+
+    const auto close_pipes = [&report_fds, &output_fds] {
+        for (const int fd : {report_fds[0], report_fds[1], output_fds[0], output_fds[1]})
+        {
+            if (fd != -1)
+            {
+                close(fd);
+            }
+        }
+    };
+
+    pid_t pid;
+    {
+        // Anything left in the buffers would be written twice otherwise. The streams aren't synced with stdio so they
+        // aren't safe to flush from several threads at once, the lock covers the flushes as well as the fork.
+        const std::lock_guard lock(fork_mutex);
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush(nullptr);
+        pid = fork();
+    }
+    if (pid == -1)
+    {
+        close_pipes();
+        throw_system_error("fork");
+    }
+
+    if (pid == 0)
+    {
+        close(report_fds[0]);
+        if (output_fds[0] != -1)
+        {
+            close(output_fds[0]);
+        }
+        run_child(solution, argc, argv, report_fds[1], output_fds[1], limits, options);
+    }
+
+    close(report_fds[1]);
+    report_fds[1] = -1;
+    if (output_fds[1] != -1)
+    {
+        close(output_fds[1]);
+        output_fds[1] = -1;
+    }
+
+    Run_result result;
+    std::string report_bytes;
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + get_time_budget(limits, options) + stop_grace_period;
+    const bool completed = read_child_pipes(report_fds[0], output_fds[0], report_bytes, result.output, deadline);
+    close_pipes();
+    if (!completed)
+    {
+        kill(pid, SIGKILL);
+        int status;
+        wait_for_child(pid, status);
+        result.status = Run_status::timed_out;
+        result.message = "killed the solution process";
+        return result;
+    }
+
+    int status = 0;
+    rusage usage{};
+    if (wait_for_child(pid, status, &usage) == -1)
+    {
+        throw_system_error("wait4");
+    }
+    // Reported in kilobytes, and includes whatever the driver had touched before forking
+    result.peak_memory = static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU)
+    {
+        result.status = Run_status::timed_out;
+        result.message = "exceeded the CPU time limit";
+        return result;
+    }
+
+    // A child that failed without dying sends a crash report with the reason and exits with a failure
+    Child_report report{};
+    const bool has_report = report_bytes.size() >= sizeof(report);
+    if (has_report)
+    {
+        std::memcpy(&report, report_bytes.data(), sizeof(report));
+    }
+    if (!has_report || !WIFEXITED(status) ||
+        (WEXITSTATUS(status) != EXIT_SUCCESS && report.status != Run_status::crashed))
+    {
+        result.status = Run_status::crashed;
+        result.message = describe_status(status);
+        return result;
+    }
+
+    const std::size_t times_size = static_cast<std::size_t>(report.iteration_count) * sizeof(Iteration_times);
+    const std::size_t allocations_size = report.has_allocations ? sizeof(Allocation_profile) : 0;
+    const std::size_t counters_size = report.has_counters ? sizeof(Counter_profile) : 0;
+    const auto message_size = static_cast<std::size_t>(report.message_size);
+    if (report_bytes.size() != sizeof(report) + times_size + allocations_size + counters_size + message_size)
+    {
+        result.status = Run_status::crashed;
+        result.message = "incomplete report from the solution process";
+        return result;
+    }
+
+    result.status = report.status;
+    result.message = report_bytes.substr(report_bytes.size() - message_size);
+    if (result.status == Run_status::timed_out)
+    {
+        result.message = "the solution stopped when asked";
+    }
+    if (result.status == Run_status::crashed)
+    {
+        return result;
+    }
+    result.has_phases = report.has_phases;
+    result.iterations.resize(static_cast<std::size_t>(report.iteration_count));
+    std::memcpy(result.iterations.data(), report_bytes.data() + sizeof(report), times_size);
+    if (report.has_allocations)
+    {
+        result.allocations.emplace();
+        std::memcpy(&*result.allocations, report_bytes.data() + sizeof(report) + times_size, allocations_size);
+    }
+    if (report.has_counters)
+    {
+        result.counters.emplace();
+        std::memcpy(&*result.counters, report_bytes.data() + sizeof(report) + times_size + allocations_size,
+                    counters_size);
+    }
+    if (!result.iterations.empty())
+    {
+        result.solve_time = result.iterations.front().total;
+    }
+    return result;
+}
+} // namespace driver
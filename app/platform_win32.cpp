@@ -0,0 +1,363 @@
+#include "platform.h"
+
+#include "solve_loop.h"
+
+#include <aoc/input.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#include <windows.h>
+
+namespace
+{
+[[noreturn]] void throw_last_error(const char *const what)
+{
+    throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+}
+
+/*
+ * Read everything from a pipe or console into allocated pages, the pages are replaced with bigger ones as they fill up
+ */
+std::pair<char *, std::size_t> read_into_pages(const HANDLE handle)
+{
+    std::size_t capacity = std::size_t{1} << 20;
+    auto *data = static_cast<char *>(VirtualAlloc(nullptr, capacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (data == nullptr)
+    {
+        throw_last_error("VirtualAlloc");
+    }
+
+    std::size_t size = 0;
+    while (true)
+    {
+        if (size == capacity)
+        {
+            auto *const grown =
+                static_cast<char *>(VirtualAlloc(nullptr, capacity * 2, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+            if (grown == nullptr)
+            {
+                VirtualFree(data, 0, MEM_RELEASE);
+                throw_last_error("VirtualAlloc");
+            }
+            std::memcpy(grown, data, size);
+            VirtualFree(data, 0, MEM_RELEASE);
+            data = grown;
+            capacity *= 2;
+        }
+
+        const DWORD chunk = static_cast<DWORD>((std::min<std::size_t>)(capacity - size, MAXDWORD));
+        DWORD bytes_read = 0;
+        if (!ReadFile(handle, data + size, chunk, &bytes_read, nullptr))
+        {
+            // The writing end of a pipe being closed is the end of the input
+            if (GetLastError() == ERROR_BROKEN_PIPE)
+            {
+                break;
+            }
+            VirtualFree(data, 0, MEM_RELEASE);
+            throw_last_error("ReadFile");
+        }
+        if (bytes_read == 0)
+        {
+            break;
+        }
+        size += bytes_read;
+    }
+
+    if (size == 0)
+    {
+        VirtualFree(data, 0, MEM_RELEASE);
+        return {nullptr, 0};
+    }
+    DWORD previous_protection;
+    VirtualProtect(data, size, PAGE_READONLY, &previous_protection);
+    return {data, size};
+}
+} // namespace
+
+namespace driver
+{
+std::filesystem::path get_executable_path()
+{
+    char *exe_path_c_str;
+    if (_get_pgmptr(&exe_path_c_str) != 0)
+    {
+        throw std::runtime_error("failed to get the path of the executable");
+    }
+    return exe_path_c_str;
+}
+
+Module::Module(void *const handle) : m_handle(handle)
+{
+}
+
+Module::Module(Module &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+{
+}
+
+Module &Module::operator=(Module &&other) noexcept
+{
+    std::swap(m_handle, other.m_handle);
+    return *this;
+}
+
+Module::~Module()
+{
+    if (m_handle)
+    {
+        FreeLibrary(static_cast<HMODULE>(m_handle));
+    }
+}
+
+std::optional<Module> Module::load(const std::filesystem::path &path, std::string &error)
+{
+    const HMODULE library = LoadLibraryW(path.c_str());
+    if (library == nullptr)
+    {
+        error = "LoadLibrary failed with error " + std::to_string(GetLastError());
+        return std::nullopt;
+    }
+    return Module{library};
+}
+
+void *Module::find_symbol(const char *const name) const
+{
+    return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(m_handle), name));
+}
+
+Input_buffer::Input_buffer(const char *const data, const std::size_t size, const bool mapped)
+    : m_data(data), m_size(size), m_mapped(mapped), m_line_offsets(aoc::index_lines({data, size}))
+{
+}
+
+Input_buffer::Input_buffer(Input_buffer &&other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_mapped(other.m_mapped),
+      m_line_offsets(std::move(other.m_line_offsets))
+{
+}
+
+Input_buffer &Input_buffer::operator=(Input_buffer &&other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    std::swap(m_mapped, other.m_mapped);
+    std::swap(m_line_offsets, other.m_line_offsets);
+    return *this;
+}
+
+Input_buffer::~Input_buffer()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+    if (m_mapped)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    else
+    {
+        VirtualFree(const_cast<char *>(m_data), 0, MEM_RELEASE);
+    }
+}
+
+Input_buffer Input_buffer::load(const std::filesystem::path &path)
+{
+    if (path.empty())
+    {
+        const HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+        if (input == INVALID_HANDLE_VALUE || input == nullptr)
+        {
+            throw_last_error("GetStdHandle");
+        }
+        const auto [data, size] = read_into_pages(input);
+        return {data, size, false};
+    }
+
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw_last_error("CreateFile");
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size))
+    {
+        CloseHandle(file);
+        throw_last_error("GetFileSizeEx");
+    }
+    if (file_size.QuadPart == 0)
+    {
+        // Empty files can't be mapped
+        CloseHandle(file);
+        return {nullptr, 0, true};
+    }
+
+    // The view keeps the file open, so the handles can be closed straight away
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        throw_last_error("CreateFileMapping");
+    }
+    const void *const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (data == nullptr)
+    {
+        throw_last_error("MapViewOfFile");
+    }
+    return {static_cast<const char *>(data), static_cast<std::size_t>(file_size.QuadPart), true};
+}
+
+Run_result run_solution(const Solution &solution, const int argc, char **argv, const Run_limits &limits,
+                        const Run_options &options)
+{
+    // The solutions read and write the global streams, so only one of them can be redirected at a time
+    static std::mutex s_redirect_mutex;
+    std::unique_lock lock(s_redirect_mutex, std::defer_lock);
+    std::ifstream input;
+    std::ostringstream output;
+    std::streambuf *const previous_input = std::cin.rdbuf();
+    std::streambuf *const previous_output = std::cout.rdbuf();
+    if (!options.input_path.empty() || options.capture_output)
+    {
+        lock.lock();
+        if (!options.input_path.empty())
+        {
+            input.open(options.input_path);
+            if (!input)
+            {
+                Run_result result;
+                result.status = Run_status::crashed;
+                result.message = "failed to open " + options.input_path.string();
+                return result;
+            }
+            std::cin.rdbuf(input.rdbuf());
+        }
+        if (options.capture_output)
+        {
+            std::cout.rdbuf(output.rdbuf());
+        }
+    }
+
+    struct Stream_restorer
+    {
+        std::streambuf *input;
+        std::streambuf *output;
+
+        ~Stream_restorer()
+        {
+            std::cin.rdbuf(input);
+            std::cout.rdbuf(output);
+        }
+    } restorer{previous_input, previous_output};
+
+    // C++ std::async/std::future does not support timeouts directly, so we need to implement it ourselves
+    bool tests_passed = true;
+    std::vector<Iteration_times> iterations;
+    Allocation_profile allocations;
+    Counter_profile counters;
+    std::stop_source stop_source;
+    const Stop_token_scope stop_scope(solution, stop_source.get_token());
+    std::thread worker([&tests_passed, &iterations, &allocations, &counters, &options, &solution, argc, argv,
+                        stop = stop_source.get_token()] {
+        if (options.test_fn)
+        {
+            // Keep the test report out of the captured answers unless something went wrong
+            std::ostringstream test_output;
+            std::streambuf *const previous = options.capture_output ? std::cout.rdbuf(test_output.rdbuf()) : nullptr;
+            tests_passed = options.test_fn(argc, argv) == 0;
+            if (previous)
+            {
+                std::cout.rdbuf(previous);
+            }
+            if (!tests_passed)
+            {
+                std::cerr << test_output.str();
+                return;
+            }
+        }
+        // The answers of a run that was asked to stop aren't printed
+        iterations = time_iterations(solution, argc, argv, options, &allocations, &counters, stop);
+    });
+
+    const auto finished = [&tests_passed, &iterations, &allocations, &counters, &options, &output, &solution] {
+        Run_result result;
+        result.status = tests_passed ? Run_status::finished : Run_status::tests_failed;
+        if (tests_passed && are_allocations_tracked())
+        {
+            result.allocations = allocations;
+        }
+        if (tests_passed && options.counters)
+        {
+            result.counters = counters;
+        }
+        result.solve_time = iterations.empty() ? std::chrono::nanoseconds{} : iterations.front().total;
+        result.iterations = std::move(iterations);
+        result.has_phases = solution.phases != nullptr;
+        result.output = output.str();
+        return result;
+    };
+
+    const HANDLE thread_handle = worker.native_handle();
+    const DWORD wait_milliseconds = static_cast<DWORD>(get_time_budget(limits, options).count());
+    const DWORD wait_result = WaitForSingleObject(thread_handle, wait_milliseconds);
+    if (wait_result == WAIT_OBJECT_0)
+    {
+        worker.join();
+        return finished();
+    }
+
+    assert(wait_result == WAIT_TIMEOUT);
+    if (wait_result != WAIT_TIMEOUT)
+    {
+        throw std::logic_error("Unexpected result from WaitForSingleObject");
+    }
+
+    // Don't terminate the thread if a debugger is attached
+    if (IsDebuggerPresent())
+    {
+        worker.join();
+        return finished();
+    }
+
+    // Timed out - ask the solution to stop, the ones polling the stop token return and everything they allocated is
+    // released as normal
+    stop_source.request_stop();
+    if (WaitForSingleObject(thread_handle, static_cast<DWORD>(stop_grace_period.count())) == WAIT_OBJECT_0)
+    {
+        worker.join();
+        Run_result result;
+        result.status = Run_status::timed_out;
+        result.message = "the solution stopped when asked";
+        return result;
+    }
+
+    // The solution didn't stop, so terminate the thread. Whatever it had allocated is leaked, so solutions with long
+    // searches should poll the stop token.
+    if (!TerminateThread(thread_handle, 1))
+    {
+        throw std::logic_error("Failed to terminate thread");
+    }
+    worker.join();
+    Run_result result;
+    result.status = Run_status::timed_out;
+    result.message = "terminated the solution thread";
+    result.output = output.str();
+    return result;
+}
+} // namespace driver
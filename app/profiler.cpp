@@ -0,0 +1,476 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Only defined by recent versions of glibc
+#if !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace
+{
+constexpr int max_depth = 64;
+// About half a minute of samples at the default rate
+constexpr std::size_t max_samples = std::size_t{1} << 15;
+// The signal handler and the signal trampoline are at the top of every stack
+constexpr int skipped_frames = 2;
+
+struct Sample
+{
+    int depth;
+    void *frames[max_depth];
+};
+
+std::unique_ptr<Sample[]> s_samples;
+std::atomic<std::size_t> s_sample_count = 0;
+std::atomic<std::uint64_t> s_dropped = 0;
+std::atomic<int> s_perf_fd = -1;
+std::optional<timer_t> s_timer;
+int s_rate = 0;
+bool s_handler_installed = false;
+
+void on_sample(int, siginfo_t *, void *)
+{
+    const int saved_errno = errno;
+    // Only the profiled thread gets the signal, so there is a single writer
+    const std::size_t index = s_sample_count.load(std::memory_order_relaxed);
+    if (index < max_samples)
+    {
+        Sample &sample = s_samples[index];
+        sample.depth = backtrace(sample.frames, max_depth);
+        s_sample_count.store(index + 1, std::memory_order_release);
+    }
+    else
+    {
+        s_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (const int fd = s_perf_fd.load(std::memory_order_relaxed); fd != -1)
+    {
+        // The event stops after each signal until it is refreshed
+        ioctl(fd, PERF_EVENT_IOC_REFRESH, 1);
+    }
+    errno = saved_errno;
+}
+
+bool start_perf_event(const long period)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_SOFTWARE;
+    attributes.config = PERF_COUNT_SW_TASK_CLOCK;
+    attributes.sample_period = static_cast<std::uint64_t>(period);
+    attributes.disabled = 1;
+    // Profiling the kernel would need more privileges than we have
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    // Overflows raise the signal on this thread rather than on the process
+    const f_owner_ex owner{F_OWNER_TID, gettid()};
+    if (fcntl(fd, F_SETFL, O_ASYNC) == -1 || fcntl(fd, F_SETSIG, SIGPROF) == -1 ||
+        fcntl(fd, F_SETOWN_EX, &owner) == -1)
+    {
+        close(fd);
+        return false;
+    }
+    s_perf_fd.store(fd, std::memory_order_relaxed);
+    if (ioctl(fd, PERF_EVENT_IOC_REFRESH, 1) == -1)
+    {
+        s_perf_fd.store(-1, std::memory_order_relaxed);
+        close(fd);
+        return false;
+    }
+    return true;
+}
+
+bool start_timer(const long period, std::string &error)
+{
+    sigevent event{};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = gettid();
+    timer_t timer;
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) == -1)
+    {
+        error = std::format("failed to create the profiling timer: {}", std::strerror(errno));
+        return false;
+    }
+
+    const timespec interval{period / 1'000'000'000, period % 1'000'000'000};
+    const itimerspec spec{interval, interval};
+    if (timer_settime(timer, 0, &spec, nullptr) == -1)
+    {
+        error = std::format("failed to start the profiling timer: {}", std::strerror(errno));
+        timer_delete(timer);
+        return false;
+    }
+    s_timer = timer;
+    return true;
+}
+
+std::string demangle(const char *const name)
+{
+    int status = 0;
+    char *const demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0)
+    {
+        return name;
+    }
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+}
+
+struct Symbol
+{
+    std::uintptr_t start;
+    std::uintptr_t end;
+    std::string name;
+};
+
+/*
+ * The functions of a loaded module, read from its symbol table, or from the dynamic symbol table if it was stripped
+ */
+class Module_symbols
+{
+private:
+    // Added to the addresses in the file to get the addresses in memory
+    std::uintptr_t m_bias = 0;
+    std::vector<Symbol> m_symbols;
+
+    template <typename T> static std::optional<T> read(const std::string &contents, const std::uint64_t offset)
+    {
+        if (offset > contents.size() || contents.size() - offset < sizeof(T))
+        {
+            return std::nullopt;
+        }
+        T value;
+        std::memcpy(&value, contents.data() + offset, sizeof(T));
+        return value;
+    }
+
+    void add_symbols(const std::string &contents, const Elf64_Shdr &table, const Elf64_Shdr &names)
+    {
+        for (std::uint64_t offset = 0; offset + sizeof(Elf64_Sym) <= table.sh_size; offset += sizeof(Elf64_Sym))
+        {
+            const std::optional<Elf64_Sym> symbol = read<Elf64_Sym>(contents, table.sh_offset + offset);
+            if (!symbol)
+            {
+                return;
+            }
+            if (ELF64_ST_TYPE(symbol->st_info) != STT_FUNC || symbol->st_shndx == SHN_UNDEF || symbol->st_value == 0 ||
+                symbol->st_name >= names.sh_size || names.sh_offset + names.sh_size > contents.size())
+            {
+                continue;
+            }
+            const char *const name = contents.data() + names.sh_offset + symbol->st_name;
+            const std::uintptr_t start = m_bias + symbol->st_value;
+            m_symbols.push_back({start, start + std::max<std::uint64_t>(symbol->st_size, 1), demangle(name)});
+        }
+    }
+
+public:
+    static Module_symbols load(const std::filesystem::path &path, const std::uintptr_t base)
+    {
+        Module_symbols module;
+        std::ifstream file(path, std::ios_base::binary);
+        const std::string contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        const std::optional<Elf64_Ehdr> header = read<Elf64_Ehdr>(contents, 0);
+        if (!header || std::memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 || header->e_ident[EI_CLASS] != ELFCLASS64)
+        {
+            return module;
+        }
+
+        // The module is mapped from the start of the page holding its first segment
+        std::uintptr_t first_address = UINTPTR_MAX;
+        for (std::uint16_t i = 0; i < header->e_phnum; ++i)
+        {
+            const std::optional<Elf64_Phdr> segment =
+                read<Elf64_Phdr>(contents, header->e_phoff + std::uint64_t{i} * header->e_phentsize);
+            if (segment && segment->p_type == PT_LOAD)
+            {
+                first_address = std::min<std::uintptr_t>(first_address, segment->p_vaddr);
+            }
+        }
+        if (first_address == UINTPTR_MAX)
+        {
+            return module;
+        }
+        const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        module.m_bias = base - (first_address & ~(page_size - 1));
+
+        std::vector<Elf64_Shdr> sections;
+        for (std::uint16_t i = 0; i < header->e_shnum; ++i)
+        {
+            const std::optional<Elf64_Shdr> section =
+                read<Elf64_Shdr>(contents, header->e_shoff + std::uint64_t{i} * header->e_shentsize);
+            if (!section)
+            {
+                return module;
+            }
+            sections.push_back(*section);
+        }
+        for (const std::uint32_t type : {SHT_SYMTAB, SHT_DYNSYM})
+        {
+            for (const Elf64_Shdr &section : sections)
+            {
+                if (section.sh_type == type && section.sh_link < sections.size())
+                {
+                    module.add_symbols(contents, section, sections[section.sh_link]);
+                }
+            }
+            if (!module.m_symbols.empty())
+            {
+                break;
+            }
+        }
+
+        std::ranges::stable_sort(module.m_symbols, {}, &Symbol::start);
+        const auto duplicates = std::ranges::unique(module.m_symbols, {}, &Symbol::start);
+        module.m_symbols.erase(duplicates.begin(), duplicates.end());
+        return module;
+    }
+
+    [[nodiscard]] const Symbol *find(const std::uintptr_t address) const
+    {
+        const auto iter = std::ranges::upper_bound(m_symbols, address, {}, &Symbol::start);
+        if (iter == m_symbols.begin() || address >= std::prev(iter)->end)
+        {
+            return nullptr;
+        }
+        return &*std::prev(iter);
+    }
+};
+
+/*
+ * Names the functions the samples landed in, remembering every address and module already looked up
+ */
+class Symbolizer
+{
+private:
+    std::map<const void *, Module_symbols> m_modules;
+    std::unordered_map<std::uintptr_t, std::string> m_names;
+    const void *m_executable_base;
+
+public:
+    Symbolizer()
+    {
+        Dl_info info{};
+        m_executable_base = dladdr(reinterpret_cast<const void *>(&driver::write_profile), &info) ? info.dli_fbase
+                                                                                                  : nullptr;
+    }
+
+    const std::string &get_name(const std::uintptr_t address)
+    {
+        const auto [iter, inserted] = m_names.try_emplace(address);
+        if (!inserted)
+        {
+            return iter->second;
+        }
+
+        Dl_info info{};
+        if (!dladdr(reinterpret_cast<const void *>(address), &info) || !info.dli_fbase)
+        {
+            iter->second = "[unknown]";
+            return iter->second;
+        }
+        auto module_iter = m_modules.find(info.dli_fbase);
+        if (module_iter == m_modules.end())
+        {
+            // The name of the executable is only what it was started as, which may not be a path to it
+            const std::filesystem::path path =
+                info.dli_fbase == m_executable_base ? std::filesystem::path("/proc/self/exe") : info.dli_fname;
+            module_iter = m_modules
+                              .emplace(info.dli_fbase,
+                                       Module_symbols::load(path, reinterpret_cast<std::uintptr_t>(info.dli_fbase)))
+                              .first;
+        }
+
+        if (const Symbol *const symbol = module_iter->second.find(address))
+        {
+            iter->second = symbol->name;
+        }
+        else if (info.dli_sname)
+        {
+            iter->second = demangle(info.dli_sname);
+        }
+        else
+        {
+            iter->second = std::format("{}+{:#x}", std::filesystem::path(info.dli_fname).filename().string(),
+                                       address - reinterpret_cast<std::uintptr_t>(info.dli_fbase));
+        }
+        // Collapsed stacks separate the frames with semicolons
+        std::ranges::replace(iter->second, ';', ',');
+        return iter->second;
+    }
+};
+} // namespace
+
+namespace driver
+{
+bool start_profiling(const int rate, std::string &error)
+{
+    if (rate <= 0)
+    {
+        error = "the sampling rate has to be positive";
+        return false;
+    }
+
+    if (!s_samples)
+    {
+        s_samples = std::make_unique_for_overwrite<Sample[]>(max_samples);
+    }
+    s_sample_count.store(0, std::memory_order_relaxed);
+    s_dropped.store(0, std::memory_order_relaxed);
+    s_rate = rate;
+
+    if (!s_handler_installed)
+    {
+        // The first backtrace loads the unwinder, which mustn't happen inside the signal handler
+        void *frame = nullptr;
+        backtrace(&frame, 1);
+
+        struct sigaction action{};
+        action.sa_sigaction = &on_sample;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) == -1)
+        {
+            error = std::format("failed to install the signal handler: {}", std::strerror(errno));
+            return false;
+        }
+        // Left in place once installed, a signal can still be on its way after sampling stops
+        s_handler_installed = true;
+    }
+
+    const long period = std::max(1L, 1'000'000'000L / rate);
+    return start_perf_event(period) || start_timer(period, error);
+}
+
+void stop_profiling()
+{
+    if (const int fd = s_perf_fd.exchange(-1, std::memory_order_relaxed); fd != -1)
+    {
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        close(fd);
+    }
+    if (s_timer)
+    {
+        timer_delete(*s_timer);
+        s_timer.reset();
+    }
+}
+
+void add_sample(Profile_summary &summary, const std::span<const std::string *const> names)
+{
+    if (names.empty())
+    {
+        return;
+    }
+
+    std::string stack;
+    for (std::size_t frame = 0; frame < names.size(); ++frame)
+    {
+        stack += frame == 0 ? "" : ";";
+        stack += *names[frame];
+        // Recursive functions only count once towards their total
+        const auto callers = names.first(frame);
+        if (std::ranges::none_of(callers, [&](const std::string *const name) { return *name == *names[frame]; }))
+        {
+            ++summary.functions[*names[frame]].total;
+        }
+    }
+    ++summary.functions[*names.back()].self;
+    ++summary.stacks[stack];
+}
+
+bool write_profile(const std::filesystem::path &path, const std::size_t top, std::ostream &table, std::string &error)
+{
+    Symbolizer symbolizer;
+    Profile_summary summary;
+    const std::size_t sample_count = std::min(s_sample_count.load(std::memory_order_acquire), max_samples);
+    for (std::size_t i = 0; i < sample_count; ++i)
+    {
+        const Sample &sample = s_samples[i];
+        if (sample.depth <= skipped_frames)
+        {
+            continue;
+        }
+
+        std::vector<const std::string *> names;
+        for (int frame = sample.depth - 1; frame >= skipped_frames; --frame)
+        {
+            auto address = reinterpret_cast<std::uintptr_t>(sample.frames[frame]);
+            // Only the interrupted frame has the exact address, the rest hold the return address after the call
+            if (frame != skipped_frames)
+            {
+                --address;
+            }
+            names.push_back(&symbolizer.get_name(address));
+        }
+        add_sample(summary, names);
+    }
+
+    std::ofstream file(path);
+    for (const auto &[stack, count] : summary.stacks)
+    {
+        file << stack << ' ' << count << '\n';
+    }
+    file.close();
+    if (!file)
+    {
+        error = std::format("failed to write {}", path.string());
+        return false;
+    }
+
+    std::vector<std::pair<std::string, Function_samples>> ranked(summary.functions.begin(),
+                                                                  summary.functions.end());
+    std::ranges::sort(ranked, [](const auto &lhs, const auto &rhs) {
+        return std::tie(lhs.second.self, lhs.second.total) > std::tie(rhs.second.self, rhs.second.total);
+    });
+    ranked.resize(std::min(ranked.size(), top));
+
+    const std::uint64_t dropped = s_dropped.load(std::memory_order_relaxed);
+    table << std::format("{} samples at {} a second", sample_count, s_rate);
+    table << (dropped != 0 ? std::format(", {} dropped once the buffer filled up\n", dropped) : "\n");
+    table << std::format("{:>7} {:>7}  {}\n", "Self", "Total", "Function");
+    const double scale = sample_count == 0 ? 0 : 100.0 / static_cast<double>(sample_count);
+    for (const auto &[name, samples] : ranked)
+    {
+        table << std::format("{:>6.1f}% {:>6.1f}%  {}\n", static_cast<double>(samples.self) * scale,
+                             static_cast<double>(samples.total) * scale, name);
+    }
+    return true;
+}
+} // namespace driver
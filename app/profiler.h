@@ -0,0 +1,58 @@
+#ifndef AOC_PROFILER_H
+#define AOC_PROFILER_H
+
+#include <filesystem>
+#include <map>
+#include <ostream>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include <cstdint>
+
+namespace driver
+{
+/*
+ * Samples the stack of the thread running the solution, Linux only. A perf event counting the thread's CPU time raises
+ * a signal at every sample where the kernel allows it, otherwise a POSIX CPU time timer does. The signal handler only
+ * unwinds the stack into a buffer set aside up front, the addresses are turned into function names afterwards from the
+ * ELF symbol tables of the driver and the solution modules.
+ */
+
+/*
+ * Start sampling the calling thread this many times a second of CPU time, anything sampled before is thrown away.
+ * Returns false if neither way of sampling is available.
+ */
+bool start_profiling(int rate, std::string &error);
+
+void stop_profiling();
+
+struct Function_samples
+{
+    // Samples taken in the function itself
+    std::uint64_t self = 0;
+    // Samples with the function anywhere on the stack, counted once however deeply it recursed
+    std::uint64_t total = 0;
+};
+
+struct Profile_summary
+{
+    // Collapsed stacks and how many samples each was seen in
+    std::map<std::string, std::uint64_t> stacks;
+    std::unordered_map<std::string, Function_samples> functions;
+};
+
+/*
+ * Add the stack of one sample to the summary, the names of the frames start from the outermost caller. The names are
+ * compared by value, a function called from different places may be named by different strings.
+ */
+void add_sample(Profile_summary &summary, std::span<const std::string *const> names);
+
+/*
+ * Write the samples as collapsed stacks, one line per distinct stack with the callers first, as taken by flamegraph.pl
+ * and speedscope. The functions taking the most samples are listed in the table.
+ */
+bool write_profile(const std::filesystem::path &path, std::size_t top, std::ostream &table, std::string &error);
+} // namespace driver
+
+#endif
@@ -0,0 +1,136 @@
+#include "result_cache.h"
+
+#include "bench_history.h"
+#include "input_store.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+constexpr const char *cache_header = "# year day module input arguments last_used answers...\n";
+} // namespace
+
+namespace driver
+{
+std::optional<Cache_key> make_cache_key(const int year, const int day, const std::filesystem::path &module_path,
+                                        const std::filesystem::path &input_path,
+                                        const std::span<const std::string> arguments)
+{
+    const std::optional<std::uint64_t> module_hash = stream_hash_file(module_path);
+    const std::optional<std::uint64_t> input_hash = stream_hash_file(input_path);
+    if (!module_hash || !input_hash)
+    {
+        return std::nullopt;
+    }
+
+    Stream_hash arguments_hash;
+    for (const std::string &argument : arguments)
+    {
+        // Keep the boundaries so "ab" "c" and "a" "bc" are different
+        arguments_hash.update({argument.c_str(), argument.size() + 1});
+    }
+    return Cache_key{year, day, *module_hash, *input_hash, arguments_hash.finish()};
+}
+
+Result_cache Result_cache::load(const std::filesystem::path &path, const std::size_t capacity)
+{
+    Result_cache cache;
+    cache.m_path = path;
+    cache.m_capacity = capacity;
+
+    std::ifstream file(path);
+    for (std::string line; std::getline(file, line);)
+    {
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+        std::istringstream stream(line);
+        Cache_key key;
+        Entry entry;
+        stream >> key.year >> key.day >> std::hex >> key.module_hash >> key.input_hash >> key.arguments_hash >>
+            std::dec >> entry.last_used;
+        if (!stream)
+        {
+            continue;
+        }
+        bool valid = true;
+        for (std::string escaped; stream >> escaped;)
+        {
+            std::optional<std::string> answer = unescape_answer(escaped);
+            if (!answer)
+            {
+                valid = false;
+                break;
+            }
+            entry.answers.push_back(std::move(*answer));
+        }
+        if (valid)
+        {
+            cache.m_next_use = std::max(cache.m_next_use, entry.last_used + 1);
+            cache.m_entries[key] = std::move(entry);
+        }
+    }
+    return cache;
+}
+
+const std::vector<std::string> *Result_cache::find(const Cache_key &key) const
+{
+    const auto iter = m_entries.find(key);
+    return iter == m_entries.end() ? nullptr : &iter->second.answers;
+}
+
+void Result_cache::touch(const Cache_key &key)
+{
+    if (const auto iter = m_entries.find(key); iter != m_entries.end())
+    {
+        iter->second.last_used = m_next_use++;
+    }
+}
+
+void Result_cache::store(const Cache_key &key, std::vector<std::string> answers)
+{
+    m_entries[key] = {m_next_use++, std::move(answers)};
+}
+
+bool Result_cache::save(std::string &error)
+{
+    if (m_entries.size() > m_capacity)
+    {
+        std::vector<std::pair<std::uint64_t, Cache_key>> by_age;
+        by_age.reserve(m_entries.size());
+        for (const auto &[key, entry] : m_entries)
+        {
+            by_age.emplace_back(entry.last_used, key);
+        }
+        const auto evicted = static_cast<std::ptrdiff_t>(m_entries.size() - m_capacity);
+        std::ranges::nth_element(by_age, by_age.begin() + evicted);
+        for (auto iter = by_age.begin(); iter != by_age.begin() + evicted; ++iter)
+        {
+            m_entries.erase(iter->second);
+        }
+    }
+
+    std::string contents = cache_header;
+    for (const auto &[key, entry] : m_entries)
+    {
+        contents += std::format("{} {} {:016x} {:016x} {:016x} {}", key.year, key.day, key.module_hash,
+                                key.input_hash, key.arguments_hash, entry.last_used);
+        for (const std::string &answer : entry.answers)
+        {
+            contents += ' ';
+            contents += escape_answer(answer);
+        }
+        contents += '\n';
+    }
+    return write_file_atomically(m_path, contents, error);
+}
+
+std::filesystem::path get_default_result_cache_path(const std::filesystem::path &exe_directory)
+{
+    return exe_directory / "result_cache.txt";
+}
+} // namespace driver
@@ -0,0 +1,83 @@
+#ifndef AOC_RESULT_CACHE_H
+#define AOC_RESULT_CACHE_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+/*
+ * Everything the answers of a run depend on, a rebuilt module, a changed input or different arguments give a new key
+ */
+struct Cache_key
+{
+    int year = 0;
+    int day = 0;
+    std::uint64_t module_hash = 0;
+    std::uint64_t input_hash = 0;
+    std::uint64_t arguments_hash = 0;
+
+    auto operator<=>(const Cache_key &) const = default;
+};
+
+/*
+ * Hash the module and the input for the key, returns an empty optional if either can't be read. The arguments are
+ * everything passed to the solution after the program name.
+ */
+std::optional<Cache_key> make_cache_key(int year, int day, const std::filesystem::path &module_path,
+                                        const std::filesystem::path &input_path,
+                                        std::span<const std::string> arguments);
+
+/*
+ * The answers of earlier runs, kept next to the driver unless another path is given. Once there are more entries than
+ * the capacity the least recently used are dropped when the cache is saved.
+ *
+ * Lookups don't change the cache so any number of threads can look up at the same time, the hits are marked as used
+ * afterwards with touch.
+ */
+class Result_cache
+{
+private:
+    struct Entry
+    {
+        // The most recently used entry has the highest
+        std::uint64_t last_used;
+        std::vector<std::string> answers;
+    };
+
+    std::filesystem::path m_path;
+    std::size_t m_capacity = 0;
+    std::map<Cache_key, Entry> m_entries;
+    std::uint64_t m_next_use = 0;
+
+public:
+    /*
+     * Read the cache from the path, a missing cache is treated as empty and unreadable entries are skipped
+     */
+    static Result_cache load(const std::filesystem::path &path, std::size_t capacity);
+
+    [[nodiscard]] const std::vector<std::string> *find(const Cache_key &key) const;
+
+    void touch(const Cache_key &key);
+
+    void store(const Cache_key &key, std::vector<std::string> answers);
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    bool save(std::string &error);
+};
+
+std::filesystem::path get_default_result_cache_path(const std::filesystem::path &exe_directory);
+} // namespace driver
+
+#endif
@@ -0,0 +1,185 @@
+#include "scaling.h"
+
+#include "statistics.h"
+
+#include "generators.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+
+#include <cstdlib>
+
+namespace
+{
+// Width of the longest bar in the plot
+constexpr std::size_t plot_width = 50;
+
+struct Scaling_point
+{
+    std::size_t size;
+    driver::Timing_summary summary;
+};
+
+double to_milliseconds(const std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/*
+ * The slope of the least squares line through the timings on a log-log scale, so 1 for a linear solution and 2 for a
+ * quadratic one
+ */
+std::optional<double> fit_exponent(const std::vector<Scaling_point> &points)
+{
+    double count = 0;
+    double sum_x = 0;
+    double sum_y = 0;
+    double sum_xx = 0;
+    double sum_xy = 0;
+    for (const Scaling_point &point : points)
+    {
+        if (point.size == 0 || point.summary.median.count() <= 0)
+        {
+            continue;
+        }
+        const double x = std::log(static_cast<double>(point.size));
+        const double y = std::log(static_cast<double>(point.summary.median.count()));
+        count += 1;
+        sum_x += x;
+        sum_y += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+    const double denominator = count * sum_xx - sum_x * sum_x;
+    if (count < 2 || denominator <= 0)
+    {
+        return std::nullopt;
+    }
+    return (count * sum_xy - sum_x * sum_y) / denominator;
+}
+
+void print_plot(const std::vector<Scaling_point> &points)
+{
+    std::chrono::nanoseconds slowest{1};
+    for (const Scaling_point &point : points)
+    {
+        slowest = std::max(slowest, point.summary.median);
+    }
+    std::cout << std::format("{:>10}  {:>12}  {:>12}  {:>12}\n", "size", "median", "min", "max");
+    for (const Scaling_point &point : points)
+    {
+        const auto bar = static_cast<std::size_t>(std::lround(static_cast<double>(point.summary.median.count()) *
+                                                              plot_width / static_cast<double>(slowest.count())));
+        std::cout << std::format("{:>10}  {:>10.3f}ms  {:>10.3f}ms  {:>10.3f}ms  {}\n", point.size,
+                                 to_milliseconds(point.summary.median), to_milliseconds(point.summary.min),
+                                 to_milliseconds(point.summary.max), std::string(std::max<std::size_t>(bar, 1), '#'));
+    }
+}
+
+bool write_csv(const std::filesystem::path &path, const std::vector<Scaling_point> &points)
+{
+    std::ofstream file(path);
+    file << "size,median_ns,min_ns,max_ns,p90_ns\n";
+    for (const Scaling_point &point : points)
+    {
+        file << std::format("{},{},{},{},{}\n", point.size, point.summary.median.count(), point.summary.min.count(),
+                            point.summary.max.count(), point.summary.p90.count());
+    }
+    return static_cast<bool>(file.flush());
+}
+} // namespace
+
+namespace driver
+{
+int run_scaling(const Solution &solution, const Scaling_options &options)
+{
+    const generators::Generator *generator = generators::find_generator(options.year, options.day);
+    if (generator == nullptr)
+    {
+        std::cerr << "There is no input generator for " << options.year << " day " << options.day
+                  << ", the days with one are:";
+        for (const generators::Generator &available : generators::get_generators())
+        {
+            std::cerr << ' ' << available.year << '/' << available.day;
+        }
+        std::cerr << '\n';
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::format("{} day {}, size is the {}, {} {} of each size after {} warmup\n", options.year,
+                             options.day, generator->size_description, options.iterations,
+                             options.iterations == 1 ? "run" : "runs", options.warmup);
+
+    std::vector<Scaling_point> points;
+    int exit_code = EXIT_SUCCESS;
+    for (const std::size_t size : options.sizes)
+    {
+        const generators::Generated_input input = generator->generate(options.seed, size);
+        const std::string file_name = std::format("aoc_scaling_{}_{}_{}.txt", options.year, options.day, size);
+        const std::filesystem::path input_path = std::filesystem::temp_directory_path() / file_name;
+        {
+            std::ofstream file(input_path, std::ios_base::binary);
+            if (!(file << input.text) || !file.flush())
+            {
+                std::cerr << "Failed to write the generated input: " << input_path.string() << '\n';
+                exit_code = EXIT_FAILURE;
+                break;
+            }
+        }
+
+        std::vector<std::string> arguments = options.arguments;
+        arguments.insert(arguments.begin() + 1, input.arguments.begin(), input.arguments.end());
+        std::vector<char *> argv;
+        for (std::string &argument : arguments)
+        {
+            argv.push_back(argument.data());
+        }
+        argv.push_back(nullptr);
+
+        Run_options run_options;
+        run_options.input_path = input_path;
+        run_options.capture_output = true;
+        run_options.warmup = options.warmup;
+        run_options.iterations = options.iterations;
+        const Run_result result =
+            run_solution(solution, static_cast<int>(arguments.size()), argv.data(), options.limits, run_options);
+        std::error_code ignored;
+        std::filesystem::remove(input_path, ignored);
+
+        if (result.status != Run_status::finished)
+        {
+            const char *failure = result.status == Run_status::timed_out ? "timed out" : "crashed";
+            std::cerr << "The solution " << failure << " on size " << size << " (" << result.message << ")\n";
+            exit_code = EXIT_FAILURE;
+            break;
+        }
+
+        std::vector<std::chrono::nanoseconds> durations;
+        for (const Iteration_times &times : result.iterations)
+        {
+            durations.push_back(times.total);
+        }
+        points.push_back({size, summarize(std::move(durations))});
+    }
+
+    if (!points.empty())
+    {
+        print_plot(points);
+        if (const std::optional<double> exponent = fit_exponent(points))
+        {
+            std::cout << std::format("The time grows with size^{:.2f}\n", *exponent);
+        }
+        if (!options.output_path.empty() && !write_csv(options.output_path, points))
+        {
+            std::cerr << "Failed to write the scaling report: " << options.output_path.string() << '\n';
+            exit_code = EXIT_FAILURE;
+        }
+    }
+    return exit_code;
+}
+} // namespace driver
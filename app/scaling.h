@@ -0,0 +1,36 @@
+#ifndef AOC_SCALING_H
+#define AOC_SCALING_H
+
+#include "platform.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+struct Scaling_options
+{
+    int year;
+    int day;
+    // The sizes of the generated inputs, in the order they are run
+    std::vector<std::size_t> sizes;
+    std::uint64_t seed;
+    int warmup;
+    int iterations;
+    Run_limits limits;
+    // The program name and any arguments the driver didn't recognise, the generated sizes go straight after the name
+    std::vector<std::string> arguments;
+    // Write the timings of every size to this file as CSV if set
+    std::filesystem::path output_path;
+};
+
+/*
+ * Benchmark the solution on a generated input of each size and report how its time grows with the size. Stops at the
+ * first size the solution fails on. Returns non-zero if there's no generator for the day or a run failed.
+ */
+int run_scaling(const Solution &solution, const Scaling_options &options);
+} // namespace driver
+
+#endif
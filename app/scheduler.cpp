@@ -0,0 +1,99 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+class Job_queue
+{
+private:
+    std::mutex m_mutex;
+    std::deque<std::size_t> m_jobs;
+
+public:
+    void push(const std::size_t job)
+    {
+        const std::lock_guard lock(m_mutex);
+        m_jobs.push_back(job);
+    }
+
+    std::optional<std::size_t> pop_front()
+    {
+        const std::lock_guard lock(m_mutex);
+        if (m_jobs.empty())
+        {
+            return std::nullopt;
+        }
+        const std::size_t job = m_jobs.front();
+        m_jobs.pop_front();
+        return job;
+    }
+
+    std::optional<std::size_t> steal_back()
+    {
+        const std::lock_guard lock(m_mutex);
+        if (m_jobs.empty())
+        {
+            return std::nullopt;
+        }
+        const std::size_t job = m_jobs.back();
+        m_jobs.pop_back();
+        return job;
+    }
+};
+
+std::optional<std::size_t> find_job(std::vector<std::unique_ptr<Job_queue>> &queues, const std::size_t self)
+{
+    if (std::optional<std::size_t> job = queues[self]->pop_front())
+    {
+        return job;
+    }
+
+    // No jobs are added once the threads have started, so if every queue is empty we're done
+    for (std::size_t i = 1; i < queues.size(); ++i)
+    {
+        if (std::optional<std::size_t> job = queues[(self + i) % queues.size()]->steal_back())
+        {
+            return job;
+        }
+    }
+    return std::nullopt;
+}
+} // namespace
+
+namespace driver
+{
+unsigned run_work_stealing(const std::size_t job_count, unsigned thread_count,
+                       const std::function<void(std::size_t)> &fn)
+{
+    thread_count = static_cast<unsigned>(std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(job_count, 1)));
+
+    std::vector<std::unique_ptr<Job_queue>> queues;
+    for (unsigned i = 0; i < thread_count; ++i)
+    {
+        queues.push_back(std::make_unique<Job_queue>());
+    }
+    for (std::size_t job = 0; job < job_count; ++job)
+    {
+        queues[job % thread_count]->push(job);
+    }
+
+    std::vector<std::jthread> threads;
+    for (unsigned i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&queues, &fn, i] {
+            while (const std::optional<std::size_t> job = find_job(queues, i))
+            {
+                fn(*job);
+            }
+        });
+    }
+    return thread_count;
+}
+} // namespace driver
@@ -0,0 +1,21 @@
+#ifndef AOC_SCHEDULER_H
+#define AOC_SCHEDULER_H
+
+#include <cstddef>
+#include <functional>
+
+namespace driver
+{
+/*
+ * Run fn for every job index in [0, job_count) using a pool of threads.
+ *
+ * The jobs are dealt out to the threads in index order so lower indices start first, put the most expensive jobs first
+ * to keep the critical path short. Each thread works through its own queue from the front and once it runs dry it
+ * steals from the back of the other queues.
+ *
+ * There is at least one thread and no more than there are jobs, returns how many were used.
+ */
+unsigned run_work_stealing(std::size_t job_count, unsigned thread_count, const std::function<void(std::size_t)> &fn);
+} // namespace driver
+
+#endif
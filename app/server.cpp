@@ -0,0 +1,540 @@
+#include "server.h"
+
+#include "layout.h"
+#include "loader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <format>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+volatile std::sig_atomic_t s_stop_requested = 0;
+
+extern "C" void request_stop(int)
+{
+    s_stop_requested = 1;
+}
+
+/*
+ * Owns a file descriptor and closes it when destroyed
+ */
+class File_descriptor
+{
+private:
+    int m_fd;
+
+public:
+    explicit File_descriptor(const int fd) : m_fd(fd)
+    {
+    }
+
+    File_descriptor(const File_descriptor &) = delete;
+    File_descriptor &operator=(const File_descriptor &) = delete;
+
+    ~File_descriptor()
+    {
+        if (m_fd != -1)
+        {
+            close(m_fd);
+        }
+    }
+
+    [[nodiscard]] int get() const
+    {
+        return m_fd;
+    }
+};
+
+bool send_all(const int fd, const std::string_view bytes)
+{
+    std::size_t sent = 0;
+    while (sent < bytes.size())
+    {
+        // The other end may have gone away, which shouldn't take the daemon down with a SIGPIPE
+        const ssize_t result = send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (result == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return false;
+        }
+        sent += static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+std::optional<sockaddr_un> make_address(const std::filesystem::path &path, std::string &error)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const std::string &native = path.native();
+    if (native.size() >= sizeof(address.sun_path))
+    {
+        error = std::format("the socket path {} is longer than {} characters", native, sizeof(address.sun_path) - 1);
+        return std::nullopt;
+    }
+    std::memcpy(address.sun_path, native.c_str(), native.size() + 1);
+    return address;
+}
+
+const char *to_string(const driver::Run_status status)
+{
+    switch (status)
+    {
+    case driver::Run_status::finished:
+        return "finished";
+    case driver::Run_status::timed_out:
+        return "timed_out";
+    case driver::Run_status::crashed:
+        return "crashed";
+    case driver::Run_status::tests_failed:
+        return "tests_failed";
+    }
+    return "unknown";
+}
+
+std::optional<driver::Run_status> parse_status(const std::string_view status)
+{
+    for (const driver::Run_status candidate : {driver::Run_status::finished, driver::Run_status::timed_out,
+                                               driver::Run_status::crashed, driver::Run_status::tests_failed})
+    {
+        if (status == to_string(candidate))
+        {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string format_reply(const std::string_view status, const std::chrono::nanoseconds solve_time,
+                         const std::string_view output, const std::string_view message)
+{
+    return std::format("{} {} {} {}\n{}{}", status, solve_time.count(), output.size(), message.size(), output,
+                       message);
+}
+
+enum class Test_state
+{
+    untested,
+    passed,
+    failed
+};
+
+// The default time for a module that doesn't exist
+std::filesystem::file_time_type get_write_time(const std::filesystem::path &path)
+{
+    std::error_code error;
+    const std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type() : time;
+}
+
+struct Cached_module
+{
+    std::optional<driver::Loaded_day> day;
+    // Why the solution can't be used, empty if it can
+    std::string error;
+    // When the modules were written as they were loaded, a rebuild changes these
+    std::filesystem::file_time_type module_time;
+    std::filesystem::file_time_type test_module_time;
+    // The tests run in the child of the first request and only their result is kept. Their module stays loaded, another
+    // request may be about to fork a child running them.
+    std::atomic<Test_state> tests = Test_state::untested;
+};
+
+/*
+ * The modules are loaded the first time a day is asked for and kept until they are rebuilt. A day is loaded again when
+ * the write time of its module or its tests' module changes, or when it failed to load. The requests still running the
+ * old modules keep them loaded until they are done.
+ */
+class Module_cache
+{
+private:
+    const driver::Server_options &m_options;
+    std::mutex m_mutex;
+    std::map<std::pair<int, int>, std::shared_ptr<Cached_module>> m_modules;
+
+    std::shared_ptr<Cached_module> load(const int year, const int day) const
+    {
+        auto cached = std::make_shared<Cached_module>();
+        // Taken before loading, so a module written while it is being loaded is loaded again by the next request
+        cached->module_time = get_write_time(driver::get_module_path(m_options.exe_directory, year, day));
+        cached->test_module_time = get_write_time(driver::get_test_module_path(m_options.exe_directory, year, day));
+        cached->day = driver::load_day(m_options.exe_directory, year, day, cached->error);
+        if (!cached->day || !m_options.run_tests)
+        {
+            return cached;
+        }
+        if (driver::load_tests(m_options.exe_directory, year, day, *cached->day, cached->error) &&
+            !cached->day->test)
+        {
+            // Nothing to run
+            cached->tests = Test_state::passed;
+        }
+        return cached;
+    }
+
+    [[nodiscard]] bool is_stale(const Cached_module &cached, const int year, const int day) const
+    {
+        return !cached.error.empty() ||
+               get_write_time(driver::get_module_path(m_options.exe_directory, year, day)) != cached.module_time ||
+               get_write_time(driver::get_test_module_path(m_options.exe_directory, year, day)) !=
+                   cached.test_module_time;
+    }
+
+public:
+    explicit Module_cache(const driver::Server_options &options) : m_options(options)
+    {
+    }
+
+    std::shared_ptr<Cached_module> get(const int year, const int day)
+    {
+        const std::lock_guard lock(m_mutex);
+        std::shared_ptr<Cached_module> &cached = m_modules[{year, day}];
+        if (!cached || is_stale(*cached, year, day))
+        {
+            if (cached && cached->error.empty())
+            {
+                std::cout << std::format("Reloading {} day {}, its module has been rebuilt", year, day) << std::endl;
+            }
+            // Unless a request still holds it the old module is closed first, otherwise a module rewritten in place
+            // could be opened as the old one again
+            cached.reset();
+            cached = load(year, day);
+        }
+        return cached;
+    }
+};
+
+std::string handle_request(const std::string_view line, Module_cache &cache, const driver::Server_options &options)
+{
+    int year = 0;
+    int day = 0;
+    std::istringstream stream{std::string(line)};
+    std::string input_path;
+    if (!(stream >> year >> day) || !std::getline(stream >> std::ws, input_path) || input_path.empty())
+    {
+        return format_reply("error", {}, {}, "expected '<year> <day> <input path>'");
+    }
+    if (year < driver::first_year || year > driver::last_year || day < 1 || day > driver::get_number_of_days(year))
+    {
+        return format_reply("error", {}, {}, std::format("there is no puzzle for {} day {}", year, day));
+    }
+    // The child would only say so on the daemon's standard error
+    if (const File_descriptor input(open(input_path.c_str(), O_RDONLY | O_CLOEXEC)); input.get() == -1)
+    {
+        return format_reply("error", {}, {}, std::format("failed to open {}: {}", input_path, std::strerror(errno)));
+    }
+
+    // Held until the request is done, a rebuild may replace the day in the cache in the meantime
+    const std::shared_ptr<Cached_module> cached_module = cache.get(year, day);
+    Cached_module &cached = *cached_module;
+    if (!cached.error.empty())
+    {
+        return format_reply("error", {}, {}, cached.error);
+    }
+    const Test_state tests = cached.tests.load();
+    if (tests == Test_state::failed)
+    {
+        return format_reply("tests_failed", {}, {}, "they failed when the day was first run");
+    }
+
+    std::vector<std::string> arguments = options.arguments;
+    std::vector<char *> argv;
+    for (std::string &argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    driver::Run_options run_options;
+    run_options.input_path = input_path;
+    run_options.capture_output = true;
+    // Until they have passed the tests run in the child along with the solution, so a test that crashes or hangs only
+    // takes the child with it
+    run_options.test_fn = tests == Test_state::untested ? cached.day->test : nullptr;
+    driver::Run_result result = driver::run_solution(cached.day->solution, static_cast<int>(arguments.size()),
+                                                     argv.data(), options.limits, run_options);
+    if (run_options.test_fn && result.status == driver::Run_status::finished)
+    {
+        cached.tests = Test_state::passed;
+    }
+    else if (result.status == driver::Run_status::tests_failed)
+    {
+        cached.tests = Test_state::failed;
+        result.message = "the report is in the daemon's standard error";
+    }
+    else if (result.status == driver::Run_status::timed_out)
+    {
+        // The client doesn't know the daemon's limits
+        result.message =
+            std::format("{}ms ({})", driver::get_time_budget(options.limits, run_options).count(), result.message);
+    }
+    return format_reply(to_string(result.status), result.solve_time, result.output, result.message);
+}
+
+void serve_connection(const int fd, Module_cache &cache, const driver::Server_options &options)
+{
+    const File_descriptor connection(fd);
+    std::string pending;
+    char buffer[4096];
+    while (true)
+    {
+        const ssize_t bytes_read = read(connection.get(), buffer, sizeof(buffer));
+        if (bytes_read == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read <= 0)
+        {
+            return;
+        }
+        pending.append(buffer, static_cast<std::size_t>(bytes_read));
+
+        for (std::size_t newline; (newline = pending.find('\n')) != std::string::npos;)
+        {
+            const std::string reply = handle_request(std::string_view(pending).substr(0, newline), cache, options);
+            pending.erase(0, newline + 1);
+            if (!send_all(connection.get(), reply))
+            {
+                return;
+            }
+        }
+    }
+}
+
+bool read_exactly(const int fd, std::string &bytes, const std::size_t size)
+{
+    char buffer[4096];
+    while (bytes.size() < size)
+    {
+        const ssize_t bytes_read = read(fd, buffer, std::min(sizeof(buffer), size - bytes.size()));
+        if (bytes_read == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read <= 0)
+        {
+            return false;
+        }
+        bytes.append(buffer, static_cast<std::size_t>(bytes_read));
+    }
+    return true;
+}
+
+std::string format_milliseconds(const std::chrono::nanoseconds duration)
+{
+    return std::format("{:.3f}ms", std::chrono::duration<double, std::milli>(duration).count());
+}
+} // namespace
+
+namespace driver
+{
+std::filesystem::path get_default_socket_path(const std::filesystem::path &exe_directory)
+{
+    return exe_directory / "aoc.sock";
+}
+
+int run_server(const Server_options &options)
+{
+    std::string error;
+    const std::optional<sockaddr_un> address = make_address(options.socket_path, error);
+    if (!address)
+    {
+        std::cerr << error << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const File_descriptor listener(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (listener.get() == -1)
+    {
+        std::cerr << "Failed to create the socket: " << std::strerror(errno) << '\n';
+        return EXIT_FAILURE;
+    }
+
+    // A socket left behind by a daemon that didn't exit cleanly can be replaced, a live one can't
+    {
+        const File_descriptor probe(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        if (connect(probe.get(), reinterpret_cast<const sockaddr *>(&*address), sizeof(*address)) == 0)
+        {
+            std::cerr << "Another daemon is already listening on " << options.socket_path << '\n';
+            return EXIT_FAILURE;
+        }
+        unlink(options.socket_path.c_str());
+    }
+
+    if (bind(listener.get(), reinterpret_cast<const sockaddr *>(&*address), sizeof(*address)) == -1 ||
+        listen(listener.get(), SOMAXCONN) == -1)
+    {
+        std::cerr << "Failed to listen on " << options.socket_path << ": " << std::strerror(errno) << '\n';
+        return EXIT_FAILURE;
+    }
+
+    struct sigaction action{};
+    action.sa_handler = request_stop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    std::cout << "Listening on " << options.socket_path << std::endl;
+
+    Module_cache cache(options);
+    std::mutex connections_mutex;
+    std::condition_variable connections_finished;
+    int connection_count = 0;
+    while (!s_stop_requested)
+    {
+        pollfd poll_fd{listener.get(), POLLIN, 0};
+        if (poll(&poll_fd, 1, 200) <= 0)
+        {
+            continue;
+        }
+
+        const int connection = accept4(listener.get(), nullptr, nullptr, SOCK_CLOEXEC);
+        if (connection == -1)
+        {
+            continue;
+        }
+
+        {
+            const std::lock_guard lock(connections_mutex);
+            ++connection_count;
+        }
+        std::thread([connection, &cache, &options, &connections_mutex, &connections_finished, &connection_count] {
+            try
+            {
+                serve_connection(connection, cache, options);
+            }
+            catch (const std::exception &ex)
+            {
+                std::cerr << "Failed to serve a request: " << ex.what() << '\n';
+            }
+            const std::lock_guard lock(connections_mutex);
+            --connection_count;
+            connections_finished.notify_all();
+        }).detach();
+    }
+
+    // The cache has to outlive the connections that are still being served
+    std::unique_lock lock(connections_mutex);
+    connections_finished.wait(lock, [&connection_count] { return connection_count == 0; });
+    unlink(options.socket_path.c_str());
+    return EXIT_SUCCESS;
+}
+
+int run_client(const Client_request &request)
+{
+    std::string error;
+    const std::optional<sockaddr_un> address = make_address(request.socket_path, error);
+    if (!address)
+    {
+        std::cerr << error << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const File_descriptor connection(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (connection.get() == -1 ||
+        connect(connection.get(), reinterpret_cast<const sockaddr *>(&*address), sizeof(*address)) == -1)
+    {
+        std::cerr << "Failed to connect to the daemon at " << request.socket_path << ": " << std::strerror(errno)
+                  << '\n';
+        return EXIT_FAILURE;
+    }
+
+    // The daemon has its own working directory
+    const std::string line =
+        std::format("{} {} {}\n", request.year, request.day, std::filesystem::absolute(request.input_path).string());
+    if (!send_all(connection.get(), line))
+    {
+        std::cerr << "Failed to send the request: " << std::strerror(errno) << '\n';
+        return EXIT_FAILURE;
+    }
+    shutdown(connection.get(), SHUT_WR);
+
+    std::string header;
+    for (char c; header.empty() || header.back() != '\n';)
+    {
+        const ssize_t bytes_read = read(connection.get(), &c, 1);
+        if (bytes_read == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (bytes_read <= 0)
+        {
+            std::cerr << "The daemon closed the connection without replying\n";
+            return EXIT_FAILURE;
+        }
+        header += c;
+    }
+
+    std::string status;
+    std::int64_t solve_nanoseconds = 0;
+    std::size_t output_size = 0;
+    std::size_t message_size = 0;
+    std::istringstream header_stream(header);
+    std::string output;
+    std::string message;
+    if (!(header_stream >> status >> solve_nanoseconds >> output_size >> message_size) ||
+        !read_exactly(connection.get(), output, output_size) ||
+        !read_exactly(connection.get(), message, message_size))
+    {
+        std::cerr << "The daemon sent an invalid reply\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << output;
+    if (status == "error")
+    {
+        std::cerr << message << '\n';
+        return EXIT_FAILURE;
+    }
+    // The same wording as a run without the daemon
+    const std::optional<Run_status> run_status = parse_status(status);
+    if (!run_status)
+    {
+        std::cerr << "The daemon sent an unknown status: " << status << '\n';
+        return EXIT_FAILURE;
+    }
+    switch (*run_status)
+    {
+    case Run_status::finished:
+        break;
+    case Run_status::timed_out:
+        std::cerr << "Solution timed out after " << message << '\n';
+        return EXIT_FAILURE;
+    case Run_status::crashed:
+        std::cerr << "Solution crashed (" << message << ")\n";
+        return EXIT_FAILURE;
+    case Run_status::tests_failed:
+        std::cerr << "Tests failed (" << message << ")\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Finished in " << format_milliseconds(std::chrono::nanoseconds(solve_nanoseconds)) << '\n';
+    return EXIT_SUCCESS;
+}
+} // namespace driver
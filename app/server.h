@@ -0,0 +1,58 @@
+#ifndef AOC_SERVER_H
+#define AOC_SERVER_H
+
+#include "platform.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace driver
+{
+/*
+ * The solver daemon keeps the solution modules loaded between requests so that scripts running the same days over and
+ * over only pay for running the solution. Requests and replies go over a Unix domain socket, one request per line:
+ *
+ *     <year> <day> <input path>
+ *
+ * and every reply is a header line followed by the output of the solution and then the message:
+ *
+ *     <status> <solve time in nanoseconds> <output size> <message size>
+ */
+struct Server_options
+{
+    std::filesystem::path exe_directory;
+    std::filesystem::path socket_path;
+    // The tests of a day run along with its first request, until they have passed once
+    bool run_tests;
+    Run_limits limits;
+    // Passed to every solution, the first argument is the program name
+    std::vector<std::string> arguments;
+};
+
+struct Client_request
+{
+    std::filesystem::path socket_path;
+    int year;
+    int day;
+    std::filesystem::path input_path;
+};
+
+/*
+ * The socket is put next to the driver unless another path is given
+ */
+std::filesystem::path get_default_socket_path(const std::filesystem::path &exe_directory);
+
+/*
+ * Serve requests until interrupted, returns non-zero if the socket couldn't be set up
+ */
+int run_server(const Server_options &options);
+
+/*
+ * Send a single request to the daemon and print the answers and timing like a normal run, returns non-zero if the
+ * solution didn't finish
+ */
+int run_client(const Client_request &request);
+} // namespace driver
+
+#endif
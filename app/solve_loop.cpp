@@ -0,0 +1,559 @@
+#include "solve_loop.h"
+
+#include "logging.h"
+#include "trace.h"
+#if !defined(_WIN32)
+#include "profiler.h"
+#endif
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <cstdint>
+
+namespace
+{
+/*
+ * Throws away everything written to it
+ */
+class Null_buffer : public std::streambuf
+{
+protected:
+    int_type overflow(const int_type ch) override
+    {
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char *, const std::streamsize count) override
+    {
+        return count;
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+/*
+ * Holds on to the answers until the solution is done so they are printed in order even when the parts run at the same
+ * time, and notes how long after the start of the timed call each one arrived
+ */
+class Answer_collector
+{
+private:
+    Clock::time_point m_start = Clock::now();
+    std::optional<std::string> m_answers[2];
+    std::chrono::nanoseconds m_times[2]{};
+
+    static void report(void *const context, const int part, const char *const answer, const std::size_t size)
+    {
+        auto &collector = *static_cast<Answer_collector *>(context);
+        if (part == 1 || part == 2)
+        {
+            collector.m_times[part - 1] = Clock::now() - collector.m_start;
+            collector.m_answers[part - 1].emplace(answer, size);
+        }
+    }
+
+public:
+    // Called right before the timed call, the meters and the sink take a while to set up
+    void start()
+    {
+        m_start = Clock::now();
+    }
+
+    [[nodiscard]] Aoc_answer_sink sink()
+    {
+        return {this, &report};
+    }
+
+    void finish(driver::Iteration_times &times) const
+    {
+        times.part_one_answer = m_times[0];
+        times.part_two_answer = m_times[1];
+        times.part_one_answered = m_answers[0].has_value();
+        times.part_two_answered = m_answers[1].has_value();
+    }
+
+    // Only the parts that were reported, the rest were printed by the solution
+    void print() const
+    {
+        for (const std::optional<std::string> &answer : m_answers)
+        {
+            if (answer)
+            {
+                std::cout << *answer << '\n';
+            }
+        }
+    }
+};
+
+/*
+ * Sends what the solution passes to aoc::answer to the collector for as long as this is alive, modules built before
+ * the answers went through the driver print them themselves
+ */
+class Answer_sink_scope
+{
+private:
+    const driver::Solution &m_solution;
+
+public:
+    Answer_sink_scope(const driver::Solution &solution, const Aoc_answer_sink &sink) : m_solution(solution)
+    {
+        if (m_solution.set_answer_sink)
+        {
+            m_solution.set_answer_sink(&sink);
+        }
+    }
+
+    Answer_sink_scope(const Answer_sink_scope &) = delete;
+    Answer_sink_scope &operator=(const Answer_sink_scope &) = delete;
+
+    ~Answer_sink_scope()
+    {
+        if (m_solution.set_answer_sink)
+        {
+            m_solution.set_answer_sink(nullptr);
+        }
+    }
+};
+
+/*
+ * Counts the allocations from when it is created, if there is a profile being taken
+ */
+class Allocation_meter
+{
+private:
+    bool m_enabled;
+    driver::Allocation_snapshot m_start;
+
+public:
+    explicit Allocation_meter(const bool enabled) : m_enabled(enabled)
+    {
+        if (m_enabled)
+        {
+            m_start = driver::take_allocation_snapshot();
+            driver::reset_allocation_peak();
+        }
+    }
+
+    void finish(driver::Allocation_stats &stats) const
+    {
+        if (m_enabled)
+        {
+            stats = driver::get_allocations_since(m_start);
+        }
+    }
+
+    [[nodiscard]] std::int64_t live_bytes_at_start() const
+    {
+        return static_cast<std::int64_t>(m_start.live_bytes);
+    }
+};
+
+/*
+ * Reads the counters from when it is created, if they are open
+ */
+class Counter_meter
+{
+private:
+    const driver::Counter_set *m_counters;
+    driver::Counter_values m_start;
+
+public:
+    explicit Counter_meter(const driver::Counter_set *const counters) : m_counters(counters)
+    {
+        if (m_counters)
+        {
+            m_start = m_counters->read();
+        }
+    }
+
+    void finish(driver::Counter_values &values) const
+    {
+        if (m_counters)
+        {
+            values = driver::get_counters_between(m_start, m_counters->read());
+        }
+    }
+};
+
+/*
+ * What is measured about a run besides its time, each profile is only passed when it is wanted
+ */
+struct Run_profiles
+{
+    driver::Allocation_profile *allocations = nullptr;
+    driver::Counter_profile *counters = nullptr;
+    // Open whenever the counters are wanted
+    const driver::Counter_set *counter_set = nullptr;
+
+    [[nodiscard]] Run_profiles only_if(const bool measured) const
+    {
+        return measured ? *this : Run_profiles{};
+    }
+};
+
+/*
+ * The call also shows up in the trace under the given name when tracing
+ */
+template <typename F> std::chrono::nanoseconds time_call(const char *const name, F f)
+{
+    const driver::Trace_scope trace(name);
+    const Clock::time_point start = Clock::now();
+    f();
+    return Clock::now() - start;
+}
+
+/*
+ * The allocations and counters of each phase are measured when their profiles are passed in
+ */
+driver::Iteration_times time_phases(const Aoc_phases &phases, const Aoc_input *const input_buffer, const int argc,
+                                    char **argv, const Run_profiles &profiles, Answer_collector &answers)
+{
+    driver::Allocation_profile *const profile = profiles.allocations;
+    driver::Iteration_times times;
+    const Aoc_answer_sink sink = answers.sink();
+
+    const Allocation_meter total_meter(profile != nullptr);
+    // The peak of the whole run is the highest of the phases' peaks, measured from the start of the run
+    std::int64_t total_peak = 0;
+    const auto finish_phase = [&](const Allocation_meter &meter, driver::Allocation_stats &stats) {
+        meter.finish(stats);
+        total_peak = std::max(total_peak, meter.live_bytes_at_start() - total_meter.live_bytes_at_start() +
+                                              static_cast<std::int64_t>(stats.peak_bytes));
+    };
+    driver::Allocation_profile unused_profile;
+    driver::Allocation_profile &allocations = profile ? *profile : unused_profile;
+
+    const driver::Counter_set *const counter_set = profiles.counters ? profiles.counter_set : nullptr;
+    driver::Counter_profile unused_counters;
+    driver::Counter_profile &counters = profiles.counters ? *profiles.counters : unused_counters;
+
+    const Clock::time_point start = Clock::now();
+    answers.start();
+    const Counter_meter total_counter_meter(counter_set);
+    std::unique_ptr<void, void (*)(void *)> input(nullptr, phases.destroy);
+    const Allocation_meter parse_meter(profile != nullptr);
+    const Counter_meter parse_counter_meter(counter_set);
+    times.parse = time_call("parse", [&] {
+        input.reset(input_buffer ? phases.parse_input(input_buffer, argc, argv) : phases.parse(argc, argv));
+    });
+    parse_counter_meter.finish(counters.parse);
+    finish_phase(parse_meter, allocations.parse);
+
+    if (phases.flags & AOC_PARTS_INDEPENDENT)
+    {
+        // Can't tell the allocations or the counters of the parts apart when they run at the same time
+        const Allocation_meter parts_meter(profile != nullptr);
+        const Counter_meter parts_counter_meter(counter_set);
+        allocations.parts_combined = true;
+        counters.parts_combined = true;
+        std::exception_ptr part_two_exception;
+        std::thread part_two_thread([&] {
+            try
+            {
+                times.part_two = time_call("part two", [&] { phases.part_two(input.get(), &sink); });
+            }
+            catch (...)
+            {
+                part_two_exception = std::current_exception();
+            }
+        });
+        try
+        {
+            times.part_one = time_call("part one", [&] { phases.part_one(input.get(), &sink); });
+        }
+        catch (...)
+        {
+            part_two_thread.join();
+            throw;
+        }
+        part_two_thread.join();
+        if (part_two_exception)
+        {
+            std::rethrow_exception(part_two_exception);
+        }
+        parts_counter_meter.finish(counters.part_one);
+        finish_phase(parts_meter, allocations.part_one);
+    }
+    else
+    {
+        const Allocation_meter part_one_meter(profile != nullptr);
+        const Counter_meter part_one_counter_meter(counter_set);
+        times.part_one = time_call("part one", [&] { phases.part_one(input.get(), &sink); });
+        part_one_counter_meter.finish(counters.part_one);
+        finish_phase(part_one_meter, allocations.part_one);
+
+        const Allocation_meter part_two_meter(profile != nullptr);
+        const Counter_meter part_two_counter_meter(counter_set);
+        times.part_two = time_call("part two", [&] { phases.part_two(input.get(), &sink); });
+        part_two_counter_meter.finish(counters.part_two);
+        finish_phase(part_two_meter, allocations.part_two);
+    }
+    input.reset();
+    times.total = Clock::now() - start;
+    total_counter_meter.finish(counters.total);
+    total_meter.finish(allocations.total);
+    allocations.total.peak_bytes = static_cast<std::uint64_t>(total_peak);
+
+    answers.finish(times);
+    return times;
+}
+
+/*
+ * The input buffer is only passed for solutions that take the input in memory. The answers reported through aoc::answer
+ * are left in the collector for the caller to print.
+ */
+driver::Iteration_times time_solve(const driver::Solution &solution, const Aoc_input *const input, const int argc,
+                                   char **argv, const Run_profiles &profiles, Answer_collector &answers)
+{
+    if (solution.phases)
+    {
+        return time_phases(*solution.phases, input, argc, argv, profiles, answers);
+    }
+
+    driver::Allocation_profile *const profile = profiles.allocations;
+    driver::Iteration_times times;
+    const Allocation_meter meter(profile != nullptr);
+    const Counter_meter counter_meter(profiles.counters ? profiles.counter_set : nullptr);
+    {
+        const Answer_sink_scope answer_scope(solution, answers.sink());
+        if (input)
+        {
+            times.total = time_call("solve", [&] {
+                answers.start();
+                solution.solve_input(input, argc, argv);
+            });
+        }
+        else
+        {
+            times.total = time_call("solve", [&] {
+                answers.start();
+                solution.solve(argc, argv);
+            });
+        }
+    }
+    if (profiles.counters)
+    {
+        counter_meter.finish(profiles.counters->total);
+    }
+    if (profile)
+    {
+        meter.finish(profile->total);
+    }
+    answers.finish(times);
+    return times;
+}
+} // namespace
+
+namespace driver
+{
+int Stop_token_scope::stop_requested(void *const context)
+{
+    return static_cast<const std::stop_token *>(context)->stop_requested() ? 1 : 0;
+}
+
+Stop_token_scope::Stop_token_scope(const Solution &solution, std::stop_token token)
+    : m_solution(solution), m_token(std::move(token))
+{
+    if (m_solution.set_stop_token)
+    {
+        const Aoc_stop_token stop_token{&m_token, &stop_requested};
+        m_solution.set_stop_token(&stop_token);
+    }
+}
+
+Stop_token_scope::~Stop_token_scope()
+{
+    if (m_solution.set_stop_token)
+    {
+        m_solution.set_stop_token(nullptr);
+    }
+}
+
+Tracing_scope::Tracing_scope(const Solution &solution, std::filesystem::path path)
+    : m_solution(solution), m_path(std::move(path))
+{
+    if (m_path.empty())
+    {
+        return;
+    }
+    start_tracing();
+    if (m_solution.set_tracer)
+    {
+        m_solution.set_tracer(&get_tracer());
+    }
+}
+
+Tracing_scope::~Tracing_scope()
+{
+    if (m_path.empty())
+    {
+        return;
+    }
+    if (m_solution.set_tracer)
+    {
+        m_solution.set_tracer(nullptr);
+    }
+    stop_tracing();
+    std::string error;
+    if (!write_chrome_trace(m_path, error))
+    {
+        std::cerr << "Failed to write the trace: " << error << '\n';
+    }
+}
+
+Logging_scope::Logging_scope(const Solution &solution, const bool enabled)
+    : m_solution(solution), m_enabled(enabled && solution.set_logger)
+{
+    if (m_enabled)
+    {
+        start_logging();
+        m_solution.set_logger(&get_logger());
+    }
+}
+
+Logging_scope::~Logging_scope()
+{
+    if (m_enabled)
+    {
+        m_solution.set_logger(nullptr);
+        stop_logging();
+    }
+}
+
+#if !defined(_WIN32)
+Profiling_scope::Profiling_scope(const Run_options &options) : m_options(options)
+{
+    if (m_options.profile_path.empty())
+    {
+        return;
+    }
+    std::string error;
+    m_started = start_profiling(m_options.profile_rate, error);
+    if (!m_started)
+    {
+        std::cerr << "Failed to start the profiler: " << error << '\n';
+    }
+}
+
+Profiling_scope::~Profiling_scope()
+{
+    if (!m_started)
+    {
+        return;
+    }
+    stop_profiling();
+    std::string error;
+    if (!write_profile(m_options.profile_path, m_options.profile_top, std::cerr, error))
+    {
+        std::cerr << "Failed to write the profile: " << error << '\n';
+    }
+}
+#endif
+
+std::vector<Iteration_times> time_iterations(const Solution &solution, const int argc, char **argv,
+                                             const Run_options &options, Allocation_profile *allocations,
+                                             Counter_profile *counters, const std::stop_token &stop)
+{
+    const Logging_scope logging(solution, options.verbose);
+    const Tracing_scope tracing(solution, options.trace_path);
+#if !defined(_WIN32)
+    const Profiling_scope profiling(options);
+#endif
+    if (!are_allocations_tracked())
+    {
+        allocations = nullptr;
+    }
+    // Opened once for all the iterations, opening the counters takes a few system calls each
+    std::optional<Counter_set> counter_set;
+    if (options.counters && counters)
+    {
+        counter_set.emplace();
+    }
+    const Run_profiles profiles{allocations, counter_set ? counters : nullptr, counter_set ? &*counter_set : nullptr};
+
+    // Loading and indexing the input is left out of the timings, every run shares the same read only copy
+    std::optional<Input_buffer> input_buffer;
+    Aoc_input input_view{};
+    if (solution.takes_input())
+    {
+        input_buffer = Input_buffer::load(options.input_path);
+        input_view = input_buffer->view();
+    }
+    const Aoc_input *const input_for_solve = input_buffer ? &input_view : nullptr;
+
+    // Only the answers of the first run are printed, and only once every run is done without being asked to stop.
+    // Whatever the solution came up with when it gave up isn't an answer.
+    std::optional<Answer_collector> first_answers;
+    const auto finish = [&](std::vector<Iteration_times> times) {
+        if (stop.stop_requested())
+        {
+            return std::vector<Iteration_times>();
+        }
+        first_answers->print();
+        return times;
+    };
+
+    if (options.warmup == 0 && options.iterations == 1)
+    {
+        first_answers.emplace();
+        return finish({time_solve(solution, input_for_solve, argc, argv, profiles, *first_answers)});
+    }
+
+    // Otherwise the standard input is rewound before each run
+    const std::string input = input_buffer ? std::string()
+                                           : std::string(std::istreambuf_iterator<char>(std::cin),
+                                                         std::istreambuf_iterator<char>());
+    Null_buffer null_buffer;
+
+    std::vector<Iteration_times> times;
+    {
+        struct Stream_restorer
+        {
+            std::streambuf *input = std::cin.rdbuf();
+            std::streambuf *output = std::cout.rdbuf();
+
+            ~Stream_restorer()
+            {
+                std::cin.rdbuf(input);
+                std::cout.rdbuf(output);
+            }
+        } restorer;
+
+        const int total = options.warmup + options.iterations;
+        for (int i = 0; i < total; ++i)
+        {
+            std::stringbuf rewound_input(input, std::ios_base::in);
+            std::cin.rdbuf(&rewound_input);
+            std::cin.clear();
+            if (i == 1)
+            {
+                std::cout.rdbuf(&null_buffer);
+            }
+
+            Answer_collector answers;
+            if (i == 0)
+            {
+                first_answers.emplace();
+            }
+            const Iteration_times iteration = time_solve(solution, input_for_solve, argc, argv,
+                                                         profiles.only_if(i == options.warmup),
+                                                         i == 0 ? *first_answers : answers);
+            if (i >= options.warmup)
+            {
+                times.push_back(iteration);
+            }
+        }
+    }
+    return finish(std::move(times));
+}
+} // namespace driver
@@ -0,0 +1,111 @@
+#ifndef AOC_SOLVE_LOOP_H
+#define AOC_SOLVE_LOOP_H
+
+#include "allocation_stats.h"
+#include "counters.h"
+#include "platform.h"
+
+#include <chrono>
+#include <filesystem>
+#include <stop_token>
+#include <vector>
+
+namespace driver
+{
+// How long a solution has after being asked to stop before it is killed
+inline constexpr std::chrono::milliseconds stop_grace_period{1000};
+
+/*
+ * Hands the solution a stop token that follows the given std::stop_token for as long as this is alive. Modules built
+ * before solutions could be stopped early are left alone.
+ */
+class Stop_token_scope
+{
+private:
+    const Solution &m_solution;
+    std::stop_token m_token;
+
+    static int stop_requested(void *context);
+
+public:
+    Stop_token_scope(const Solution &solution, std::stop_token token);
+    Stop_token_scope(const Stop_token_scope &) = delete;
+    Stop_token_scope &operator=(const Stop_token_scope &) = delete;
+    ~Stop_token_scope();
+};
+
+/*
+ * Records trace events from the driver and the solution for as long as this is alive and writes them out at the end.
+ * Does nothing when the path is empty.
+ */
+class Tracing_scope
+{
+private:
+    const Solution &m_solution;
+    std::filesystem::path m_path;
+
+public:
+    Tracing_scope(const Solution &solution, std::filesystem::path path);
+    Tracing_scope(const Tracing_scope &) = delete;
+    Tracing_scope &operator=(const Tracing_scope &) = delete;
+    ~Tracing_scope();
+};
+
+/*
+ * Passes the log lines of the solution on to std::clog through a background thread for as long as this is alive. Does
+ * nothing when it isn't enabled.
+ */
+class Logging_scope
+{
+private:
+    const Solution &m_solution;
+    bool m_enabled;
+
+public:
+    Logging_scope(const Solution &solution, bool enabled);
+    Logging_scope(const Logging_scope &) = delete;
+    Logging_scope &operator=(const Logging_scope &) = delete;
+    ~Logging_scope();
+};
+
+#if !defined(_WIN32)
+/*
+ * Samples the stacks of the calling thread for as long as this is alive, then writes the collapsed stacks to the
+ * profile path and a table of the busiest functions to the standard error. Does nothing when the path is empty.
+ */
+class Profiling_scope
+{
+private:
+    const Run_options &m_options;
+    bool m_started = false;
+
+public:
+    explicit Profiling_scope(const Run_options &options);
+    Profiling_scope(const Profiling_scope &) = delete;
+    Profiling_scope &operator=(const Profiling_scope &) = delete;
+    ~Profiling_scope();
+};
+#endif
+
+/*
+ * Call the solution as many times as the options ask for and time each of the measured iterations. Used by the
+ * platform specific runners once the input and output have been set up.
+ *
+ * Solutions taking the input in memory get it loaded once before any of the iterations. For the others, when there is
+ * more than one iteration the input is read into memory up front so it can be rewound before every iteration. Only the
+ * output of the first iteration is kept. The answers reported through aoc::answer are held until every iteration is
+ * done and then printed, the times they arrived are kept with the iteration. If the stop token was stopped by then the
+ * answers aren't printed and no times are returned. Solutions with phases are timed phase by phase,
+ * and if the parts are independent they are run on separate threads.
+ *
+ * When the driver counts allocations and a profile is passed in, it is filled in from the first measured iteration.
+ * The same goes for the counters when the options ask for them.
+ * Every iteration is traced when the options ask for a trace, logged when they ask for verbose output and sampled when
+ * they ask for a profile.
+ */
+std::vector<Iteration_times> time_iterations(const Solution &solution, int argc, char **argv,
+                                             const Run_options &options, Allocation_profile *allocations = nullptr,
+                                             Counter_profile *counters = nullptr, const std::stop_token &stop = {});
+} // namespace driver
+
+#endif
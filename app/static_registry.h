@@ -0,0 +1,69 @@
+#ifndef AOC_STATIC_REGISTRY_H
+#define AOC_STATIC_REGISTRY_H
+
+/*
+ * The table of solutions linked into aoc-static. The table itself is generated by aoc_generate_static_registry, every
+ * solution is compiled with AOC_SOLUTION_ID set so its entry points are named <id>_solve, <id>_phases and so on.
+ */
+
+#include "aoc_abi.h"
+
+#include <span>
+
+namespace driver
+{
+struct Static_solution
+{
+    int year;
+    int day;
+    Aoc_solve_function solve;
+    Aoc_set_stop_token_function set_stop_token;
+    Aoc_set_tracer_function set_tracer;
+    Aoc_set_logger_function set_logger;
+    Aoc_set_answer_sink_function set_answer_sink;
+    // The optional entry points are null if the solution doesn't define them
+    Aoc_solve_input_function solve_input;
+    Aoc_phases_function phases;
+};
+
+std::span<const Static_solution> get_static_solutions();
+} // namespace driver
+
+extern "C"
+{
+    // Stand ins for the optional entry points when the linker has no weak symbols
+    void aoc_static_no_solve_input(const Aoc_input *input, int argc, char **argv);
+    const Aoc_phases *aoc_static_no_phases();
+}
+
+#if defined(_MSC_VER)
+// The missing entry points are resolved to the stand ins and then turned back into null pointers
+#define AOC_DECLARE_OPTIONAL_ENTRY_POINTS(id)                                                                          \
+    extern "C" void id##_solve_input(const Aoc_input *input, int argc, char **argv);                                   \
+    extern "C" const Aoc_phases *id##_phases();                                                                        \
+    __pragma(comment(linker, "/alternatename:" #id "_solve_input=aoc_static_no_solve_input"))                         \
+        __pragma(comment(linker, "/alternatename:" #id "_phases=aoc_static_no_phases"))
+#define AOC_OPTIONAL_ENTRY_POINT(function, stand_in) (&function == &stand_in ? nullptr : &function)
+#else
+#define AOC_DECLARE_OPTIONAL_ENTRY_POINTS(id)                                                                          \
+    extern "C" __attribute__((weak)) void id##_solve_input(const Aoc_input *input, int argc, char **argv);             \
+    extern "C" __attribute__((weak)) const Aoc_phases *id##_phases();
+#define AOC_OPTIONAL_ENTRY_POINT(function, stand_in) (&function)
+#endif
+
+#define AOC_DECLARE_STATIC_SOLUTION(id)                                                                                \
+    extern "C" void id##_solve(int argc, char **argv);                                                                 \
+    extern "C" void id##_set_stop_token(const Aoc_stop_token *token);                                                  \
+    extern "C" void id##_set_tracer(const Aoc_tracer *tracer);                                                         \
+    extern "C" void id##_set_logger(const Aoc_logger *logger);                                                         \
+    extern "C" void id##_set_answer_sink(const Aoc_answer_sink *sink);                                                 \
+    AOC_DECLARE_OPTIONAL_ENTRY_POINTS(id)
+
+#define AOC_STATIC_SOLUTION(year, day, id)                                                                             \
+    {                                                                                                                  \
+        year, day, &id##_solve, &id##_set_stop_token, &id##_set_tracer, &id##_set_logger, &id##_set_answer_sink,       \
+            AOC_OPTIONAL_ENTRY_POINT(id##_solve_input, aoc_static_no_solve_input),                                     \
+            AOC_OPTIONAL_ENTRY_POINT(id##_phases, aoc_static_no_phases)                                                \
+    }
+
+#endif
@@ -0,0 +1,62 @@
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/*
+ * Linear interpolation between the closest ranks
+ *
+ * @pre std::ranges::is_sorted(samples) && !samples.empty()
+ */
+std::chrono::nanoseconds percentile(const std::vector<std::chrono::nanoseconds> &samples, const double p)
+{
+    const double rank = p * static_cast<double>(samples.size() - 1);
+    const auto lower = static_cast<std::size_t>(std::floor(rank));
+    const std::size_t upper = std::min(lower + 1, samples.size() - 1);
+    const double fraction = rank - static_cast<double>(lower);
+    const double value = static_cast<double>(samples[lower].count()) +
+                         fraction * static_cast<double>((samples[upper] - samples[lower]).count());
+    return std::chrono::nanoseconds(std::llround(value));
+}
+} // namespace
+
+namespace driver
+{
+Timing_summary summarize(std::vector<std::chrono::nanoseconds> samples)
+{
+    if (samples.empty())
+    {
+        return {};
+    }
+
+    std::ranges::sort(samples);
+
+    double sum = 0;
+    for (const std::chrono::nanoseconds sample : samples)
+    {
+        sum += static_cast<double>(sample.count());
+    }
+    const double mean = sum / static_cast<double>(samples.size());
+
+    double squares = 0;
+    for (const std::chrono::nanoseconds sample : samples)
+    {
+        const double difference = static_cast<double>(sample.count()) - mean;
+        squares += difference * difference;
+    }
+    // Sample standard deviation, a single sample has no spread
+    const double variance = samples.size() > 1 ? squares / static_cast<double>(samples.size() - 1) : 0.0;
+
+    Timing_summary summary;
+    summary.min = samples.front();
+    summary.median = percentile(samples, 0.5);
+    summary.p90 = percentile(samples, 0.9);
+    summary.p99 = percentile(samples, 0.99);
+    summary.max = samples.back();
+    summary.mean = std::chrono::nanoseconds(std::llround(mean));
+    summary.standard_deviation = std::chrono::nanoseconds(std::llround(std::sqrt(variance)));
+    return summary;
+}
+} // namespace driver
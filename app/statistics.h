@@ -0,0 +1,26 @@
+#ifndef AOC_STATISTICS_H
+#define AOC_STATISTICS_H
+
+#include <chrono>
+#include <vector>
+
+namespace driver
+{
+struct Timing_summary
+{
+    std::chrono::nanoseconds min{};
+    std::chrono::nanoseconds median{};
+    std::chrono::nanoseconds p90{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds max{};
+    std::chrono::nanoseconds mean{};
+    std::chrono::nanoseconds standard_deviation{};
+};
+
+/*
+ * Summarise a set of timings, the percentiles interpolate between the closest samples
+ */
+Timing_summary summarize(std::vector<std::chrono::nanoseconds> samples);
+} // namespace driver
+
+#endif
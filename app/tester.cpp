@@ -1,6 +1,8 @@
+#include "aoc_abi.h"
+
 #include <catch2/catch_session.hpp>
 
-extern "C" int test(int argc, char** argv)
+extern "C" AOC_EXPORT int test(int argc, char** argv)
 {
 	return Catch::Session().run(argc, argv);
 }
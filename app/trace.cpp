@@ -0,0 +1,256 @@
+#include "trace.h"
+
+#include "json.h"
+
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <cstdint>
+
+namespace
+{
+// 32MB per thread, enough for a few hundred thousand scopes before the oldest are overwritten
+constexpr std::size_t buffer_capacity = std::size_t{1} << 20;
+
+enum class Event_type : std::uint8_t
+{
+    begin,
+    end,
+    counter
+};
+
+struct Trace_event
+{
+    // Nanoseconds since tracing started
+    std::int64_t timestamp;
+    const char *name;
+    std::int64_t value;
+    Event_type type;
+};
+
+struct Thread_buffer
+{
+    std::unique_ptr<Trace_event[]> events = std::make_unique_for_overwrite<Trace_event[]>(buffer_capacity);
+    // The number of events ever written, only the last buffer_capacity of them are kept
+    std::atomic<std::uint64_t> written = 0;
+    std::uint32_t thread_index = 0;
+    Thread_buffer *next = nullptr;
+};
+
+std::atomic<bool> s_enabled = false;
+std::chrono::steady_clock::time_point s_start;
+// Every buffer ever created, threads come and go during a run but their events are kept until the trace is written
+std::atomic<Thread_buffer *> s_buffers = nullptr;
+std::atomic<std::uint32_t> s_thread_count = 0;
+// The buffers of threads that have exited, the next thread to record appends to one of these instead of allocating
+std::mutex s_free_mutex;
+std::vector<Thread_buffer *> s_free_buffers;
+
+Thread_buffer *take_free_buffer()
+{
+    std::scoped_lock lock(s_free_mutex);
+    if (s_free_buffers.empty())
+    {
+        return nullptr;
+    }
+    Thread_buffer *const buffer = s_free_buffers.back();
+    s_free_buffers.pop_back();
+    return buffer;
+}
+
+// Hands the thread's buffer back when the thread exits, some days start a thread for every run of part two
+class Buffer_lease
+{
+private:
+    Thread_buffer *m_buffer = nullptr;
+
+public:
+    Buffer_lease() = default;
+    Buffer_lease(const Buffer_lease &) = delete;
+    Buffer_lease &operator=(const Buffer_lease &) = delete;
+
+    ~Buffer_lease()
+    {
+        if (m_buffer)
+        {
+            std::scoped_lock lock(s_free_mutex);
+            s_free_buffers.push_back(m_buffer);
+        }
+    }
+
+    Thread_buffer *get() const
+    {
+        return m_buffer;
+    }
+
+    void reset(Thread_buffer *const buffer)
+    {
+        m_buffer = buffer;
+    }
+};
+
+thread_local Buffer_lease t_buffer;
+
+Thread_buffer &get_thread_buffer()
+{
+    if (!t_buffer.get())
+    {
+        Thread_buffer *buffer = take_free_buffer();
+        if (!buffer)
+        {
+            auto created = std::make_unique<Thread_buffer>();
+            created->thread_index = s_thread_count.fetch_add(1, std::memory_order_relaxed);
+            created->next = s_buffers.load(std::memory_order_relaxed);
+            while (!s_buffers.compare_exchange_weak(created->next, created.get(), std::memory_order_release,
+                                                    std::memory_order_relaxed))
+            {
+            }
+            buffer = created.release();
+        }
+        t_buffer.reset(buffer);
+    }
+    return *t_buffer.get();
+}
+
+void record(const Event_type type, const char *const name, const std::int64_t value)
+{
+    Thread_buffer &buffer = get_thread_buffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    const std::int64_t timestamp = (std::chrono::steady_clock::now() - s_start).count();
+    buffer.events[index % buffer_capacity] = {timestamp, name, value, type};
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void begin_scope(void *, const char *const name)
+{
+    record(Event_type::begin, name, 0);
+}
+
+void end_scope(void *)
+{
+    record(Event_type::end, nullptr, 0);
+}
+
+void counter(void *, const char *const name, const std::int64_t value)
+{
+    record(Event_type::counter, name, value);
+}
+
+constexpr Aoc_tracer s_tracer{nullptr, &begin_scope, &end_scope, &counter};
+
+void write_event(driver::Json_writer &writer, const char *const phase, const char *const name,
+                 const std::int64_t timestamp, const std::uint32_t thread_index)
+{
+    writer.key("name").value(name);
+    writer.key("ph").value(phase);
+    // The trace format wants microseconds
+    writer.key("ts").value(static_cast<double>(timestamp) / 1000);
+    writer.key("pid").value(1);
+    writer.key("tid").value(thread_index);
+}
+} // namespace
+
+namespace driver
+{
+void start_tracing()
+{
+    for (Thread_buffer *buffer = s_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+    {
+        buffer->written.store(0, std::memory_order_relaxed);
+    }
+    s_start = std::chrono::steady_clock::now();
+    s_enabled.store(true, std::memory_order_release);
+}
+
+void stop_tracing()
+{
+    s_enabled.store(false, std::memory_order_release);
+}
+
+const Aoc_tracer &get_tracer()
+{
+    return s_tracer;
+}
+
+Trace_scope::Trace_scope(const char *const name) : m_active(s_enabled.load(std::memory_order_acquire))
+{
+    if (m_active)
+    {
+        record(Event_type::begin, name, 0);
+    }
+}
+
+Trace_scope::~Trace_scope()
+{
+    if (m_active)
+    {
+        record(Event_type::end, nullptr, 0);
+    }
+}
+
+bool write_chrome_trace(const std::filesystem::path &path, std::string &error)
+{
+    Json_writer writer;
+    writer.begin_object();
+    writer.key("displayTimeUnit").value("ns");
+    writer.key("traceEvents").begin_array();
+    std::uint64_t dropped = 0;
+    for (Thread_buffer *buffer = s_buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+    {
+        const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > buffer_capacity ? written - buffer_capacity : 0;
+        dropped += first;
+
+        // The names of the scopes are only recorded when they begin, the ends of scopes whose beginnings were
+        // overwritten are skipped
+        std::vector<const char *> open_scopes;
+        for (std::uint64_t i = first; i < written; ++i)
+        {
+            const Trace_event &event = buffer->events[i % buffer_capacity];
+            switch (event.type)
+            {
+            case Event_type::begin:
+                open_scopes.push_back(event.name);
+                writer.begin_object();
+                write_event(writer, "B", event.name, event.timestamp, buffer->thread_index);
+                writer.end_object();
+                break;
+            case Event_type::end:
+                if (open_scopes.empty())
+                {
+                    break;
+                }
+                writer.begin_object();
+                write_event(writer, "E", open_scopes.back(), event.timestamp, buffer->thread_index);
+                writer.end_object();
+                open_scopes.pop_back();
+                break;
+            case Event_type::counter:
+                writer.begin_object();
+                write_event(writer, "C", event.name, event.timestamp, buffer->thread_index);
+                writer.key("args").begin_object().key("value").value(event.value).end_object();
+                writer.end_object();
+                break;
+            }
+        }
+    }
+    writer.end_array();
+    writer.key("otherData").begin_object().key("dropped_events").value(dropped).end_object();
+    writer.end_object();
+
+    std::ofstream file(path);
+    file << writer.str() << '\n';
+    file.close();
+    if (!file)
+    {
+        error = std::format("failed to write {}", path.string());
+        return false;
+    }
+    return true;
+}
+} // namespace driver
@@ -0,0 +1,50 @@
+#ifndef AOC_TRACE_H
+#define AOC_TRACE_H
+
+#include "aoc_abi.h"
+
+#include <filesystem>
+#include <string>
+
+namespace driver
+{
+/*
+ * Trace events from the driver and the solutions are recorded into a ring buffer per thread. A buffer is only written
+ * by its own thread so recording never takes a lock, once a buffer is full the oldest events are overwritten. When a
+ * thread exits its buffer is handed to the next new thread, so the events of short lived threads share a track.
+ */
+
+/*
+ * Start recording, anything recorded before is thrown away. Nothing may be recording at the time.
+ */
+void start_tracing();
+
+void stop_tracing();
+
+/*
+ * The tracer handed to the solutions, it records into the same buffers
+ */
+const Aoc_tracer &get_tracer();
+
+/*
+ * Records the driver's own scopes, does nothing unless tracing has been started
+ */
+class Trace_scope
+{
+private:
+    bool m_active;
+
+public:
+    explicit Trace_scope(const char *name);
+    Trace_scope(const Trace_scope &) = delete;
+    Trace_scope &operator=(const Trace_scope &) = delete;
+    ~Trace_scope();
+};
+
+/*
+ * Write everything recorded as Chrome trace event JSON, for chrome://tracing or Perfetto
+ */
+bool write_chrome_trace(const std::filesystem::path &path, std::string &error);
+} // namespace driver
+
+#endif
@@ -9,20 +9,85 @@ endfunction()
 
 function(add_solution day)
 	get_filename_component(AOC_YEAR ${CMAKE_CURRENT_LIST_DIR} NAME)
+	set(AOC_DAY_NUMBER ${day})
 	aoc_get_filename_padded(${day} day)
 	set(AOC_TARGET_NAME "${AOC_YEAR}_day${day}")
+	if(AOC_STATIC_BUILD)
+		aoc_add_static_solution(${AOC_YEAR} ${AOC_DAY_NUMBER} ${AOC_TARGET_NAME})
+		return()
+	endif()
+	# The solution is built twice, without the tests so runs that skip them load a small module with none of Catch2
+	# to map and relocate, and with them into a companion module the driver only loads to run the tests
 	add_library(${AOC_TARGET_NAME} MODULE "day${day}.cpp")
-	# Make all of these a dependency on the aoc target so that building the main app will build all solutions
-	add_dependencies(aoc ${AOC_TARGET_NAME})
-	set_target_properties(${AOC_TARGET_NAME} PROPERTIES
-		OUTPUT_NAME "day${day}"
-		FOLDER ${AOC_YEAR}
-	)
-	target_include_directories(${AOC_TARGET_NAME} PRIVATE "${PROJECT_SOURCE_DIR}/app")
-	target_link_libraries(${AOC_TARGET_NAME} PRIVATE Elf AoCTester)
-	if(WIN32)
-		target_link_options(${AOC_TARGET_NAME} PRIVATE "LINKER:-export:solve,-export:test")
+	target_compile_definitions(${AOC_TARGET_NAME} PRIVATE CATCH_CONFIG_DISABLE)
+	target_link_libraries(${AOC_TARGET_NAME} PRIVATE Elf Catch2::Catch2)
+	add_library(${AOC_TARGET_NAME}_test MODULE "day${day}.cpp")
+	target_link_libraries(${AOC_TARGET_NAME}_test PRIVATE Elf AoCTester)
+	foreach(target ${AOC_TARGET_NAME} ${AOC_TARGET_NAME}_test)
+		# Make all of these a dependency on the aoc target so that building the main app will build all solutions
+		add_dependencies(aoc ${target})
+		set_target_properties(${target} PROPERTIES
+			PREFIX ""
+			FOLDER ${AOC_YEAR}
+		)
+		target_include_directories(${target} PRIVATE "${PROJECT_SOURCE_DIR}/app")
+	endforeach()
+	set_target_properties(${AOC_TARGET_NAME} PROPERTIES OUTPUT_NAME "day${day}")
+	set_target_properties(${AOC_TARGET_NAME}_test PROPERTIES OUTPUT_NAME "day${day}_test")
+endfunction()
+
+# Compile the solution into an object library that is linked into aoc-static. The entry points are prefixed with
+# aoc_<year>_<day> so they don't clash, and the tests are compiled out since every day would share one Catch2 session.
+function(aoc_add_static_solution year day target)
+	aoc_get_filename_padded(${day} padded_day)
+	set(AOC_SOLUTION_ID "aoc_${year}_${padded_day}")
+	add_library(${target} OBJECT "day${padded_day}.cpp")
+	set_target_properties(${target} PROPERTIES FOLDER ${year})
+	target_compile_definitions(${target} PRIVATE AOC_STATIC_BUILD AOC_SOLUTION_ID=${AOC_SOLUTION_ID} CATCH_CONFIG_DISABLE)
+	target_include_directories(${target} PRIVATE "${PROJECT_SOURCE_DIR}/app")
+	target_link_libraries(${target} PRIVATE Elf Catch2::Catch2)
+	target_link_libraries(aoc-static PRIVATE ${target})
+	set_property(GLOBAL APPEND PROPERTY AOC_STATIC_SOLUTIONS "${year};${day};${AOC_SOLUTION_ID}")
+endfunction()
+
+# Write the table of every solution added with aoc_add_static_solution and add it to aoc-static, this is expected to be
+# called once all of the years have been added.
+function(aoc_generate_static_registry)
+	get_property(AOC_SOLUTIONS GLOBAL PROPERTY AOC_STATIC_SOLUTIONS)
+	set(AOC_DECLARATIONS "")
+	set(AOC_ENTRIES "")
+	list(LENGTH AOC_SOLUTIONS AOC_SOLUTION_FIELDS)
+	if(AOC_SOLUTION_FIELDS GREATER 0)
+		math(EXPR AOC_LAST_FIELD "${AOC_SOLUTION_FIELDS} - 1")
+		foreach(AOC_INDEX RANGE 0 ${AOC_LAST_FIELD} 3)
+			math(EXPR AOC_DAY_INDEX "${AOC_INDEX} + 1")
+			math(EXPR AOC_ID_INDEX "${AOC_INDEX} + 2")
+			list(GET AOC_SOLUTIONS ${AOC_INDEX} AOC_YEAR)
+			list(GET AOC_SOLUTIONS ${AOC_DAY_INDEX} AOC_DAY)
+			list(GET AOC_SOLUTIONS ${AOC_ID_INDEX} AOC_ID)
+			string(APPEND AOC_DECLARATIONS "AOC_DECLARE_STATIC_SOLUTION(${AOC_ID})\n")
+			string(APPEND AOC_ENTRIES "    AOC_STATIC_SOLUTION(${AOC_YEAR}, ${AOC_DAY}, ${AOC_ID}),\n")
+		endforeach()
 	endif()
+
+	set(AOC_REGISTRY_FILE "${CMAKE_BINARY_DIR}/aoc_static_registry.cpp")
+	file(CONFIGURE OUTPUT "${AOC_REGISTRY_FILE}" CONTENT [[
+// Generated by aoc_generate_static_registry in cmake/AdventOfCode.cmake
+#include "static_registry.h"
+
+@AOC_DECLARATIONS@
+namespace
+{
+const driver::Static_solution s_solutions[] = {
+@AOC_ENTRIES@};
+} // namespace
+
+std::span<const driver::Static_solution> driver::get_static_solutions()
+{
+    return s_solutions;
+}
+]] @ONLY)
+	target_sources(aoc-static PRIVATE "${AOC_REGISTRY_FILE}")
 endfunction()
 
 set(AOC_SOLUTION_TEMPLATE "#include \"aoc.h\"
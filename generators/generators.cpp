@@ -0,0 +1,32 @@
+#include "generators.h"
+
+#include <algorithm>
+
+namespace
+{
+// clang-format off
+const generators::Generator s_generators[] = {
+    {2018, 9, "value of the last marble, part two plays a hundred times as many", &generators::generate_2018_day09},
+    {2023, 12, "number of rows of springs", &generators::generate_2023_day12},
+    {2023, 16, "width and height of the contraption", &generators::generate_2023_day16},
+    {2023, 17, "width and height of the city", &generators::generate_2023_day17},
+    {2024, 14, "width of the room, the height is two more and the robots fill at least a twentieth of it",
+     &generators::generate_2024_day14},
+};
+// clang-format on
+} // namespace
+
+namespace generators
+{
+std::span<const Generator> get_generators()
+{
+    return s_generators;
+}
+
+const Generator *find_generator(const int year, const int day)
+{
+    const auto it = std::ranges::find_if(
+        s_generators, [&](const Generator &generator) { return generator.year == year && generator.day == day; });
+    return it == std::end(s_generators) ? nullptr : &*it;
+}
+} // namespace generators
@@ -0,0 +1,81 @@
+#ifndef AOC_GENERATORS_H
+#define AOC_GENERATORS_H
+
+/*
+ * Synthetic inputs for some of the days, so the solutions can be timed on inputs far smaller or larger than the real
+ * ones. The same seed and size always give the same input, with any standard library.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace generators
+{
+struct Generated_input
+{
+    std::string text;
+    // Passed to the solution after the program name, for the sizes it can't tell from the input
+    std::vector<std::string> arguments;
+};
+
+struct Generator
+{
+    int year;
+    int day;
+    // What the size means for this day
+    const char *size_description;
+    Generated_input (*generate)(std::uint64_t seed, std::size_t size);
+};
+
+/*
+ * The distributions of the standard library give different numbers with each implementation, so the generators only
+ * use the engine's output, which is fully specified
+ */
+class Random
+{
+private:
+    std::mt19937_64 m_engine;
+
+public:
+    explicit Random(const std::uint64_t seed) : m_engine(seed)
+    {
+    }
+
+    // A number in [0, count), the bias of the modulo doesn't matter for test inputs
+    [[nodiscard]] std::uint64_t below(const std::uint64_t count)
+    {
+        return m_engine() % count;
+    }
+
+    // A number in [low, high]
+    [[nodiscard]] std::int64_t between(const std::int64_t low, const std::int64_t high)
+    {
+        return low + static_cast<std::int64_t>(below(static_cast<std::uint64_t>(high - low) + 1));
+    }
+
+    // True once in every count calls on average
+    [[nodiscard]] bool one_in(const std::uint64_t count)
+    {
+        return below(count) == 0;
+    }
+};
+
+std::span<const Generator> get_generators();
+
+/*
+ * Returns null if there is no generator for the day
+ */
+const Generator *find_generator(int year, int day);
+
+Generated_input generate_2018_day09(std::uint64_t seed, std::size_t size);
+Generated_input generate_2023_day12(std::uint64_t seed, std::size_t size);
+Generated_input generate_2023_day16(std::uint64_t seed, std::size_t size);
+Generated_input generate_2023_day17(std::uint64_t seed, std::size_t size);
+Generated_input generate_2024_day14(std::uint64_t seed, std::size_t size);
+} // namespace generators
+
+#endif
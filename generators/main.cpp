@@ -0,0 +1,105 @@
+#include "generators.h"
+
+#include <cxxopts.hpp>
+
+#include <fstream>
+#include <iostream>
+
+#include <cstdlib>
+
+namespace
+{
+void list_generators()
+{
+    for (const generators::Generator &generator : generators::get_generators())
+    {
+        std::cout << generator.year << ' ' << generator.day << ": " << generator.size_description << '\n';
+    }
+}
+} // namespace
+
+/*
+ * Writes a synthetic input for a day, e.g. aoc-generate 2023 17 --size 500 --seed 3 > input.txt. The arguments the
+ * solution needs for the input's sizes are printed on the standard error, to be passed after the driver's options.
+ */
+int main(int argc, char **argv)
+{
+    cxxopts::Options options("aoc-generate", "Synthetic Advent of Code inputs");
+    // clang-format off
+	options.add_options()
+		("h,help", "print options")
+		("y,year", "year", cxxopts::value<int>())
+		("d,day", "day", cxxopts::value<int>())
+		("size", "size of the input, see --list for what it means for each day", cxxopts::value<std::size_t>())
+		("seed", "seed of the random numbers, the same seed and size give the same input",
+			cxxopts::value<std::uint64_t>()->default_value("1"))
+		("o,output", "write the input to this file instead of the standard output", cxxopts::value<std::string>())
+		("list", "list the days that have a generator")
+		;
+    // clang-format on
+    options.parse_positional({"year", "day"});
+    cxxopts::ParseResult result;
+    try
+    {
+        result = options.parse(argc, argv);
+    }
+    catch (const cxxopts::exceptions::parsing &ex)
+    {
+        std::cout << options.help() << '\n';
+        std::cerr << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("help"))
+    {
+        std::cout << options.help() << '\n';
+        return EXIT_SUCCESS;
+    }
+    if (result.count("list"))
+    {
+        list_generators();
+        return EXIT_SUCCESS;
+    }
+    if (!result.count("year") || !result.count("day") || !result.count("size"))
+    {
+        std::cerr << "The year, day and size are required\n";
+        return EXIT_FAILURE;
+    }
+
+    const generators::Generator *generator =
+        generators::find_generator(result["year"].as<int>(), result["day"].as<int>());
+    if (generator == nullptr)
+    {
+        std::cerr << "There is no generator for that day, the days with one are:\n";
+        list_generators();
+        return EXIT_FAILURE;
+    }
+
+    const generators::Generated_input input =
+        generator->generate(result["seed"].as<std::uint64_t>(), result["size"].as<std::size_t>());
+    if (result.count("output"))
+    {
+        const std::string path = result["output"].as<std::string>();
+        std::ofstream file(path, std::ios_base::binary);
+        if (!(file << input.text) || !file.flush())
+        {
+            std::cerr << "Failed to write the input: " << path << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        std::cout << input.text;
+    }
+
+    if (!input.arguments.empty())
+    {
+        std::cerr << "Pass the sizes to the solution after the driver's options:";
+        for (const std::string &argument : input.arguments)
+        {
+            std::cerr << ' ' << argument;
+        }
+        std::cerr << '\n';
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,15 @@
+#include "generators.h"
+
+#include <algorithm>
+#include <format>
+
+namespace generators
+{
+Generated_input generate_2018_day09(const std::uint64_t seed, const std::size_t size)
+{
+    Random random(seed);
+    const std::int64_t players = random.between(9, 500);
+    const std::size_t last_marble = std::max<std::size_t>(size, 1);
+    return {std::format("{} players; last marble is worth {} points\n", players, last_marble), {}};
+}
+} // namespace generators
@@ -0,0 +1,89 @@
+#include "generators.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr char mirrors[] = {'/', '\\', '|', '-'};
+} // namespace
+
+namespace generators
+{
+Generated_input generate_2023_day12(const std::uint64_t seed, const std::size_t size)
+{
+    Random random(seed);
+    Generated_input input;
+    for (std::size_t row = 0; row < size; ++row)
+    {
+        // Start from a row with no unknowns so there's always at least one arrangement, then hide some of it
+        std::string springs(static_cast<std::size_t>(random.between(4, 20)), '.');
+        for (char &spring : springs)
+        {
+            spring = random.one_in(2) ? '#' : '.';
+        }
+        springs[random.below(springs.size())] = '#';
+
+        std::string groups;
+        std::size_t run = 0;
+        for (std::size_t i = 0; i <= springs.size(); ++i)
+        {
+            if (i < springs.size() && springs[i] == '#')
+            {
+                ++run;
+                continue;
+            }
+            if (run != 0)
+            {
+                groups += groups.empty() ? "" : ",";
+                groups += std::to_string(run);
+                run = 0;
+            }
+        }
+
+        for (char &spring : springs)
+        {
+            if (random.one_in(2))
+            {
+                spring = '?';
+            }
+        }
+        input.text += springs + ' ' + groups + '\n';
+    }
+    return input;
+}
+
+Generated_input generate_2023_day16(const std::uint64_t seed, const std::size_t size)
+{
+    Random random(seed);
+    const std::size_t width = std::max<std::size_t>(size, 1);
+    Generated_input input;
+    input.text.reserve((width + 1) * width);
+    for (std::size_t y = 0; y < width; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            // About as crowded as the real contraptions
+            input.text += random.one_in(10) ? mirrors[random.below(std::size(mirrors))] : '.';
+        }
+        input.text += '\n';
+    }
+    return input;
+}
+
+Generated_input generate_2023_day17(const std::uint64_t seed, const std::size_t size)
+{
+    Random random(seed);
+    const std::size_t width = std::max<std::size_t>(size, 1);
+    Generated_input input;
+    input.text.reserve((width + 1) * width);
+    for (std::size_t y = 0; y < width; ++y)
+    {
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            input.text += static_cast<char>('0' + random.between(1, 9));
+        }
+        input.text += '\n';
+    }
+    return input;
+}
+} // namespace generators
@@ -0,0 +1,90 @@
+#include "generators.h"
+
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <numeric>
+#include <utility>
+
+namespace generators
+{
+Generated_input generate_2024_day14(const std::uint64_t seed, const std::size_t size)
+{
+    Random random(seed);
+    // Odd sizes so the middle row and column split the room into quadrants, like the puzzle's 101 by 103
+    const auto width = static_cast<std::int64_t>(std::max<std::size_t>(size, 11) | 1);
+    const std::int64_t height = width + 2;
+    const std::int64_t cells = width * height;
+    // Enough robots that a second with every one of them on its own cell is unlikely to happen by chance, one in twenty
+    // cells like the puzzle spreads out every few seconds in the smaller rooms. The chance of that is about
+    // e^(-robots^2 / 2 cells), the bit width stands in for the log of the number of seconds checked.
+    const std::int64_t spread_squared = 2 * cells * (std::bit_width(static_cast<std::uint64_t>(cells)) + 8);
+    std::int64_t spread = 1;
+    while (spread * spread < spread_squared)
+    {
+        ++spread;
+    }
+    const std::int64_t robots = std::min(std::max(cells / 20, spread), cells);
+
+    // Part two looks for the first second with every robot on its own cell, so place the robots where they are at that
+    // second and work back to where they start. The picture is always halfway through the period so part two's run
+    // time depends on the size and not the seed.
+    const std::int64_t picture_time = cells / 2;
+    std::vector<std::int64_t> positions(static_cast<std::size_t>(cells));
+    std::iota(positions.begin(), positions.end(), 0);
+
+    struct Robot
+    {
+        std::int64_t x;
+        std::int64_t y;
+        std::int64_t velocity_x;
+        std::int64_t velocity_y;
+    };
+    std::vector<Robot> swarm(static_cast<std::size_t>(robots));
+    // The second each cell was last occupied in, so the check doesn't have to clear the room every second
+    std::vector<std::int64_t> occupied(static_cast<std::size_t>(cells));
+
+    // The robots only ever move apart at the picture, try again if they happen to before it
+    const auto spreads_out_early = [&] {
+        std::ranges::fill(occupied, 0);
+        for (std::int64_t time = 1; time < picture_time; ++time)
+        {
+            const bool collided = std::ranges::any_of(swarm, [&](const Robot &robot) {
+                const std::int64_t x = ((robot.x + robot.velocity_x * time) % width + width) % width;
+                const std::int64_t y = ((robot.y + robot.velocity_y * time) % height + height) % height;
+                std::int64_t &cell = occupied[static_cast<std::size_t>(y * width + x)];
+                return std::exchange(cell, time) == time;
+            });
+            if (!collided)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    do
+    {
+        for (std::int64_t i = 0; i < robots; ++i)
+        {
+            const auto chosen = static_cast<std::size_t>(random.between(i, cells - 1));
+            std::swap(positions[static_cast<std::size_t>(i)], positions[chosen]);
+            const std::int64_t x = positions[static_cast<std::size_t>(i)] % width;
+            const std::int64_t y = positions[static_cast<std::size_t>(i)] / width;
+            Robot &robot = swarm[static_cast<std::size_t>(i)];
+            robot.velocity_x = random.between(1 - width, width - 1);
+            robot.velocity_y = random.between(1 - height, height - 1);
+            robot.x = ((x - robot.velocity_x * picture_time) % width + width) % width;
+            robot.y = ((y - robot.velocity_y * picture_time) % height + height) % height;
+        }
+    } while (spreads_out_early());
+
+    Generated_input input;
+    for (const Robot &robot : swarm)
+    {
+        input.text += std::format("p={},{} v={},{}\n", robot.x, robot.y, robot.velocity_x, robot.velocity_y);
+    }
+    input.arguments = {std::to_string(width), std::to_string(height), "100"};
+    return input;
+}
+} // namespace generators
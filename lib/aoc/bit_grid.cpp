@@ -0,0 +1,148 @@
+#include <aoc/bit_grid.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+
+namespace aoc
+{
+	namespace
+	{
+		template <typename F>
+		void combine(std::vector<U64>& lhs, const std::span<const U64> rhs, F f)
+		{
+			std::ranges::transform(lhs, rhs, lhs.begin(), f);
+		}
+	}
+
+	Bit_grid::Bit_grid(const S64 width, const S64 height)
+		: m_width(width)
+		, m_height(height)
+		, m_words_per_row((width + 63) / 64)
+		, m_words(static_cast<std::size_t>(m_words_per_row * height), 0)
+	{
+	}
+
+	S64 Bit_grid::count() const
+	{
+		S64 total = 0;
+		for (const U64 word : m_words)
+		{
+			total += std::popcount(word);
+		}
+		return total;
+	}
+
+	bool Bit_grid::any() const
+	{
+		return std::ranges::any_of(m_words, [](const U64 word) { return word != 0; });
+	}
+
+	bool Bit_grid::intersects(const Bit_grid& rhs) const
+	{
+		for (std::size_t i = 0; i < m_words.size(); ++i)
+		{
+			if ((m_words[i] & rhs.m_words[i]) != 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	Bit_grid& Bit_grid::operator&=(const Bit_grid& rhs)
+	{
+		combine(m_words, rhs.m_words, std::bit_and<>());
+		return *this;
+	}
+
+	Bit_grid& Bit_grid::operator|=(const Bit_grid& rhs)
+	{
+		combine(m_words, rhs.m_words, std::bit_or<>());
+		return *this;
+	}
+
+	Bit_grid& Bit_grid::operator^=(const Bit_grid& rhs)
+	{
+		combine(m_words, rhs.m_words, std::bit_xor<>());
+		return *this;
+	}
+
+	Bit_grid& Bit_grid::and_not(const Bit_grid& rhs)
+	{
+		combine(m_words, rhs.m_words, [](const U64 lhs, const U64 rhs) { return lhs & ~rhs; });
+		return *this;
+	}
+
+	Bit_grid spread_4(const Bit_grid& grid)
+	{
+		Bit_grid result(grid.width(), grid.height());
+		spread_4(grid, result);
+		return result;
+	}
+
+	void spread_4(const Bit_grid& grid, Bit_grid& result)
+	{
+		const auto words = static_cast<std::size_t>(grid.words_per_row());
+		const U64 last_mask = grid.last_word_mask();
+		for (S64 y = 0; y < grid.height(); ++y)
+		{
+			const std::span<const U64> row = grid.row(y);
+			const std::span<U64> out = result.row(y);
+			for (std::size_t i = 0; i < words; ++i)
+			{
+				out[i] = shifted_east(row, i) | shifted_west(row, i);
+			}
+			if (y > 0)
+			{
+				const std::span<const U64> north = grid.row(y - 1);
+				for (std::size_t i = 0; i < words; ++i)
+				{
+					out[i] |= north[i];
+				}
+			}
+			if (y + 1 < grid.height())
+			{
+				const std::span<const U64> south = grid.row(y + 1);
+				for (std::size_t i = 0; i < words; ++i)
+				{
+					out[i] |= south[i];
+				}
+			}
+			if (words > 0)
+			{
+				out[words - 1] &= last_mask;
+			}
+		}
+	}
+
+	Bit_grid step_life_like(const Bit_grid& alive, const U16 birth, const U16 survival)
+	{
+		Bit_grid result(alive.width(), alive.height());
+		const auto words = static_cast<std::size_t>(alive.words_per_row());
+		const U64 last_mask = alive.last_word_mask();
+		for (S64 y = 0; y < alive.height(); ++y)
+		{
+			const std::span<const U64> row = alive.row(y);
+			const std::span<U64> out = result.row(y);
+			for (std::size_t i = 0; i < words; ++i)
+			{
+				const Neighbour_count count = count_neighbours(alive, y, i);
+				U64 born = 0;
+				U64 survived = 0;
+				for (int n = 0; n <= 8; ++n)
+				{
+					const U64 exactly = count.exactly(n);
+					born |= (birth >> n) & 1 ? exactly : 0;
+					survived |= (survival >> n) & 1 ? exactly : 0;
+				}
+				out[i] = (born & ~row[i]) | (survived & row[i]);
+			}
+			if (words > 0)
+			{
+				out[words - 1] &= last_mask;
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,291 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_BIT_GRID_H
+#define AOC_BIT_GRID_H
+
+#include "aoc/core.h"
+#include "aoc/grid.h"
+
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace aoc
+{
+	/**
+	 * @brief A rectangle of on and off cells packed 64 to a word, row by row.
+	 *
+	 * Meant for cellular automata, where a state of the cells is held as one bit grid per state. The kernels work on a
+	 * whole word at a time: a step updates 64 cells with a handful of bitwise operations and no branches, and the loops
+	 * over the words are simple enough for the compiler to vectorize.
+	 *
+	 * Each row starts on a new word and the bits past the end of a row are always off, cells outside the grid count as
+	 * off.
+	 */
+	class Bit_grid
+	{
+	private:
+		S64 m_width = 0;
+		S64 m_height = 0;
+		S64 m_words_per_row = 0;
+		std::vector<U64> m_words;
+
+	public:
+		Bit_grid() = default;
+
+		/**
+		 * @param width The number of columns.
+		 * @param height The number of rows.
+		 */
+		Bit_grid(S64 width, S64 height);
+
+		/**
+		 * @brief Make a bit grid with the cells of a grid that satisfy a predicate turned on.
+		 *
+		 * @tparam T The cell type of the grid.
+		 * @tparam P UnaryPredicate taking a cell of the grid.
+		 * @param grid The grid, any border is left out.
+		 * @param p The predicate.
+		 * @returns The bit grid.
+		 */
+		template <typename T, typename P>
+		[[nodiscard]]
+		static Bit_grid from_grid(const Grid<T>& grid, P p)
+		{
+			Bit_grid bits(grid.width(), grid.height());
+			for (S64 y = 0; y < grid.height(); ++y)
+			{
+				const std::span<const T> row = grid.row(y);
+				const std::span<U64> words = bits.row(y);
+				for (S64 x = 0; x < grid.width(); ++x)
+				{
+					words[x / 64] |= U64{ p(row[x]) ? 1u : 0u } << (x % 64);
+				}
+			}
+			return bits;
+		}
+
+		[[nodiscard]]
+		S64 width() const
+		{
+			return m_width;
+		}
+
+		[[nodiscard]]
+		S64 height() const
+		{
+			return m_height;
+		}
+
+		[[nodiscard]]
+		S64 words_per_row() const
+		{
+			return m_words_per_row;
+		}
+
+		/**
+		 * @returns The mask of the bits in the last word of a row that are inside the grid.
+		 */
+		[[nodiscard]]
+		U64 last_word_mask() const
+		{
+			return m_width % 64 == 0 ? ~U64{ 0 } : (U64{ 1 } << (m_width % 64)) - 1;
+		}
+
+		[[nodiscard]]
+		bool get(const S64 x, const S64 y) const
+		{
+			return (m_words[y * m_words_per_row + x / 64] >> (x % 64)) & 1;
+		}
+
+		void set(const S64 x, const S64 y)
+		{
+			m_words[y * m_words_per_row + x / 64] |= U64{ 1 } << (x % 64);
+		}
+
+		void reset(const S64 x, const S64 y)
+		{
+			m_words[y * m_words_per_row + x / 64] &= ~(U64{ 1 } << (x % 64));
+		}
+
+		/**
+		 * @returns The words of a row, bit x % 64 of word x / 64 is the cell in column x.
+		 */
+		[[nodiscard]]
+		std::span<U64> row(const S64 y)
+		{
+			return { m_words.data() + y * m_words_per_row, static_cast<std::size_t>(m_words_per_row) };
+		}
+
+		[[nodiscard]]
+		std::span<const U64> row(const S64 y) const
+		{
+			return { m_words.data() + y * m_words_per_row, static_cast<std::size_t>(m_words_per_row) };
+		}
+
+		/**
+		 * @returns The number of cells that are on.
+		 */
+		[[nodiscard]]
+		S64 count() const;
+
+		/**
+		 * @returns Whether any cell is on.
+		 */
+		[[nodiscard]]
+		bool any() const;
+
+		/**
+		 * @returns Whether a cell is on in both this grid and another grid of the same size.
+		 */
+		[[nodiscard]]
+		bool intersects(const Bit_grid& rhs) const;
+
+		Bit_grid& operator&=(const Bit_grid& rhs);
+		Bit_grid& operator|=(const Bit_grid& rhs);
+		Bit_grid& operator^=(const Bit_grid& rhs);
+
+		/**
+		 * @brief Turn off every cell that is on in another grid of the same size.
+		 *
+		 * @param rhs The cells to turn off.
+		 * @returns This grid.
+		 */
+		Bit_grid& and_not(const Bit_grid& rhs);
+
+		bool operator==(const Bit_grid&) const = default;
+	};
+
+	/**
+	 * @brief Move the cells of a row one column east, so bit x of the result is bit x - 1 of the row.
+	 *
+	 * The bit shifted out of the last column isn't masked off.
+	 */
+	[[nodiscard]]
+	inline U64 shifted_east(const std::span<const U64> row, const std::size_t i)
+	{
+		return (row[i] << 1) | (i > 0 ? row[i - 1] >> 63 : 0);
+	}
+
+	/**
+	 * @brief Move the cells of a row one column west, so bit x of the result is bit x + 1 of the row.
+	 */
+	[[nodiscard]]
+	inline U64 shifted_west(const std::span<const U64> row, const std::size_t i)
+	{
+		return (row[i] >> 1) | (i + 1 < row.size() ? row[i + 1] << 63 : 0);
+	}
+
+	/**
+	 * @brief How many of the eight neighbours of each cell in a word are on, bit sliced.
+	 *
+	 * Bit j of the count of a cell is held in bits[j] at the cell's bit, so the counts of all 64 cells are added
+	 * together with a few bitwise operations per neighbour.
+	 */
+	struct Neighbour_count
+	{
+		U64 bits[4] = {};
+
+		/**
+		 * @brief Add one to the count of the cells that are on in a word.
+		 */
+		void add(U64 x)
+		{
+			for (U64& bit : bits)
+			{
+				const U64 carry = bit & x;
+				bit ^= x;
+				x = carry;
+			}
+		}
+
+		/**
+		 * @returns The mask of the cells with exactly @p n neighbours on.
+		 */
+		[[nodiscard]]
+		U64 exactly(const int n) const
+		{
+			U64 mask = ~U64{ 0 };
+			for (int j = 0; j < 4; ++j)
+			{
+				mask &= (n >> j) & 1 ? bits[j] : ~bits[j];
+			}
+			return mask;
+		}
+
+		/**
+		 * @returns The mask of the cells with at least @p n neighbours on.
+		 */
+		[[nodiscard]]
+		U64 at_least(const int n) const
+		{
+			U64 mask = 0;
+			for (int m = n; m <= 8; ++m)
+			{
+				mask |= exactly(m);
+			}
+			return mask;
+		}
+	};
+
+	/**
+	 * @brief Count the neighbours of the cells in one word of a grid.
+	 *
+	 * @param grid The grid.
+	 * @param y The row of the word.
+	 * @param i The index of the word in the row.
+	 * @returns The counts of the 64 cells in the word, the bits past the end of the row are meaningless.
+	 */
+	[[nodiscard]]
+	inline Neighbour_count count_neighbours(const Bit_grid& grid, const S64 y, const std::size_t i)
+	{
+		Neighbour_count count;
+		const std::span<const U64> row = grid.row(y);
+		count.add(shifted_east(row, i));
+		count.add(shifted_west(row, i));
+		for (const S64 ny : { y - 1, y + 1 })
+		{
+			if (ny < 0 || ny >= grid.height())
+			{
+				continue;
+			}
+			const std::span<const U64> neighbours = grid.row(ny);
+			count.add(neighbours[i]);
+			count.add(shifted_east(neighbours, i));
+			count.add(shifted_west(neighbours, i));
+		}
+		return count;
+	}
+
+	/**
+	 * @brief Find the cells next to a cell that is on, not counting the diagonals.
+	 *
+	 * @param grid The cells to spread from.
+	 * @returns The cells with a neighbour to the north, south, east or west that is on in @p grid.
+	 */
+	[[nodiscard]]
+	Bit_grid spread_4(const Bit_grid& grid);
+
+	/**
+	 * @brief Find the cells next to a cell that is on without allocating, the same as spread_4.
+	 *
+	 * @param grid The cells to spread from.
+	 * @param result A grid of the same size that is overwritten with the result, not @p grid itself.
+	 */
+	void spread_4(const Bit_grid& grid, Bit_grid& result);
+
+	/**
+	 * @brief Step a life-like cellular automaton once.
+	 *
+	 * @param alive The cells that are alive.
+	 * @param birth Bit n is set if a dead cell with n live neighbours comes alive.
+	 * @param survival Bit n is set if a live cell with n live neighbours stays alive.
+	 * @returns The cells alive after the step.
+	 */
+	[[nodiscard]]
+	Bit_grid step_life_like(const Bit_grid& alive, U16 birth, U16 survival);
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include <aoc/grid.h>
+
+#include <string>
+
+namespace aoc
+{
+	namespace
+	{
+		std::string_view trim_carriage_return(std::string_view line)
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.remove_suffix(1);
+			}
+			return line;
+		}
+
+		Grid<char> make_grid(const std::span<const std::string_view> lines, const std::optional<char> border)
+		{
+			const auto width = lines.empty() ? S64{ 0 } : static_cast<S64>(lines.front().size());
+			const auto height = static_cast<S64>(lines.size());
+			Grid<char> grid =
+				border ? Grid<char>::with_border(width, height, '\0', *border) : Grid<char>(width, height);
+			for (S64 y = 0; y < height; ++y)
+			{
+				const std::string_view line = lines[static_cast<std::size_t>(y)];
+				std::ranges::copy(line.substr(0, static_cast<std::size_t>(width)), grid.row(y).begin());
+			}
+			return grid;
+		}
+	}
+
+	Grid<char> parse_grid(const std::string_view text, const std::optional<char> border)
+	{
+		std::vector<std::string_view> lines;
+		for (std::size_t offset = 0; offset < text.size();)
+		{
+			const std::size_t newline = text.find('\n', offset);
+			const std::size_t last = newline == std::string_view::npos ? text.size() : newline;
+			const std::string_view line = trim_carriage_return(text.substr(offset, last - offset));
+			if (line.empty())
+			{
+				break;
+			}
+			lines.push_back(line);
+			offset = last + 1;
+		}
+		return make_grid(lines, border);
+	}
+
+	Grid<char> read_grid(std::istream& stream, const std::optional<char> border)
+	{
+		std::vector<std::string> rows;
+		for (std::string line; std::getline(stream, line);)
+		{
+			if (trim_carriage_return(line).empty())
+			{
+				break;
+			}
+			rows.push_back(std::move(line));
+		}
+		std::vector<std::string_view> lines;
+		lines.reserve(rows.size());
+		for (const std::string& row : rows)
+		{
+			lines.push_back(trim_carriage_return(row));
+		}
+		return make_grid(lines, border);
+	}
+}
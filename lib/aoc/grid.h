@@ -0,0 +1,450 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_GRID_H
+#define AOC_GRID_H
+
+#include "aoc/core.h"
+#include "aoc/vector.h"
+
+#include <algorithm>
+#include <array>
+#include <istream>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aoc
+{
+	template <typename T>
+	class Grid;
+
+	/**
+	 * @brief A grid seen from another direction, e.g. transposed or rotated, without copying it.
+	 *
+	 * Only valid for as long as the grid it looks at and only while that grid isn't resized.
+	 *
+	 * @tparam T The cell type, const for a view that can't change the cells.
+	 */
+	template <typename T>
+	class Grid_view
+	{
+	private:
+		T* m_origin = nullptr;
+		S64 m_width = 0;
+		S64 m_height = 0;
+		S64 m_x_step = 0;
+		S64 m_y_step = 0;
+
+	public:
+		/**
+		 * @param origin The cell seen at (0, 0).
+		 * @param width The number of columns of the view.
+		 * @param height The number of rows of the view.
+		 * @param x_step How far apart two cells next to each other in a row of the view are in memory.
+		 * @param y_step How far apart two cells next to each other in a column of the view are in memory.
+		 */
+		Grid_view(T* const origin, const S64 width, const S64 height, const S64 x_step, const S64 y_step)
+			: m_origin(origin)
+			, m_width(width)
+			, m_height(height)
+			, m_x_step(x_step)
+			, m_y_step(y_step)
+		{
+		}
+
+		[[nodiscard]]
+		S64 width() const
+		{
+			return m_width;
+		}
+
+		[[nodiscard]]
+		S64 height() const
+		{
+			return m_height;
+		}
+
+		[[nodiscard]]
+		T& operator()(const S64 x, const S64 y) const
+		{
+			return m_origin[x * m_x_step + y * m_y_step];
+		}
+
+		[[nodiscard]]
+		T& operator[](const Vector2& p) const
+		{
+			return (*this)(p.x, p.y);
+		}
+
+		/**
+		 * @returns The view with its rows and columns swapped, so (x, y) of the result is (y, x) of this view.
+		 */
+		[[nodiscard]]
+		Grid_view transposed() const
+		{
+			return Grid_view(m_origin, m_height, m_width, m_y_step, m_x_step);
+		}
+
+		/**
+		 * @returns A copy of the cells as they are seen through the view, without a border.
+		 */
+		[[nodiscard]]
+		Grid<std::remove_const_t<T>> to_grid() const
+		{
+			Grid<std::remove_const_t<T>> grid(m_width, m_height);
+			for (S64 y = 0; y < m_height; ++y)
+			{
+				for (S64 x = 0; x < m_width; ++x)
+				{
+					grid(x, y) = (*this)(x, y);
+				}
+			}
+			return grid;
+		}
+	};
+
+	/**
+	 * @brief A rectangle of cells stored row by row in one block of memory.
+	 *
+	 * Cells can be reached by their position or by their index in the block, and moving to a neighbour is adding one
+	 * of the offsets from neighbour_offsets_4 or neighbour_offsets_8 to the index. A grid made with with_border has an
+	 * extra ring of cells all around it holding a sentinel value. Stepping from any cell inside the grid to one of its
+	 * neighbours then never leaves the block, so walks can stop on the sentinel instead of checking the bounds.
+	 *
+	 * Positions and indices are signed so the border can be reached with -1.
+	 *
+	 * @tparam T The cell type, bool isn't allowed since std::vector<bool> isn't stored a cell at a time.
+	 */
+	template <typename T>
+	class Grid
+	{
+		static_assert(!std::is_same_v<T, bool>, "Use a byte sized type instead of bool");
+
+	private:
+		S64 m_width = 0;
+		S64 m_height = 0;
+		// 1 when there is a sentinel border, 0 otherwise
+		S64 m_border = 0;
+		S64 m_stride = 0;
+		std::vector<T> m_cells;
+
+		Grid(const S64 width, const S64 height, const S64 border, const T& value)
+			: m_width(width)
+			, m_height(height)
+			, m_border(border)
+			, m_stride(width + 2 * border)
+			, m_cells(static_cast<std::size_t>((width + 2 * border) * (height + 2 * border)), value)
+		{
+		}
+
+		template <typename U>
+		Grid_view<U> make_view(U* const cells, const Vector2& origin, const S64 width, const S64 height,
+			const S64 x_step, const S64 y_step) const
+		{
+			return Grid_view<U>(cells + index(origin), width, height, x_step, y_step);
+		}
+
+	public:
+		Grid() = default;
+
+		/**
+		 * @param width The number of columns.
+		 * @param height The number of rows.
+		 * @param value The value of every cell.
+		 */
+		Grid(const S64 width, const S64 height, const T& value = T{})
+			: Grid(width, height, 0, value)
+		{
+		}
+
+		/**
+		 * @brief Make a grid surrounded by a ring of sentinel cells, one cell wide.
+		 *
+		 * @param width The number of columns, not counting the border.
+		 * @param height The number of rows, not counting the border.
+		 * @param value The value of every cell inside the border.
+		 * @param border The value of the border cells.
+		 * @returns The grid.
+		 */
+		[[nodiscard]]
+		static Grid with_border(const S64 width, const S64 height, const T& value, const T& border)
+		{
+			Grid grid(width, height, 1, border);
+			for (S64 y = 0; y < height; ++y)
+			{
+				std::ranges::fill(grid.row(y), value);
+			}
+			return grid;
+		}
+
+		[[nodiscard]]
+		S64 width() const
+		{
+			return m_width;
+		}
+
+		[[nodiscard]]
+		S64 height() const
+		{
+			return m_height;
+		}
+
+		[[nodiscard]]
+		bool has_border() const
+		{
+			return m_border != 0;
+		}
+
+		/**
+		 * @returns The distance between the indices of a cell and the cell below it.
+		 */
+		[[nodiscard]]
+		S64 stride() const
+		{
+			return m_stride;
+		}
+
+		/**
+		 * @returns The number of indices, including the border.
+		 */
+		[[nodiscard]]
+		S64 size() const
+		{
+			return static_cast<S64>(m_cells.size());
+		}
+
+		/**
+		 * @returns The index of a position, positions on the border are allowed when there is one.
+		 */
+		[[nodiscard]]
+		S64 index(const S64 x, const S64 y) const
+		{
+			return (y + m_border) * m_stride + x + m_border;
+		}
+
+		[[nodiscard]]
+		S64 index(const Vector2& p) const
+		{
+			return index(p.x, p.y);
+		}
+
+		/**
+		 * @returns The position of an index, the inverse of index().
+		 */
+		[[nodiscard]]
+		Vector2 position(const S64 i) const
+		{
+			return { .x = i % m_stride - m_border, .y = i / m_stride - m_border };
+		}
+
+		/**
+		 * @returns Whether the position is inside the grid, the border doesn't count.
+		 */
+		[[nodiscard]]
+		bool contains(const Vector2& p) const
+		{
+			return p.x >= 0 && p.x < m_width && p.y >= 0 && p.y < m_height;
+		}
+
+		[[nodiscard]]
+		T& operator[](const S64 i)
+		{
+			return m_cells[static_cast<std::size_t>(i)];
+		}
+
+		[[nodiscard]]
+		const T& operator[](const S64 i) const
+		{
+			return m_cells[static_cast<std::size_t>(i)];
+		}
+
+		[[nodiscard]]
+		T& operator[](const Vector2& p)
+		{
+			return (*this)[index(p)];
+		}
+
+		[[nodiscard]]
+		const T& operator[](const Vector2& p) const
+		{
+			return (*this)[index(p)];
+		}
+
+		[[nodiscard]]
+		T& operator()(const S64 x, const S64 y)
+		{
+			return (*this)[index(x, y)];
+		}
+
+		[[nodiscard]]
+		const T& operator()(const S64 x, const S64 y) const
+		{
+			return (*this)[index(x, y)];
+		}
+
+		/**
+		 * @returns The cells of a row, without the border.
+		 */
+		[[nodiscard]]
+		std::span<T> row(const S64 y)
+		{
+			return { m_cells.data() + index(0, y), static_cast<std::size_t>(m_width) };
+		}
+
+		[[nodiscard]]
+		std::span<const T> row(const S64 y) const
+		{
+			return { m_cells.data() + index(0, y), static_cast<std::size_t>(m_width) };
+		}
+
+		/**
+		 * @returns Every cell including the border, in the order of their indices.
+		 */
+		[[nodiscard]]
+		std::span<T> cells()
+		{
+			return m_cells;
+		}
+
+		[[nodiscard]]
+		std::span<const T> cells() const
+		{
+			return m_cells;
+		}
+
+		/**
+		 * @brief The offsets of the neighbours sharing an edge with a cell.
+		 *
+		 * @returns The offsets of east, south, west and north, in the order of the directions in Vector2.
+		 */
+		[[nodiscard]]
+		std::array<S64, 4> neighbour_offsets_4() const
+		{
+			return { 1, m_stride, -1, -m_stride };
+		}
+
+		/**
+		 * @brief The offsets of the neighbours sharing an edge or a corner with a cell.
+		 *
+		 * @returns The offsets starting from east and going clockwise, in the order of the directions in Vector2.
+		 */
+		[[nodiscard]]
+		std::array<S64, 8> neighbour_offsets_8() const
+		{
+			return { 1, m_stride + 1, m_stride, m_stride - 1, -1, -m_stride - 1, -m_stride, -m_stride + 1 };
+		}
+
+		/**
+		 * @returns The index of the first cell inside the border with the value, row by row.
+		 */
+		[[nodiscard]]
+		std::optional<S64> find(const T& value) const
+		{
+			for (S64 y = 0; y < m_height; ++y)
+			{
+				const std::span<const T> cells = row(y);
+				if (const auto iter = std::ranges::find(cells, value); iter != cells.end())
+				{
+					return index(0, y) + (iter - cells.begin());
+				}
+			}
+			return std::nullopt;
+		}
+
+		/**
+		 * @returns A view of the cells inside the border as they are.
+		 */
+		[[nodiscard]]
+		Grid_view<T> view()
+		{
+			return make_view(m_cells.data(), { 0, 0 }, m_width, m_height, 1, m_stride);
+		}
+
+		[[nodiscard]]
+		Grid_view<const T> view() const
+		{
+			return make_view(m_cells.data(), { 0, 0 }, m_width, m_height, 1, m_stride);
+		}
+
+		/**
+		 * @returns A view with the rows and columns swapped, so (x, y) of the view is (y, x) of the grid.
+		 */
+		[[nodiscard]]
+		Grid_view<T> transposed()
+		{
+			return make_view(m_cells.data(), { 0, 0 }, m_height, m_width, m_stride, 1);
+		}
+
+		[[nodiscard]]
+		Grid_view<const T> transposed() const
+		{
+			return make_view(m_cells.data(), { 0, 0 }, m_height, m_width, m_stride, 1);
+		}
+
+		/**
+		 * @returns A view of the grid turned a quarter clockwise, the first row of the view is the first column of
+		 * the grid from the bottom up.
+		 */
+		[[nodiscard]]
+		Grid_view<T> rotated_clockwise()
+		{
+			return make_view(m_cells.data(), { 0, m_height - 1 }, m_height, m_width, -m_stride, 1);
+		}
+
+		[[nodiscard]]
+		Grid_view<const T> rotated_clockwise() const
+		{
+			return make_view(m_cells.data(), { 0, m_height - 1 }, m_height, m_width, -m_stride, 1);
+		}
+
+		/**
+		 * @returns A view of the grid turned a quarter counter clockwise, the first row of the view is the last
+		 * column of the grid from the top down.
+		 */
+		[[nodiscard]]
+		Grid_view<T> rotated_counter_clockwise()
+		{
+			return make_view(m_cells.data(), { m_width - 1, 0 }, m_height, m_width, m_stride, -1);
+		}
+
+		[[nodiscard]]
+		Grid_view<const T> rotated_counter_clockwise() const
+		{
+			return make_view(m_cells.data(), { m_width - 1, 0 }, m_height, m_width, m_stride, -1);
+		}
+
+		bool operator==(const Grid&) const = default;
+	};
+
+	/**
+	 * @brief Make a grid of characters from lines of text.
+	 *
+	 * The grid ends at the first empty line or at the end of the text, whichever comes first, and a carriage return
+	 * before a newline is ignored. Every line should be as long as the first, longer lines are cut short and shorter
+	 * ones are padded with '\0'.
+	 *
+	 * @param text The text starting with the first row of the grid.
+	 * @param border The value of the sentinel border, the grid has no border if this is empty.
+	 * @returns The grid.
+	 */
+	[[nodiscard]]
+	Grid<char> parse_grid(std::string_view text, std::optional<char> border = std::nullopt);
+
+	/**
+	 * @brief Read a grid of characters from a stream, the same as parse_grid.
+	 *
+	 * Reads up to and including the first empty line, so whatever follows the grid can be read afterwards.
+	 *
+	 * @param stream The stream, usually the standard input.
+	 * @param border The value of the sentinel border, the grid has no border if this is empty.
+	 * @returns The grid.
+	 */
+	[[nodiscard]]
+	Grid<char> read_grid(std::istream& stream, std::optional<char> border = std::nullopt);
+}
+
+#endif
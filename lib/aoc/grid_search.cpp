@@ -0,0 +1,33 @@
+#include <aoc/grid_search.h>
+
+#include <utility>
+
+namespace aoc
+{
+	Bit_grid_search::Bit_grid_search(const S64 width, const S64 height)
+		: m_reached(width, height)
+		, m_frontier(width, height)
+		, m_next(width, height)
+	{
+	}
+
+	S64 Bit_grid_search::distance(const Bit_grid& open, const Bit_grid& sources, const Bit_grid& targets)
+	{
+		// Copying into grids of the same size reuses their memory
+		m_reached = sources;
+		m_frontier = sources;
+		for (S64 steps = 0; m_frontier.any(); ++steps)
+		{
+			if (m_frontier.intersects(targets))
+			{
+				return steps;
+			}
+			spread_4(m_frontier, m_next);
+			m_next &= open;
+			m_next.and_not(m_reached);
+			m_reached |= m_next;
+			std::swap(m_frontier, m_next);
+		}
+		return unreachable;
+	}
+}
@@ -0,0 +1,372 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_GRID_SEARCH_H
+#define AOC_GRID_SEARCH_H
+
+#include "aoc/bit_grid.h"
+#include "aoc/core.h"
+
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <vector>
+
+#include <cstddef>
+
+namespace aoc
+{
+	/**
+	 * @brief A first in first out queue in a fixed block of memory that wraps around.
+	 *
+	 * The capacity is rounded up to a power of two so wrapping is a mask. The queue never grows, it must not be given
+	 * more items than its capacity at once.
+	 */
+	template <typename T>
+	class Ring_queue
+	{
+	private:
+		std::vector<T> m_items;
+		std::size_t m_head = 0;
+		std::size_t m_size = 0;
+
+	public:
+		Ring_queue() = default;
+
+		/**
+		 * @param capacity The most items the queue holds at once.
+		 */
+		explicit Ring_queue(const std::size_t capacity)
+			: m_items(std::bit_ceil(std::max<std::size_t>(capacity, 1)))
+		{
+		}
+
+		void push(const T& item)
+		{
+			m_items[(m_head + m_size) & (m_items.size() - 1)] = item;
+			++m_size;
+		}
+
+		T pop()
+		{
+			const T item = m_items[m_head];
+			m_head = (m_head + 1) & (m_items.size() - 1);
+			--m_size;
+			return item;
+		}
+
+		[[nodiscard]]
+		std::size_t size() const
+		{
+			return m_size;
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		void clear()
+		{
+			m_head = 0;
+			m_size = 0;
+		}
+	};
+
+	/**
+	 * @brief A set of indices that is emptied in constant time.
+	 *
+	 * Each index holds the number of the generation it was last added in, and clearing starts a new generation. The
+	 * memory is only wiped when the generation number wraps around.
+	 */
+	class Epoch_marks
+	{
+	private:
+		std::vector<U32> m_stamps;
+		U32 m_epoch = 1;
+
+	public:
+		Epoch_marks() = default;
+
+		/**
+		 * @param size One more than the largest index.
+		 */
+		explicit Epoch_marks(const std::size_t size)
+			: m_stamps(size, 0)
+		{
+		}
+
+		[[nodiscard]]
+		bool contains(const S64 index) const
+		{
+			return m_stamps[static_cast<std::size_t>(index)] == m_epoch;
+		}
+
+		/**
+		 * @returns Whether the index was added, false if it was already there.
+		 */
+		bool insert(const S64 index)
+		{
+			U32& stamp = m_stamps[static_cast<std::size_t>(index)];
+			const bool inserted = stamp != m_epoch;
+			stamp = m_epoch;
+			return inserted;
+		}
+
+		void clear()
+		{
+			if (++m_epoch == 0)
+			{
+				std::ranges::fill(m_stamps, 0);
+				m_epoch = 1;
+			}
+		}
+	};
+
+	/**
+	 * @brief Breadth first search over the indices of a Grid, for searching the same grid many times.
+	 *
+	 * The buffers are made once by the constructor and each search only starts a new generation of the marks, so a
+	 * search allocates nothing and doesn't touch the cells it doesn't reach. Which steps are allowed is given to each
+	 * search, e.g. to try the same maze with more and more walls.
+	 *
+	 * Neighbours are found by adding the offsets to the index, so the grid needs a sentinel border and the steps onto
+	 * the border must not be allowed.
+	 */
+	class Grid_search
+	{
+	public:
+		static constexpr S64 unreachable = -1;
+
+	private:
+		struct Side
+		{
+			Epoch_marks reached;
+			std::vector<U32> distances;
+			Ring_queue<U32> queue;
+
+			Side() = default;
+
+			explicit Side(const std::size_t size)
+				: reached(size)
+				, distances(size)
+				, queue(size)
+			{
+			}
+
+			void start(const std::span<const S64> sources)
+			{
+				reached.clear();
+				queue.clear();
+				for (const S64 source : sources)
+				{
+					if (reached.insert(source))
+					{
+						distances[static_cast<std::size_t>(source)] = 0;
+						queue.push(static_cast<U32>(source));
+					}
+				}
+			}
+		};
+
+		std::vector<S64> m_offsets;
+		Side m_forward;
+		// Only made by the first bidirectional search
+		Side m_backward;
+
+		/*
+		 * Takes every cell at the distance of the front of the queue off the queue and reaches its neighbours, the
+		 * backward side steps against the direction of the allowed steps. Returns the shortest distance through a cell
+		 * reached by both sides.
+		 */
+		template <bool Backward, typename P>
+		S64 expand_level(Side& side, const Side& other, P can_move)
+		{
+			S64 best = unreachable;
+			for (std::size_t count = side.queue.size(); count > 0; --count)
+			{
+				const U32 current = side.queue.pop();
+				const U32 distance = side.distances[current] + 1;
+				for (const S64 offset : m_offsets)
+				{
+					const S64 next = current + offset;
+					if (side.reached.contains(next) || !(Backward ? can_move(next, current) : can_move(current, next)))
+					{
+						continue;
+					}
+					if (other.reached.contains(next))
+					{
+						const S64 total = distance + other.distances[static_cast<std::size_t>(next)];
+						best = best == unreachable ? total : std::min(best, total);
+						continue;
+					}
+					side.reached.insert(next);
+					side.distances[static_cast<std::size_t>(next)] = distance;
+					side.queue.push(static_cast<U32>(next));
+				}
+			}
+			return best;
+		}
+
+	public:
+		/**
+		 * @param size The number of indices of the grid, Grid::size.
+		 * @param offsets The steps from a cell to its neighbours, e.g. Grid::neighbour_offsets_4.
+		 */
+		Grid_search(const S64 size, const std::span<const S64> offsets)
+			: m_offsets(offsets.begin(), offsets.end())
+			, m_forward(static_cast<std::size_t>(size))
+		{
+		}
+
+		/**
+		 * @brief Find the distances from the nearest of the sources, or until the search is told to stop.
+		 *
+		 * @tparam P BinaryPredicate taking the index of a cell and of its neighbour, true if the step is allowed.
+		 * @tparam V UnaryPredicate taking an index, true to stop the search.
+		 * @param sources The cells at distance 0.
+		 * @param can_move Whether a step is allowed.
+		 * @param visit Called with each cell as it is reached, sources included.
+		 * @returns The distance of the cell the search was stopped at, unreachable if it wasn't stopped.
+		 */
+		template <typename P, typename V>
+		S64 run(const std::span<const S64> sources, P can_move, V visit)
+		{
+			m_forward.start(sources);
+			for (const S64 source : sources)
+			{
+				if (visit(source))
+				{
+					return 0;
+				}
+			}
+			while (!m_forward.queue.empty())
+			{
+				const U32 current = m_forward.queue.pop();
+				const U32 distance = m_forward.distances[current] + 1;
+				for (const S64 offset : m_offsets)
+				{
+					const S64 next = current + offset;
+					if (!m_forward.reached.contains(next) && can_move(S64{ current }, next))
+					{
+						m_forward.reached.insert(next);
+						m_forward.distances[static_cast<std::size_t>(next)] = distance;
+						m_forward.queue.push(static_cast<U32>(next));
+						if (visit(next))
+						{
+							return distance;
+						}
+					}
+				}
+			}
+			return unreachable;
+		}
+
+		template <typename P>
+		void run(const std::span<const S64> sources, P can_move)
+		{
+			run(sources, can_move, [](S64) { return false; });
+		}
+
+		/**
+		 * @brief Find the distance between two cells by searching from both ends until they meet.
+		 *
+		 * Each round takes a whole level of whichever side has the smaller frontier, so the search reaches far fewer
+		 * cells than searching from the source alone when the grid is open. Leaves the distances of run undefined.
+		 *
+		 * @tparam P BinaryPredicate taking the index of a cell and of its neighbour, true if the step is allowed.
+		 * @param source The cell to start from.
+		 * @param target The cell to get to.
+		 * @param can_move Whether a step is allowed.
+		 * @returns The distance, unreachable if the target can't be reached.
+		 */
+		template <typename P>
+		S64 bidirectional(const S64 source, const S64 target, P can_move)
+		{
+			if (source == target)
+			{
+				return 0;
+			}
+			if (m_backward.distances.empty())
+			{
+				m_backward = Side(m_forward.distances.size());
+			}
+			m_forward.start(std::span{ &source, 1 });
+			m_backward.start(std::span{ &target, 1 });
+			while (!m_forward.queue.empty() && !m_backward.queue.empty())
+			{
+				const S64 best = m_forward.queue.size() <= m_backward.queue.size()
+					? expand_level<false>(m_forward, m_backward, can_move)
+					: expand_level<true>(m_backward, m_forward, can_move);
+				if (best != unreachable)
+				{
+					return best;
+				}
+			}
+			return unreachable;
+		}
+
+		[[nodiscard]]
+		bool reached(const S64 index) const
+		{
+			return m_forward.reached.contains(index);
+		}
+
+		/**
+		 * @returns The distance to a cell found by the last run, unreachable if it wasn't reached.
+		 */
+		[[nodiscard]]
+		S64 distance(const S64 index) const
+		{
+			return reached(index) ? m_forward.distances[static_cast<std::size_t>(index)] : unreachable;
+		}
+	};
+
+	/**
+	 * @brief Breadth first search a whole level at a time on bit grids.
+	 *
+	 * The frontier is a bit grid, and the next level is the frontier spread to its neighbours, kept to the open cells
+	 * and without the cells reached before. Each level is a few bitwise operations per 64 cells, which is faster than
+	 * a queue when the frontier is wide, e.g. in open areas. Only the distance to the targets is found.
+	 */
+	class Bit_grid_search
+	{
+	public:
+		static constexpr S64 unreachable = -1;
+
+	private:
+		Bit_grid m_reached;
+		Bit_grid m_frontier;
+		Bit_grid m_next;
+
+	public:
+		/**
+		 * @param width The number of columns of the grids searched.
+		 * @param height The number of rows of the grids searched.
+		 */
+		Bit_grid_search(S64 width, S64 height);
+
+		/**
+		 * @brief Find the number of steps to the nearest target, not counting the diagonals.
+		 *
+		 * @param open The cells that can be stepped on.
+		 * @param sources The cells at distance 0.
+		 * @param targets The cells to get to.
+		 * @returns The distance, unreachable if no target can be reached.
+		 */
+		S64 distance(const Bit_grid& open, const Bit_grid& sources, const Bit_grid& targets);
+
+		/**
+		 * @returns The cells reached by the last search.
+		 */
+		[[nodiscard]]
+		const Bit_grid& reached() const
+		{
+			return m_reached;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include <aoc/input.h>
+
+#include <algorithm>
+
+namespace aoc
+{
+	std::vector<std::size_t> index_lines(const std::string_view text)
+	{
+		std::vector<std::size_t> offsets;
+		offsets.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+		for (std::size_t offset = 0; offset < text.size();)
+		{
+			offsets.push_back(offset);
+			const std::size_t newline = text.find('\n', offset);
+			if (newline == std::string_view::npos)
+			{
+				break;
+			}
+			offset = newline + 1;
+		}
+		return offsets;
+	}
+
+	Input::Input(const std::string_view text, const std::span<const std::size_t> line_offsets)
+		: m_text(text)
+		, m_line_offsets(line_offsets)
+	{
+	}
+
+	std::string_view Input::line(const std::size_t i) const
+	{
+		const std::size_t first = m_line_offsets[i];
+		std::size_t last = i + 1 < m_line_offsets.size() ? m_line_offsets[i + 1] : m_text.size();
+		if (last > first && m_text[last - 1] == '\n')
+		{
+			--last;
+		}
+		if (last > first && m_text[last - 1] == '\r')
+		{
+			--last;
+		}
+		return m_text.substr(first, last - first);
+	}
+
+	std::vector<std::string_view> Input::lines() const
+	{
+		std::vector<std::string_view> result;
+		result.reserve(line_count());
+		for (std::size_t i = 0; i < line_count(); ++i)
+		{
+			result.push_back(line(i));
+		}
+		return result;
+	}
+}
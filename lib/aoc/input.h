@@ -0,0 +1,79 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_INPUT_H
+#define AOC_INPUT_H
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc
+{
+	/**
+	 * @brief Find where each line in some text starts.
+	 *
+	 * A trailing newline does not start another line, so "a\nb\n" and "a\nb" both have two lines.
+	 *
+	 * @param text The text to index.
+	 * @returns The offset of the first character of every line.
+	 */
+	[[nodiscard]]
+	std::vector<std::size_t> index_lines(std::string_view text);
+
+	/**
+	 * @brief A read only view of the whole puzzle input and where its lines start.
+	 *
+	 * The input does not own any of the memory, the driver keeps it alive until the solution has finished.
+	 */
+	class Input
+	{
+	private:
+		std::string_view m_text;
+		std::span<const std::size_t> m_line_offsets;
+
+	public:
+		/**
+		 * @param text The whole input.
+		 * @param line_offsets The offsets of the lines in @p text, as returned by index_lines.
+		 */
+		Input(std::string_view text, std::span<const std::size_t> line_offsets);
+
+		/**
+		 * @returns The whole input including the newlines.
+		 */
+		[[nodiscard]]
+		std::string_view text() const
+		{
+			return m_text;
+		}
+
+		/**
+		 * @returns The number of lines in the input.
+		 */
+		[[nodiscard]]
+		std::size_t line_count() const
+		{
+			return m_line_offsets.size();
+		}
+
+		/**
+		 * @brief Get a line without its newline, a carriage return before the newline is also removed.
+		 *
+		 * @param i The index of the line, must be less than line_count().
+		 * @returns The line.
+		 */
+		[[nodiscard]]
+		std::string_view line(std::size_t i) const;
+
+		/**
+		 * @returns All of the lines, as returned by line().
+		 */
+		[[nodiscard]]
+		std::vector<std::string_view> lines() const;
+	};
+}
+
+#endif
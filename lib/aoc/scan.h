@@ -0,0 +1,198 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_SCAN_H
+#define AOC_SCAN_H
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+
+namespace aoc
+{
+	/**
+	 * @brief A string literal that can be passed as a template argument.
+	 *
+	 * @tparam N The size of the literal including the null terminator.
+	 */
+	template <std::size_t N>
+	struct Fixed_string
+	{
+		char chars[N] = {};
+
+		constexpr Fixed_string(const char (&str)[N])
+		{
+			std::copy_n(str, N, chars);
+		}
+
+		[[nodiscard]]
+		constexpr std::string_view view() const
+		{
+			return { chars, N - 1 };
+		}
+	};
+
+	namespace detail
+	{
+		[[nodiscard]]
+		constexpr std::size_t count_placeholders(const std::string_view pattern)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < pattern.size(); ++i)
+			{
+				const std::string_view pair = pattern.substr(i, 2);
+				if (pair == "{}")
+				{
+					++count;
+				}
+				i += pair == "{}" || pair == "{{" || pair == "}}" ? 1 : 0;
+			}
+			return count;
+		}
+
+		/*
+		 * The literal text of a pattern with the escaped braces replaced, literal i is the text before placeholder i
+		 * and the last literal is the text after the last placeholder
+		 */
+		template <std::size_t Size, std::size_t Count>
+		struct Scan_pattern
+		{
+			std::array<char, Size> text{};
+			std::array<std::size_t, Count + 1> begins{};
+			std::array<std::size_t, Count + 1> ends{};
+
+			[[nodiscard]]
+			constexpr std::string_view literal(const std::size_t i) const
+			{
+				return { text.data() + begins[i], ends[i] - begins[i] };
+			}
+		};
+
+		template <Fixed_string Pattern>
+		[[nodiscard]]
+		constexpr auto parse_pattern()
+		{
+			constexpr std::string_view pattern = Pattern.view();
+			Scan_pattern<pattern.size() + 1, count_placeholders(pattern)> result;
+			std::size_t size = 0;
+			std::size_t literal = 0;
+			for (std::size_t i = 0; i < pattern.size(); ++i)
+			{
+				const std::string_view pair = pattern.substr(i, 2);
+				if (pair == "{}")
+				{
+					result.ends[literal] = size;
+					result.begins[++literal] = size;
+					++i;
+					continue;
+				}
+				i += pair == "{{" || pair == "}}" ? 1 : 0;
+				result.text[size++] = pattern[i];
+			}
+			result.ends[literal] = size;
+			return result;
+		}
+
+		/*
+		 * Reads one value from the front of the text, next is the literal text that follows the placeholder
+		 */
+		template <typename T>
+		bool scan_value(std::string_view& text, T& value, const std::string_view next)
+		{
+			if constexpr (std::is_same_v<T, char>)
+			{
+				if (text.empty())
+				{
+					return false;
+				}
+				value = text.front();
+				text.remove_prefix(1);
+				return true;
+			}
+			else if constexpr (std::is_arithmetic_v<T>)
+			{
+				const std::size_t skipped = std::min(text.find_first_not_of(' '), text.size());
+				text.remove_prefix(skipped);
+				if (text.starts_with('+'))
+				{
+					text.remove_prefix(1);
+				}
+				const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+				if (error != std::errc())
+				{
+					return false;
+				}
+				text.remove_prefix(static_cast<std::size_t>(end - text.data()));
+				return true;
+			}
+			else
+			{
+				const std::size_t end = next.empty() ? text.size() : text.find(next);
+				if (end == std::string_view::npos)
+				{
+					return false;
+				}
+				value = T(text.substr(0, end));
+				text.remove_prefix(end);
+				return true;
+			}
+		}
+	}
+
+	/**
+	 * @brief Match a line against a pattern and read the values in it, like a scanf checked at compile time.
+	 *
+	 * Each {} in the pattern reads one value and everything else must match exactly, {{ and }} match a brace. The
+	 * pattern is taken apart at compile time, so reading a line is only comparing the literal text and converting the
+	 * values with std::from_chars, nothing is allocated unless a value is a std::string.
+	 *
+	 * How much of the line a value takes depends on its type:
+	 * - char takes one character.
+	 * - Numbers take as many characters as std::from_chars does, after skipping spaces and a plus sign.
+	 * - Anything made from a std::string_view, e.g. std::string_view or std::string, takes everything up to the
+	 *   literal text after its {}, or the rest of the line at the end of the pattern.
+	 *
+	 * @code
+	 * S64 x = 0, y = 0, vx = 0, vy = 0;
+	 * if (aoc::scan<"p={},{} v={},{}">(line, x, y, vx, vy))
+	 * @endcode
+	 *
+	 * @tparam Pattern The pattern.
+	 * @param text The text to match, all of it has to match.
+	 * @param values The values to read, one for each {} in order.
+	 * @returns Whether the text matched, the values read before a mismatch are changed anyway.
+	 */
+	template <Fixed_string Pattern, typename... Ts>
+	bool scan(std::string_view text, Ts&... values)
+	{
+		static constexpr auto pattern = detail::parse_pattern<Pattern>();
+		static_assert(pattern.begins.size() == sizeof...(Ts) + 1, "The pattern needs a {} for each value");
+
+		const auto match_literal = [&](const std::size_t i) {
+			const std::string_view literal = pattern.literal(i);
+			if (!text.starts_with(literal))
+			{
+				return false;
+			}
+			text.remove_prefix(literal.size());
+			return true;
+		};
+		if (!match_literal(0))
+		{
+			return false;
+		}
+		const bool matched = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+			return ((detail::scan_value(text, values, pattern.literal(Is + 1)) && match_literal(Is + 1)) && ...);
+		}(std::index_sequence_for<Ts...>());
+		return matched && text.empty();
+	}
+}
+
+#endif
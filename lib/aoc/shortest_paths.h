@@ -0,0 +1,330 @@
+/**
+ * @file
+ */
+
+#ifndef AOC_SHORTEST_PATHS_H
+#define AOC_SHORTEST_PATHS_H
+
+#include "aoc/core.h"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace aoc
+{
+	/**
+	 * @brief A priority queue of states keyed by their distance, on a binary heap.
+	 *
+	 * Works for any non-negative weights. The queues used by Shortest_paths all have push, pop, empty and clear, and
+	 * are allowed to hand back a state more than once, Shortest_paths skips the stale entries.
+	 */
+	class Binary_heap_queue
+	{
+	private:
+		std::vector<std::pair<S64, U32>> m_heap;
+
+	public:
+		void push(const S64 key, const U32 state)
+		{
+			m_heap.emplace_back(key, state);
+			std::ranges::push_heap(m_heap, std::greater<>());
+		}
+
+		/**
+		 * @returns The key and the state with the smallest key.
+		 */
+		std::pair<S64, U32> pop()
+		{
+			std::ranges::pop_heap(m_heap, std::greater<>());
+			const std::pair<S64, U32> top = m_heap.back();
+			m_heap.pop_back();
+			return top;
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_heap.empty();
+		}
+
+		void clear()
+		{
+			m_heap.clear();
+		}
+	};
+
+	/**
+	 * @brief Dial's bucket queue, a ring of one bucket per distance.
+	 *
+	 * For small integer weights: every key pushed must be between the key popped last and that plus the largest
+	 * weight. Pushing and popping are then constant time apart from stepping over the empty buckets.
+	 */
+	class Bucket_queue
+	{
+	private:
+		std::vector<std::vector<U32>> m_buckets;
+		S64 m_current = 0;
+		std::size_t m_size = 0;
+
+	public:
+		/**
+		 * @param max_weight The largest weight of an edge.
+		 */
+		explicit Bucket_queue(const S64 max_weight)
+			: m_buckets(static_cast<std::size_t>(max_weight + 1))
+		{
+		}
+
+		void push(const S64 key, const U32 state)
+		{
+			m_buckets[static_cast<std::size_t>(key) % m_buckets.size()].push_back(state);
+			++m_size;
+		}
+
+		std::pair<S64, U32> pop()
+		{
+			while (m_buckets[static_cast<std::size_t>(m_current) % m_buckets.size()].empty())
+			{
+				++m_current;
+			}
+			std::vector<U32>& bucket = m_buckets[static_cast<std::size_t>(m_current) % m_buckets.size()];
+			const U32 state = bucket.back();
+			bucket.pop_back();
+			--m_size;
+			return { m_current, state };
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		void clear()
+		{
+			for (std::vector<U32>& bucket : m_buckets)
+			{
+				bucket.clear();
+			}
+			m_current = 0;
+			m_size = 0;
+		}
+	};
+
+	/**
+	 * @brief A radix heap, for keys that never go below the key popped last.
+	 *
+	 * Keys are put in a bucket by the highest bit they differ from the last popped key in, and a bucket is only
+	 * sorted out again once everything below it is gone. That makes each key move buckets at most 64 times in total,
+	 * whatever the weights.
+	 */
+	class Radix_heap
+	{
+	private:
+		std::vector<std::pair<U64, U32>> m_buckets[65];
+		U64 m_last = 0;
+		std::size_t m_size = 0;
+
+		[[nodiscard]]
+		std::size_t bucket_of(const U64 key) const
+		{
+			return key == m_last ? 0 : static_cast<std::size_t>(64 - std::countl_zero(key ^ m_last));
+		}
+
+	public:
+		void push(const S64 key, const U32 state)
+		{
+			const auto unsigned_key = static_cast<U64>(key);
+			m_buckets[bucket_of(unsigned_key)].emplace_back(unsigned_key, state);
+			++m_size;
+		}
+
+		std::pair<S64, U32> pop()
+		{
+			if (m_buckets[0].empty())
+			{
+				std::size_t i = 1;
+				while (m_buckets[i].empty())
+				{
+					++i;
+				}
+				m_last = std::ranges::min_element(m_buckets[i])->first;
+				for (const std::pair<U64, U32>& entry : m_buckets[i])
+				{
+					m_buckets[bucket_of(entry.first)].push_back(entry);
+				}
+				m_buckets[i].clear();
+			}
+			const std::pair<U64, U32> entry = m_buckets[0].back();
+			m_buckets[0].pop_back();
+			--m_size;
+			return { static_cast<S64>(entry.first), entry.second };
+		}
+
+		[[nodiscard]]
+		bool empty() const
+		{
+			return m_size == 0;
+		}
+
+		void clear()
+		{
+			for (std::vector<std::pair<U64, U32>>& bucket : m_buckets)
+			{
+				bucket.clear();
+			}
+			m_last = 0;
+			m_size = 0;
+		}
+	};
+
+	/**
+	 * @brief Dijkstra's algorithm over states numbered from 0, with the distances in a flat array.
+	 *
+	 * The graph is given as a function called with a state and a callback, it calls the callback with each state
+	 * reachable in one step and the weight of the step. Nothing is allocated per state, and running the search again
+	 * reuses all of the buffers.
+	 *
+	 * After a search every state on a shortest path to a set of targets can be found with mark_shortest_paths, e.g. to
+	 * count the cells on any of the best paths. The states are kept in one bit each.
+	 *
+	 * @tparam Queue Binary_heap_queue, Bucket_queue or Radix_heap.
+	 */
+	template <typename Queue = Binary_heap_queue>
+	class Shortest_paths
+	{
+	public:
+		static constexpr S64 unreachable = std::numeric_limits<S64>::max();
+
+	private:
+		std::vector<S64> m_distances;
+		// The states in the order their distances were settled
+		std::vector<U32> m_settled;
+		std::vector<U64> m_on_path;
+		Queue m_queue;
+
+	public:
+		/**
+		 * @param state_count One more than the largest state.
+		 * @param queue The queue to use, e.g. a Bucket_queue made for the largest weight.
+		 */
+		explicit Shortest_paths(const std::size_t state_count, Queue queue = Queue())
+			: m_distances(state_count, unreachable)
+			, m_on_path((state_count + 63) / 64)
+			, m_queue(std::move(queue))
+		{
+			m_settled.reserve(state_count);
+		}
+
+		/**
+		 * @brief Find the distances from the sources to every state, or until the search is told to stop.
+		 *
+		 * @tparam N Procedure taking a state and a callback taking the next state and the weight of the step.
+		 * @tparam P UnaryPredicate taking a state, called as each state is settled.
+		 * @param sources The states at distance 0.
+		 * @param neighbours The graph.
+		 * @param stop Returns true to stop the search, e.g. once a target is settled.
+		 */
+		template <typename N, typename P>
+		void run(const std::span<const U32> sources, N neighbours, P stop)
+		{
+			std::ranges::fill(m_distances, unreachable);
+			m_settled.clear();
+			m_queue.clear();
+			for (const U32 source : sources)
+			{
+				m_distances[source] = 0;
+				m_queue.push(0, source);
+			}
+
+			while (!m_queue.empty())
+			{
+				const std::pair<S64, U32> entry = m_queue.pop();
+				const S64 distance = entry.first;
+				const U32 state = entry.second;
+				if (distance != m_distances[state])
+				{
+					continue;
+				}
+				m_settled.push_back(state);
+				if (stop(state))
+				{
+					break;
+				}
+				neighbours(state, [&](const U32 next, const S64 weight) {
+					const S64 alternative = distance + weight;
+					if (alternative < m_distances[next])
+					{
+						m_distances[next] = alternative;
+						m_queue.push(alternative, next);
+					}
+				});
+			}
+		}
+
+		template <typename N>
+		void run(const std::span<const U32> sources, N neighbours)
+		{
+			run(sources, neighbours, [](U32) { return false; });
+		}
+
+		/**
+		 * @returns The distance to a state, unreachable if the search didn't reach it.
+		 */
+		[[nodiscard]]
+		S64 distance(const U32 state) const
+		{
+			return m_distances[state];
+		}
+
+		/**
+		 * @brief Mark every state on any shortest path from the sources to one of the targets.
+		 *
+		 * Goes back over the settled states from the furthest, a state is on a path when one of its steps is as
+		 * short as the distances allow and leads to a state on a path. The weights must be positive.
+		 *
+		 * @tparam N The same graph as given to run.
+		 * @tparam P UnaryPredicate taking a settled state, true for the targets.
+		 * @param neighbours The graph.
+		 * @param is_target Whether a state is one of the targets.
+		 */
+		template <typename N, typename P>
+		void mark_shortest_paths(N neighbours, P is_target)
+		{
+			std::ranges::fill(m_on_path, 0);
+			for (auto iter = m_settled.rbegin(); iter != m_settled.rend(); ++iter)
+			{
+				const U32 state = *iter;
+				bool on_path = is_target(state);
+				if (!on_path)
+				{
+					neighbours(state, [&](const U32 next, const S64 weight) {
+						on_path |= m_distances[next] == m_distances[state] + weight && on_shortest_path(next);
+					});
+				}
+				if (on_path)
+				{
+					m_on_path[state / 64] |= U64{ 1 } << (state % 64);
+				}
+			}
+		}
+
+		/**
+		 * @returns Whether a state was marked by the last call to mark_shortest_paths.
+		 */
+		[[nodiscard]]
+		bool on_shortest_path(const U32 state) const
+		{
+			return (m_on_path[state / 64] >> (state % 64)) & 1;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,113 @@
+#include "bench_history.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <random>
+
+namespace
+{
+	driver::Bench_record make_record(const int day, std::vector<std::string> answers)
+	{
+		driver::Bench_record record;
+		record.year = 2018;
+		record.day = day;
+		record.module_hash = 0x0123456789abcdef;
+		record.input_hash = 0xfedcba9876543210;
+		record.timestamp = 1700000000;
+		record.iterations = 10;
+		record.timings.min = std::chrono::nanoseconds(100);
+		record.timings.median = std::chrono::nanoseconds(150);
+		record.timings.p90 = std::chrono::nanoseconds(190);
+		record.timings.p99 = std::chrono::nanoseconds(199);
+		record.timings.max = std::chrono::nanoseconds(200);
+		record.timings.mean = std::chrono::nanoseconds(155);
+		record.timings.standard_deviation = std::chrono::nanoseconds(20);
+		record.peak_memory = 4 << 20;
+		record.answers = std::move(answers);
+		return record;
+	}
+
+	void require_equal(const driver::Bench_record& lhs, const driver::Bench_record& rhs)
+	{
+		REQUIRE(lhs.year == rhs.year);
+		REQUIRE(lhs.day == rhs.day);
+		REQUIRE(lhs.module_hash == rhs.module_hash);
+		REQUIRE(lhs.input_hash == rhs.input_hash);
+		REQUIRE(lhs.timestamp == rhs.timestamp);
+		REQUIRE(lhs.iterations == rhs.iterations);
+		REQUIRE(lhs.timings.min == rhs.timings.min);
+		REQUIRE(lhs.timings.median == rhs.timings.median);
+		REQUIRE(lhs.timings.p90 == rhs.timings.p90);
+		REQUIRE(lhs.timings.p99 == rhs.timings.p99);
+		REQUIRE(lhs.timings.max == rhs.timings.max);
+		REQUIRE(lhs.timings.mean == rhs.timings.mean);
+		REQUIRE(lhs.timings.standard_deviation == rhs.timings.standard_deviation);
+		REQUIRE(lhs.peak_memory == rhs.peak_memory);
+		REQUIRE(lhs.answers == rhs.answers);
+	}
+}
+
+TEST_CASE("Split the answers from the output", "[bench_history]")
+{
+	REQUIRE(driver::split_answers("").empty());
+	REQUIRE(driver::split_answers("1234\n\n5678\r\n") == std::vector<std::string>{ "1234", "5678" });
+}
+
+TEST_CASE("Format and parse a benchmark record", "[bench_history]")
+{
+	SECTION("Plain answers")
+	{
+		const driver::Bench_record record = make_record(12, { "3241", "2749999999911" });
+		const std::string line = driver::format_bench_record(record);
+		REQUIRE(line == "2018 12 0123456789abcdef fedcba9876543210 1700000000 10 100 150 190 199 200 155 20 4194304 "
+			"3241 2749999999911");
+		const std::optional<driver::Bench_record> parsed = driver::parse_bench_record(line);
+		REQUIRE(parsed);
+		require_equal(*parsed, record);
+	}
+
+	SECTION("Answers with separators")
+	{
+		const driver::Bench_record record = make_record(18, { "a b", "c\\d\te", "#..#\n####" });
+		const std::string line = driver::format_bench_record(record);
+		REQUIRE(line.find('\n') == std::string::npos);
+		const std::optional<driver::Bench_record> parsed = driver::parse_bench_record(line);
+		REQUIRE(parsed);
+		require_equal(*parsed, record);
+	}
+
+	SECTION("Invalid records")
+	{
+		REQUIRE_FALSE(driver::parse_bench_record(""));
+		REQUIRE_FALSE(driver::parse_bench_record("2018 12 0123456789abcdef fedcba9876543210 1700000000 10 100"));
+		REQUIRE_FALSE(driver::parse_bench_record(
+			"2018 12 0123456789abcdef fedcba9876543210 1700000000 10 100 150 190 199 200 155 20 4194304 bad\\"));
+	}
+}
+
+TEST_CASE("Append records to the benchmark history", "[bench_history]")
+{
+	std::random_device random;
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / std::format("aoc_history_{:08x}.txt",
+		random());
+
+	std::string error;
+	std::optional<std::vector<driver::Bench_record>> records = driver::read_bench_history(path, error);
+	REQUIRE(records);
+	REQUIRE(records->empty());
+
+	const driver::Bench_record first = make_record(12, { "3241" });
+	const driver::Bench_record second = make_record(18, { "a b", "c" });
+	REQUIRE(driver::append_bench_record(path, first, error));
+	REQUIRE(driver::append_bench_record(path, second, error));
+
+	records = driver::read_bench_history(path, error);
+	std::filesystem::remove(path);
+	REQUIRE(records);
+	REQUIRE(records->size() == 2);
+	require_equal(records->front(), first);
+	require_equal(records->back(), second);
+}
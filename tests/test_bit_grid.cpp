@@ -0,0 +1,69 @@
+#include <aoc/bit_grid.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	aoc::Bit_grid parse_bits(const std::string_view text)
+	{
+		return aoc::Bit_grid::from_grid(aoc::parse_grid(text), [](const char ch) { return ch == '#'; });
+	}
+}
+
+TEST_CASE("Set and count the cells of a bit grid", "[bit_grid]")
+{
+	aoc::Bit_grid grid(130, 3);
+	REQUIRE(grid.words_per_row() == 3);
+	REQUIRE(grid.last_word_mask() == 3);
+	REQUIRE_FALSE(grid.any());
+	grid.set(0, 0);
+	grid.set(64, 1);
+	grid.set(129, 2);
+	REQUIRE(grid.get(64, 1));
+	REQUIRE_FALSE(grid.get(65, 1));
+	REQUIRE(grid.count() == 3);
+	grid.reset(64, 1);
+	REQUIRE(grid.count() == 2);
+}
+
+TEST_CASE("Count the neighbours across words", "[bit_grid]")
+{
+	aoc::Bit_grid grid(128, 3);
+	for (const S64 x : { 62, 63, 64, 65 })
+	{
+		for (const S64 y : { 0, 1, 2 })
+		{
+			grid.set(x, y);
+		}
+	}
+	const aoc::Neighbour_count low = aoc::count_neighbours(grid, 1, 0);
+	REQUIRE(((low.exactly(8) >> 63) & 1) == 1);
+	REQUIRE(((low.exactly(5) >> 62) & 1) == 1);
+	REQUIRE(((low.exactly(3) >> 61) & 1) == 1);
+	REQUIRE(((low.at_least(4) >> 60) & 1) == 0);
+	const aoc::Neighbour_count high = aoc::count_neighbours(grid, 0, 1);
+	REQUIRE((high.exactly(5) & 1) == 1);
+	REQUIRE(((high.exactly(3) >> 1) & 1) == 1);
+}
+
+TEST_CASE("Spread to the orthogonal neighbours", "[bit_grid]")
+{
+	const aoc::Bit_grid grid = parse_bits("...\n.#.\n...\n");
+	REQUIRE(aoc::spread_4(grid) == parse_bits(".#.\n#.#\n.#."));
+	REQUIRE(aoc::spread_4(parse_bits("..#\n...")) == parse_bits(".#.\n..#"));
+}
+
+TEST_CASE("Step the game of life", "[bit_grid]")
+{
+	// Born with 3 neighbours, survives with 2 or 3
+	const U16 birth = 1u << 3;
+	const U16 survival = (1u << 2) | (1u << 3);
+	const aoc::Bit_grid blinker = parse_bits(".....\n..#..\n..#..\n..#..\n.....");
+	const aoc::Bit_grid turned = aoc::step_life_like(blinker, birth, survival);
+	REQUIRE(turned == parse_bits(".....\n.....\n.###.\n.....\n....."));
+	REQUIRE(aoc::step_life_like(turned, birth, survival) == blinker);
+
+	aoc::Bit_grid cells = parse_bits("##.\n##.\n..#");
+	cells.and_not(parse_bits("#..\n...\n..#"));
+	REQUIRE(cells == parse_bits(".#.\n##.\n..."));
+}
@@ -0,0 +1,274 @@
+#include "download.h"
+#include "input_store.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+	struct Response
+	{
+		int status;
+		std::string body;
+		// Answer with a 503 this many times before giving the real response
+		int failures = 0;
+	};
+
+	/**
+	 * @brief A minimal HTTP server on the loopback interface standing in for the Advent of Code website.
+	 */
+	class Test_server
+	{
+	private:
+		int m_socket = -1;
+		int m_port = 0;
+		std::atomic<bool> m_stop = false;
+		std::mutex m_mutex;
+		std::map<std::string, Response> m_responses;
+		std::map<std::string, int> m_request_counts;
+		std::thread m_thread;
+
+		void serve()
+		{
+			while (!m_stop)
+			{
+				pollfd poll_fd{ m_socket, POLLIN, 0 };
+				if (poll(&poll_fd, 1, 50) <= 0) continue;
+
+				const int connection = accept(m_socket, nullptr, nullptr);
+				if (connection == -1) continue;
+
+				std::string request;
+				char buffer[1024];
+				while (request.find("\r\n\r\n") == std::string::npos)
+				{
+					const ssize_t count = read(connection, buffer, sizeof(buffer));
+					if (count <= 0) break;
+					request.append(buffer, static_cast<std::size_t>(count));
+				}
+
+				std::istringstream stream(request);
+				std::string method;
+				std::string path;
+				stream >> method >> path;
+
+				Response response{ 404, "Not found" };
+				{
+					const std::lock_guard lock(m_mutex);
+					++m_request_counts[path];
+					if (const auto iter = m_responses.find(path); iter != m_responses.end())
+					{
+						if (iter->second.failures > 0)
+						{
+							--iter->second.failures;
+							response = { 503, "Try again later" };
+						}
+						else
+						{
+							response = iter->second;
+						}
+					}
+				}
+				if (request.find("Cookie: session=test") == std::string::npos)
+				{
+					response = { 400, "Missing session" };
+				}
+
+				const std::string reply = std::format("HTTP/1.1 {} Test\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+					response.status, response.body.size(), response.body);
+				[[maybe_unused]] const ssize_t written = write(connection, reply.data(), reply.size());
+				close(connection);
+			}
+		}
+
+	public:
+		Test_server()
+		{
+			m_socket = socket(AF_INET, SOCK_STREAM, 0);
+			sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t length = sizeof(address);
+			REQUIRE(bind(m_socket, reinterpret_cast<sockaddr*>(&address), length) == 0);
+			REQUIRE(listen(m_socket, 16) == 0);
+			REQUIRE(getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &length) == 0);
+			m_port = ntohs(address.sin_port);
+			m_thread = std::thread([this] { serve(); });
+		}
+
+		Test_server(const Test_server&) = delete;
+		Test_server& operator=(const Test_server&) = delete;
+
+		~Test_server()
+		{
+			m_stop = true;
+			m_thread.join();
+			close(m_socket);
+		}
+
+		void respond(const int year, const int day, Response response)
+		{
+			const std::lock_guard lock(m_mutex);
+			m_responses[std::format("/{}/day/{}/input", year, day)] = std::move(response);
+		}
+
+		int request_count(const int year, const int day)
+		{
+			const std::lock_guard lock(m_mutex);
+			return m_request_counts[std::format("/{}/day/{}/input", year, day)];
+		}
+
+		std::string url() const
+		{
+			return std::format("http://127.0.0.1:{}", m_port);
+		}
+	};
+
+	struct Temporary_directory
+	{
+		std::filesystem::path path;
+
+		Temporary_directory()
+			: path(std::filesystem::temp_directory_path() / std::format("aoc_test_{}", getpid()))
+		{
+			std::filesystem::create_directories(path);
+		}
+
+		~Temporary_directory()
+		{
+			std::filesystem::remove_all(path);
+		}
+	};
+
+	std::string read_file(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios_base::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	driver::Download_options make_options(const Test_server& server)
+	{
+		driver::Download_options options;
+		options.base_url = server.url();
+		options.cookie = "session=test";
+		options.max_connections = 3;
+		options.initial_backoff = std::chrono::milliseconds(10);
+		return options;
+	}
+}
+
+TEST_CASE("Download several inputs at once", "[download]")
+{
+	Test_server server;
+	const Temporary_directory directory;
+	std::vector<driver::Download_request> requests;
+	for (int day = 1; day <= 8; ++day)
+	{
+		server.respond(2023, day, { 200, std::format("input for day {}\n", day) });
+		requests.push_back({ 2023, day, directory.path / std::format("day{}.txt", day) });
+	}
+
+	const std::vector<driver::Download_result> results = driver::download_inputs(requests, make_options(server));
+	REQUIRE(results.size() == requests.size());
+	for (std::size_t i = 0; i < requests.size(); ++i)
+	{
+		const std::string expected = std::format("input for day {}\n", requests[i].day);
+		REQUIRE(results[i].success);
+		REQUIRE(results[i].hash == driver::hash_contents(expected));
+		REQUIRE(read_file(requests[i].path) == expected);
+	}
+
+	// Only the inputs should be left, none of the temporary files
+	const auto file_count =
+		std::distance(std::filesystem::directory_iterator(directory.path), std::filesystem::directory_iterator());
+	REQUIRE(file_count == static_cast<std::ptrdiff_t>(requests.size()));
+}
+
+TEST_CASE("Retry downloads that fail temporarily", "[download]")
+{
+	Test_server server;
+	const Temporary_directory directory;
+	server.respond(2020, 1, { 200, "1721\n979\n", 2 });
+	const driver::Download_request request{ 2020, 1, directory.path / "input.txt" };
+
+	const driver::Download_result result = driver::download_inputs({ &request, 1 }, make_options(server)).front();
+	REQUIRE(result.success);
+	REQUIRE(result.error.empty());
+	REQUIRE(server.request_count(2020, 1) == 3);
+	REQUIRE(read_file(request.path) == "1721\n979\n");
+}
+
+TEST_CASE("Don't retry downloads that can't succeed", "[download]")
+{
+	Test_server server;
+	const Temporary_directory directory;
+	const driver::Download_request missing{ 2020, 2, directory.path / "missing.txt" };
+
+	driver::Download_options options = make_options(server);
+	driver::Download_result result = driver::download_inputs({ &missing, 1 }, options).front();
+	REQUIRE_FALSE(result.success);
+	REQUIRE(server.request_count(2020, 2) == 1);
+	REQUIRE_FALSE(std::filesystem::exists(missing.path));
+
+	server.respond(2020, 3, { 200, "input" });
+	const driver::Download_request unauthorised{ 2020, 3, directory.path / "unauthorised.txt" };
+	options.cookie = "session=expired";
+	result = driver::download_inputs({ &unauthorised, 1 }, options).front();
+	REQUIRE_FALSE(result.success);
+	REQUIRE_FALSE(std::filesystem::exists(unauthorised.path));
+}
+
+TEST_CASE("Give up after the maximum number of attempts", "[download]")
+{
+	Test_server server;
+	const Temporary_directory directory;
+	server.respond(2021, 1, { 200, "input", 10 });
+	const driver::Download_request request{ 2021, 1, directory.path / "input.txt" };
+
+	const driver::Download_result result = driver::download_inputs({ &request, 1 }, make_options(server)).front();
+	REQUIRE_FALSE(result.success);
+	REQUIRE(server.request_count(2021, 1) == 4);
+	REQUIRE_FALSE(std::filesystem::exists(request.path));
+}
+
+TEST_CASE("Notice inputs that changed after they were downloaded", "[download]")
+{
+	const Temporary_directory directory;
+	const std::filesystem::path path = directory.path / "input.txt";
+	std::string error;
+	REQUIRE(driver::write_file_atomically(path, "abc\n", error));
+
+	driver::Input_index index = driver::Input_index::load(directory.path);
+	REQUIRE(index.check(2022, 1, path) == driver::Input_check::unknown);
+	index.record(2022, 1, path, driver::hash_contents("abc\n"));
+	REQUIRE(index.save(error));
+
+	const driver::Input_index loaded = driver::Input_index::load(directory.path);
+	REQUIRE(loaded.check(2022, 1, path) == driver::Input_check::unchanged);
+	REQUIRE(loaded.check(2022, 2, path) == driver::Input_check::unknown);
+
+	REQUIRE(driver::write_file_atomically(path, "abcd\n", error));
+	REQUIRE(loaded.check(2022, 1, path) == driver::Input_check::modified);
+}
+
+TEST_CASE("Hash the contents of an input", "[download]")
+{
+	REQUIRE(driver::hash_contents("") == 0xcbf29ce484222325);
+	REQUIRE(driver::hash_contents("a") == 0xaf63dc4c8601ec8c);
+	REQUIRE(driver::hash_contents("abc\n") != driver::hash_contents("abd\n"));
+}
@@ -0,0 +1,92 @@
+#include <aoc/grid.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+	std::string row_string(const aoc::Grid<char>& grid, const S64 y)
+	{
+		const std::span<const char> row = grid.row(y);
+		return { row.begin(), row.end() };
+	}
+}
+
+TEST_CASE("Parse a grid of characters", "[grid]")
+{
+	const aoc::Grid<char> grid = aoc::parse_grid("abc\r\ndef\n\nrest");
+	REQUIRE(grid.width() == 3);
+	REQUIRE(grid.height() == 2);
+	REQUIRE_FALSE(grid.has_border());
+	REQUIRE(row_string(grid, 0) == "abc");
+	REQUIRE(row_string(grid, 1) == "def");
+	REQUIRE(grid(2, 1) == 'f');
+	REQUIRE(grid[aoc::Vector2{ 1, 0 }] == 'b');
+	REQUIRE(aoc::parse_grid("").height() == 0);
+}
+
+TEST_CASE("Read a grid and leave the rest of the stream", "[grid]")
+{
+	std::istringstream stream("ab\ncd\n\nmoves\n");
+	const aoc::Grid<char> grid = aoc::read_grid(stream);
+	REQUIRE(grid == aoc::parse_grid("ab\ncd"));
+	std::string rest;
+	std::getline(stream, rest);
+	REQUIRE(rest == "moves");
+}
+
+TEST_CASE("Step onto the sentinel border", "[grid]")
+{
+	const aoc::Grid<char> grid = aoc::parse_grid("ab\ncd\n", '#');
+	REQUIRE(grid.has_border());
+	REQUIRE(grid.stride() == 4);
+	REQUIRE(grid.size() == 16);
+	REQUIRE(grid(-1, -1) == '#');
+	REQUIRE(grid(2, 1) == '#');
+	REQUIRE(grid(0, 2) == '#');
+
+	const S64 corner = grid.index(1, 1);
+	REQUIRE(grid[corner] == 'd');
+	const std::array<S64, 4> offsets = grid.neighbour_offsets_4();
+	REQUIRE(grid[corner + offsets[0]] == '#');
+	REQUIRE(grid[corner + offsets[1]] == '#');
+	REQUIRE(grid[corner + offsets[2]] == 'c');
+	REQUIRE(grid[corner + offsets[3]] == 'b');
+	REQUIRE(grid[corner + grid.neighbour_offsets_8()[5]] == 'a');
+	REQUIRE(grid.position(corner) == aoc::Vector2{ 1, 1 });
+	REQUIRE(grid.position(0) == aoc::Vector2{ -1, -1 });
+	REQUIRE(grid.find('c') == grid.index(0, 1));
+	REQUIRE_FALSE(grid.find('#'));
+}
+
+TEST_CASE("The neighbour offsets follow the directions", "[grid]")
+{
+	const aoc::Grid<int> grid(5, 4);
+	const aoc::Vector2 p{ 2, 2 };
+	const aoc::Vector2 directions[] = { aoc::Vector2::east, aoc::Vector2::south_east, aoc::Vector2::south,
+		aoc::Vector2::south_west, aoc::Vector2::west, aoc::Vector2::north_west, aoc::Vector2::north,
+		aoc::Vector2::north_east };
+	const std::array<S64, 8> offsets = grid.neighbour_offsets_8();
+	for (std::size_t i = 0; i < offsets.size(); ++i)
+	{
+		REQUIRE(grid.index(p) + offsets[i] == grid.index(p + directions[i]));
+	}
+}
+
+TEST_CASE("Transpose and rotate a grid", "[grid]")
+{
+	aoc::Grid<char> grid = aoc::parse_grid("abc\ndef\n", '.');
+	REQUIRE(grid.transposed().to_grid() == aoc::parse_grid("ad\nbe\ncf"));
+	REQUIRE(grid.rotated_clockwise().to_grid() == aoc::parse_grid("da\neb\nfc"));
+	REQUIRE(grid.rotated_counter_clockwise().to_grid() == aoc::parse_grid("cf\nbe\nad"));
+	REQUIRE(grid.rotated_counter_clockwise().transposed().to_grid() == aoc::parse_grid("cba\nfed"));
+	REQUIRE(grid.view().to_grid() == aoc::parse_grid("abc\ndef"));
+
+	const aoc::Grid_view<char> rotated = grid.rotated_clockwise();
+	REQUIRE(rotated.width() == 2);
+	REQUIRE(rotated.height() == 3);
+	rotated(0, 0) = 'x';
+	REQUIRE(grid(0, 1) == 'x');
+}
@@ -0,0 +1,106 @@
+#include <aoc/grid_search.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+
+namespace
+{
+	const aoc::Grid<char> maze = aoc::parse_grid(
+		"..#....\n"
+		".##.##.\n"
+		"...#...\n"
+		".#...#.\n",
+		'#');
+
+	const auto can_move = [](const S64, const S64 to) { return maze[to] != '#'; };
+}
+
+TEST_CASE("Wrap around the ring queue", "[grid_search]")
+{
+	aoc::Ring_queue<int> queue(3);
+	for (int i = 0; i < 3; ++i)
+	{
+		queue.push(i);
+	}
+	REQUIRE(queue.pop() == 0);
+	REQUIRE(queue.pop() == 1);
+	for (int i = 3; i < 6; ++i)
+	{
+		queue.push(i);
+	}
+	REQUIRE(queue.size() == 4);
+	for (int i = 2; i < 6; ++i)
+	{
+		REQUIRE(queue.pop() == i);
+	}
+	REQUIRE(queue.empty());
+}
+
+TEST_CASE("Clear the epoch marks", "[grid_search]")
+{
+	aoc::Epoch_marks marks(4);
+	REQUIRE(marks.insert(2));
+	REQUIRE_FALSE(marks.insert(2));
+	REQUIRE(marks.contains(2));
+	marks.clear();
+	REQUIRE_FALSE(marks.contains(2));
+	REQUIRE(marks.insert(2));
+}
+
+TEST_CASE("Search a maze from one or more cells", "[grid_search]")
+{
+	aoc::Grid_search search(maze.size(), maze.neighbour_offsets_4());
+	const S64 start = maze.index(0, 0);
+	const S64 end = maze.index(6, 0);
+	const std::array<S64, 1> sources = { start };
+	for (int run = 0; run < 2; ++run)
+	{
+		search.run(sources, can_move);
+		REQUIRE(search.distance(end) == 12);
+		REQUIRE(search.distance(maze.index(0, 3)) == 3);
+		REQUIRE(search.distance(maze.index(2, 0)) == aoc::Grid_search::unreachable);
+	}
+
+	REQUIRE(search.run(sources, can_move, [&](const S64 index) { return index == maze.index(0, 3); }) == 3);
+	REQUIRE_FALSE(search.reached(end));
+
+	const std::array<S64, 2> both_ends = { start, end };
+	search.run(both_ends, can_move);
+	REQUIRE(search.distance(maze.index(4, 3)) == 5);
+	REQUIRE(search.distance(maze.index(3, 0)) == 3);
+}
+
+TEST_CASE("Search a maze from both ends", "[grid_search]")
+{
+	aoc::Grid_search search(maze.size(), maze.neighbour_offsets_4());
+	REQUIRE(search.bidirectional(maze.index(0, 0), maze.index(6, 0), can_move) == 12);
+	REQUIRE(search.bidirectional(maze.index(6, 3), maze.index(0, 3), can_move) == 10);
+	REQUIRE(search.bidirectional(maze.index(1, 0), maze.index(1, 0), can_move) == 0);
+	REQUIRE(search.bidirectional(maze.index(0, 0), maze.index(2, 0), can_move) == aoc::Grid_search::unreachable);
+
+	// Only stepping east or south
+	const auto downhill = [&](const S64 from, const S64 to) { return to > from && maze[to] != '#'; };
+	REQUIRE(search.bidirectional(maze.index(0, 0), maze.index(2, 3), downhill) == 5);
+	REQUIRE(search.bidirectional(maze.index(2, 3), maze.index(0, 0), downhill) == aoc::Grid_search::unreachable);
+}
+
+TEST_CASE("Search a whole level at a time", "[grid_search]")
+{
+	const auto bits = [](const char ch) { return [ch](const char cell) { return cell == ch; }; };
+	const aoc::Grid<char> grid = aoc::parse_grid(
+		"S.#.....\n"
+		".##.##..\n"
+		"......#.\n"
+		".#...#.E\n");
+	const aoc::Bit_grid open = aoc::Bit_grid::from_grid(grid, [](const char ch) { return ch != '#'; });
+	const aoc::Bit_grid sources = aoc::Bit_grid::from_grid(grid, bits('S'));
+	const aoc::Bit_grid targets = aoc::Bit_grid::from_grid(grid, bits('E'));
+
+	aoc::Bit_grid_search search(grid.width(), grid.height());
+	REQUIRE(search.distance(open, sources, targets) == 14);
+	REQUIRE(search.reached().get(3, 3));
+	REQUIRE(search.distance(open, sources, sources) == 0);
+	REQUIRE(search.distance(open, sources, aoc::Bit_grid::from_grid(grid, bits('#'))) ==
+		aoc::Bit_grid_search::unreachable);
+}
@@ -0,0 +1,27 @@
+#include <aoc/input.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+TEST_CASE("Index the lines of some text", "[input]")
+{
+	REQUIRE(aoc::index_lines("").empty());
+	REQUIRE(aoc::index_lines("abc") == std::vector<std::size_t>{ 0 });
+	REQUIRE(aoc::index_lines("abc\n") == std::vector<std::size_t>{ 0 });
+	REQUIRE(aoc::index_lines("abc\nde\n") == std::vector<std::size_t>{ 0, 4 });
+	REQUIRE(aoc::index_lines("abc\n\nde") == std::vector<std::size_t>{ 0, 4, 5 });
+}
+
+TEST_CASE("Read lines from the input", "[input]")
+{
+	const std::string_view text = "abc\r\n\nde";
+	const std::vector<std::size_t> offsets = aoc::index_lines(text);
+	const aoc::Input input(text, offsets);
+	REQUIRE(input.text() == text);
+	REQUIRE(input.line_count() == 3);
+	REQUIRE(input.line(0) == "abc");
+	REQUIRE(input.line(1).empty());
+	REQUIRE(input.line(2) == "de");
+	REQUIRE(input.lines() == std::vector<std::string_view>{ "abc", "", "de" });
+}
@@ -0,0 +1,41 @@
+#include "profiler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("Profile summary", "[profiler]")
+{
+	driver::Profile_summary summary;
+	// The names are looked up by address, so a function called from two places gets two copies of its name
+	const std::string main = "main";
+	const std::string outer_count = "count";
+	const std::string inner_count = "count";
+	const std::string step = "step";
+
+	SECTION("A recursive function counts once towards its total")
+	{
+		const std::vector<const std::string*> names = { &main, &outer_count, &inner_count, &step };
+		driver::add_sample(summary, names);
+		driver::add_sample(summary, names);
+
+		REQUIRE(summary.stacks.size() == 1);
+		REQUIRE(summary.stacks.at("main;count;count;step") == 2);
+		REQUIRE(summary.functions.at("main").total == 2);
+		REQUIRE(summary.functions.at("count").total == 2);
+		REQUIRE(summary.functions.at("count").self == 0);
+		REQUIRE(summary.functions.at("step").self == 2);
+		REQUIRE(summary.functions.at("step").total == 2);
+	}
+
+	SECTION("A sample in the recursive function itself")
+	{
+		const std::vector<const std::string*> names = { &main, &outer_count, &inner_count };
+		driver::add_sample(summary, names);
+
+		REQUIRE(summary.functions.at("count").total == 1);
+		REQUIRE(summary.functions.at("count").self == 1);
+		REQUIRE(summary.functions.at("main").self == 0);
+	}
+}
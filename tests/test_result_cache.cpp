@@ -0,0 +1,76 @@
+#include "input_store.h"
+#include "result_cache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace
+{
+	std::uint64_t hash(const std::string_view data)
+	{
+		driver::Stream_hash hash;
+		hash.update(data);
+		return hash.finish();
+	}
+
+	driver::Cache_key make_key(const int day)
+	{
+		return { 2023, day, 0x0123456789abcdef, 0xfedcba9876543210, 0x1111111111111111 };
+	}
+}
+
+TEST_CASE("Stream hash matches XXH64", "[result_cache]")
+{
+	REQUIRE(hash("") == 0xef46db3751d8e999);
+	REQUIRE(hash("a") == 0xd24ec4f1a98c6e5b);
+	REQUIRE(hash("abc") == 0x44bc2cf5ad770999);
+	REQUIRE(hash("Nobody inspects the spammish repetition") == 0xfbcea83c8a378bf1);
+}
+
+TEST_CASE("Stream hash doesn't depend on how the data is split", "[result_cache]")
+{
+	std::string data(1000, '\0');
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<char>(i * 7);
+	}
+
+	for (const std::size_t piece : { 1, 3, 13, 32, 33, 500 })
+	{
+		driver::Stream_hash pieces;
+		for (std::size_t i = 0; i < data.size(); i += piece)
+		{
+			pieces.update(std::string_view(data).substr(i, piece));
+		}
+		REQUIRE(pieces.finish() == hash(data));
+	}
+}
+
+TEST_CASE("Cached answers survive saving and the least recently used are dropped", "[result_cache]")
+{
+	std::random_device random;
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / std::format("aoc_cache_{:08x}.txt",
+		random());
+
+	driver::Result_cache cache = driver::Result_cache::load(path, 2);
+	REQUIRE(cache.size() == 0);
+	cache.store(make_key(1), { "12 34", "5" });
+	cache.store(make_key(2), { "6" });
+	cache.store(make_key(3), { "7" });
+	cache.touch(make_key(1));
+
+	std::string error;
+	REQUIRE(cache.save(error));
+	cache = driver::Result_cache::load(path, 2);
+	std::filesystem::remove(path);
+
+	REQUIRE(cache.size() == 2);
+	REQUIRE(cache.find(make_key(2)) == nullptr);
+	REQUIRE(cache.find(make_key(3)));
+	REQUIRE(*cache.find(make_key(1)) == std::vector<std::string>{ "12 34", "5" });
+}
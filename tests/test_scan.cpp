@@ -0,0 +1,75 @@
+#include <aoc/scan.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <string_view>
+
+TEST_CASE("Scan numbers", "[scan]")
+{
+	long long x = 0;
+	long long y = 0;
+	int vx = 0;
+	int vy = 0;
+	REQUIRE(aoc::scan<"p={},{} v={},{}">("p=0,4 v=3,-3", x, y, vx, vy));
+	REQUIRE(x == 0);
+	REQUIRE(y == 4);
+	REQUIRE(vx == 3);
+	REQUIRE(vy == -3);
+
+	REQUIRE(aoc::scan<"position=<{},{}>">("position=< 9,  -1>", x, y));
+	REQUIRE(x == 9);
+	REQUIRE(y == -1);
+	REQUIRE(aoc::scan<"X{}, Y{}">("X+94, Y=34", x, y) == false);
+	REQUIRE(aoc::scan<"X{}, Y={}">("X+94, Y=34", x, y));
+	REQUIRE(x == 94);
+
+	unsigned u = 0;
+	double d = 0;
+	REQUIRE(aoc::scan<"{}x{}">("12x2.5", u, d));
+	REQUIRE(u == 12);
+	REQUIRE(d == 2.5);
+}
+
+TEST_CASE("The whole text has to match", "[scan]")
+{
+	int a = 0;
+	int b = 0;
+	REQUIRE_FALSE(aoc::scan<"{}x{}">("2x3x4", a, b));
+	REQUIRE_FALSE(aoc::scan<"{}x{}">("2x", a, b));
+	REQUIRE_FALSE(aoc::scan<"{}x{}">("2y3", a, b));
+	REQUIRE_FALSE(aoc::scan<"#{}">("", a));
+	REQUIRE_FALSE(aoc::scan<"{}">("-", a));
+	REQUIRE(aoc::scan<"no values">("no values"));
+	REQUIRE_FALSE(aoc::scan<"no values">("no values!"));
+}
+
+TEST_CASE("Scan characters and strings", "[scan]")
+{
+	std::string_view name;
+	std::string rules;
+	REQUIRE(aoc::scan<"{}{{{}}}">("px{a<2006:qkq,m>2090:A,rfg}", name, rules));
+	REQUIRE(name == "px");
+	REQUIRE(rules == "a<2006:qkq,m>2090:A,rfg");
+
+	char key = 0;
+	char op = 0;
+	long long value = 0;
+	std::string_view target;
+	REQUIRE(aoc::scan<"{}{}{}:{}">("m>2090:A", key, op, value, target));
+	REQUIRE(key == 'm');
+	REQUIRE(op == '>');
+	REQUIRE(value == 2090);
+	REQUIRE(target == "A");
+
+	std::string_view lhs;
+	std::string_view gate;
+	std::string_view rhs;
+	std::string_view output;
+	REQUIRE(aoc::scan<"{} {} {} -> {}">("x00 AND y00 -> z00", lhs, gate, rhs, output));
+	REQUIRE(lhs == "x00");
+	REQUIRE(gate == "AND");
+	REQUIRE(rhs == "y00");
+	REQUIRE(output == "z00");
+	REQUIRE_FALSE(aoc::scan<"{} {} {} -> {}">("x00 AND y00", lhs, gate, rhs, output));
+}
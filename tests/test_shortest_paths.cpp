@@ -0,0 +1,98 @@
+#include <aoc/shortest_paths.h>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	struct Edge
+	{
+		U32 to;
+		S64 weight;
+	};
+
+	/*
+	 * 0 -> 1 -> 3 and 0 -> 2 -> 3 are both 4 long, 0 -> 3 is 5 long, 4 leads to 3 but can't be reached
+	 */
+	const std::vector<std::vector<Edge>> graph = {
+		{ { 1, 1 }, { 2, 3 }, { 3, 5 } },
+		{ { 3, 3 } },
+		{ { 3, 1 } },
+		{},
+		{ { 3, 1 } },
+	};
+
+	void neighbours(const U32 state, const auto& visit)
+	{
+		for (const Edge& edge : graph[state])
+		{
+			visit(edge.to, edge.weight);
+		}
+	}
+
+	template <typename Queue>
+	Queue make_queue()
+	{
+		if constexpr (std::is_same_v<Queue, aoc::Bucket_queue>)
+		{
+			return aoc::Bucket_queue(5);
+		}
+		else
+		{
+			return Queue();
+		}
+	}
+}
+
+TEMPLATE_TEST_CASE("Every queue finds the same distances", "[shortest_paths]", aoc::Binary_heap_queue,
+	aoc::Bucket_queue, aoc::Radix_heap)
+{
+	aoc::Shortest_paths<TestType> paths(graph.size(), make_queue<TestType>());
+	const std::array<U32, 1> sources = { 0 };
+	// Run twice to check the buffers are reset
+	for (int run = 0; run < 2; ++run)
+	{
+		paths.run(sources, [](const U32 state, const auto& visit) { neighbours(state, visit); });
+		REQUIRE(paths.distance(0) == 0);
+		REQUIRE(paths.distance(1) == 1);
+		REQUIRE(paths.distance(2) == 3);
+		REQUIRE(paths.distance(3) == 4);
+		REQUIRE(paths.distance(4) == aoc::Shortest_paths<TestType>::unreachable);
+	}
+}
+
+TEST_CASE("Stop the search once the target is settled", "[shortest_paths]")
+{
+	aoc::Shortest_paths<aoc::Radix_heap> paths(graph.size());
+	const std::array<U32, 1> sources = { 0 };
+	paths.run(
+		sources, [](const U32 state, const auto& visit) { neighbours(state, visit); },
+		[](const U32 state) { return state == 1; });
+	REQUIRE(paths.distance(1) == 1);
+	REQUIRE(paths.distance(3) == 5);
+}
+
+TEST_CASE("Mark the states on any shortest path", "[shortest_paths]")
+{
+	aoc::Shortest_paths<> paths(graph.size());
+	const auto graph_neighbours = [](const U32 state, const auto& visit) { neighbours(state, visit); };
+	const std::array<U32, 1> sources = { 0 };
+	paths.run(sources, graph_neighbours);
+	paths.mark_shortest_paths(graph_neighbours, [](const U32 state) { return state == 3; });
+	for (const U32 state : { 0u, 1u, 2u, 3u })
+	{
+		REQUIRE(paths.on_shortest_path(state));
+	}
+	REQUIRE_FALSE(paths.on_shortest_path(4));
+
+	paths.mark_shortest_paths(graph_neighbours, [](const U32 state) { return state == 2; });
+	REQUIRE(paths.on_shortest_path(0));
+	REQUIRE_FALSE(paths.on_shortest_path(1));
+	REQUIRE(paths.on_shortest_path(2));
+	REQUIRE_FALSE(paths.on_shortest_path(3));
+}
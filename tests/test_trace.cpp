@@ -0,0 +1,65 @@
+#include "trace.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+	std::size_t count(const std::string& text, const std::string& pattern)
+	{
+		std::size_t result = 0;
+		for (std::size_t i = text.find(pattern); i != std::string::npos; i = text.find(pattern, i + 1))
+		{
+			++result;
+		}
+		return result;
+	}
+
+	std::set<std::string> thread_ids(const std::string& text)
+	{
+		const std::string key = "\"tid\":";
+		std::set<std::string> result;
+		for (std::size_t i = text.find(key); i != std::string::npos; i = text.find(key, i + 1))
+		{
+			const std::size_t begin = i + key.size();
+			result.insert(text.substr(begin, text.find_first_not_of("0123456789", begin) - begin));
+		}
+		return result;
+	}
+}
+
+TEST_CASE("Short lived threads reuse the buffers of threads that have exited", "[trace]")
+{
+	// Without reuse every thread would keep a 32MB buffer, a few thousand of them is more than the memory limit
+	constexpr int thread_count = 2000;
+
+	driver::start_tracing();
+	for (int i = 0; i < thread_count; ++i)
+	{
+		std::thread thread([] { driver::Trace_scope scope("part_two"); });
+		thread.join();
+	}
+	driver::stop_tracing();
+
+	std::random_device random;
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / std::format("aoc_trace_{:08x}.json",
+		random());
+	std::string error;
+	REQUIRE(driver::write_chrome_trace(path, error));
+	std::stringstream contents;
+	contents << std::ifstream(path).rdbuf();
+	std::filesystem::remove(path);
+
+	const std::string trace = contents.str();
+	REQUIRE(count(trace, "\"ph\":\"B\"") == thread_count);
+	REQUIRE(count(trace, "\"ph\":\"E\"") == thread_count);
+	REQUIRE(thread_ids(trace).size() == 1);
+}